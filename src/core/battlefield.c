@@ -4,6 +4,8 @@
 
 #include "battlefield.h"
 #include "types.h"  // Full Entity definition needed for entity registry operations
+#include "../entities/entity_pool.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -202,6 +204,19 @@ static void generate_canonical_waypoints(Battlefield *bf, BattleSide side) {
     }
 }
 
+// id -> registry index bookkeeping (entityIndexBySlot)
+static int bf_entity_index_slot(const Battlefield *bf, int entityID) {
+    if (entityID < 0) return -1;
+    int slot = entity_id_slot(entityID);
+    return (slot < bf->entityCapacity) ? slot : -1;
+}
+
+static void bf_reset_entity_index(Battlefield *bf) {
+    for (int i = 0; i < bf->entityCapacity; i++) {
+        bf->entityIndexBySlot[i] = -1;
+    }
+}
+
 // --- Public API ---
 
 BattleSide bf_side_for_player(int playerID) {
@@ -210,7 +225,8 @@ BattleSide bf_side_for_player(int playerID) {
 
 void bf_init(Battlefield *bf, const BiomeDef biomeDefs[],
              BiomeType bottomBiome, BiomeType topBiome,
-             float tileSize, unsigned int seedBottom, unsigned int seedTop) {
+             float tileSize, unsigned int seedBottom, unsigned int seedTop,
+             int entityCapacity) {
     memset(bf, 0, sizeof(Battlefield));
 
     bf->boardWidth = BOARD_WIDTH;
@@ -230,9 +246,27 @@ void bf_init(Battlefield *bf, const BiomeDef biomeDefs[],
     // Generate canonical lane waypoints for both sides
     generate_canonical_waypoints(bf, SIDE_BOTTOM);
     generate_canonical_waypoints(bf, SIDE_TOP);
+    for (int side = 0; side < 2; side++) {
+        for (int lane = 0; lane < 3; lane++) {
+            lane_progress_build(&bf->laneProgress[side][lane], bf->laneWaypoints[side][lane]);
+        }
+    }
 
     // Initialize entity registry
+    if (entityCapacity < 1) entityCapacity = 1;
+    bf->entities = calloc((size_t)entityCapacity, sizeof(Entity *));
+    bf->removedEntities = calloc((size_t)entityCapacity, sizeof(Entity *));
+    bf->entityIndexBySlot = malloc((size_t)entityCapacity * sizeof(int));
+    if (!bf->entities || !bf->removedEntities || !bf->entityIndexBySlot) {
+        fprintf(stderr, "[Battlefield] Out of memory for %d entities\n", entityCapacity);
+        entityCapacity = 0;
+    }
+    bf->entityCapacity = entityCapacity;
     bf->entityCount = 0;
+    bf_reset_entity_index(bf);
+
+    spatial_grid_init(&bf->spatial, bf->boardWidth, bf->boardHeight,
+                      SPATIAL_GRID_CELL_SIZE_PX, entityCapacity);
 }
 
 void bf_cleanup(Battlefield *bf) {
@@ -241,57 +275,126 @@ void bf_cleanup(Battlefield *bf) {
 
     // Do NOT destroy entities here -- they are owned by the caller's lifecycle,
     // matching the current Player pattern.
+    free(bf->entities);
+    free(bf->removedEntities);
+    free(bf->entityIndexBySlot);
+    spatial_grid_destroy(&bf->spatial);
+    bf->entities = NULL;
+    bf->removedEntities = NULL;
+    bf->entityIndexBySlot = NULL;
+    bf->entityCapacity = 0;
     bf->entityCount = 0;
 }
 
+static int bf_find_entity_index(const Battlefield *bf, int entityID) {
+    int slot = bf_entity_index_slot(bf, entityID);
+    if (slot < 0) return -1;
+    int index = bf->entityIndexBySlot[slot];
+    if (index < 0 || index >= bf->entityCount) return -1;
+    return (bf->entities[index]->id == entityID) ? index : -1;
+}
+
+// Point entityIndexBySlot at the current registry index of every entry in
+// [from, entityCount). Called after a shift moves a run of entries.
+static void bf_reindex_entities_from(Battlefield *bf, int from) {
+    for (int i = from; i < bf->entityCount; i++) {
+        int slot = bf_entity_index_slot(bf, bf->entities[i]->id);
+        if (slot >= 0) bf->entityIndexBySlot[slot] = i;
+    }
+}
+
 void bf_add_entity(Battlefield *bf, Entity *e) {
-    if (bf->entityCount >= MAX_ENTITIES * 2) {
-        fprintf(stderr, "[Battlefield] Entity limit reached (%d)\n", MAX_ENTITIES * 2);
+    if (bf->entityCount >= bf->entityCapacity) {
+        fprintf(stderr, "[Battlefield] Entity limit reached (%d)\n", bf->entityCapacity);
         return;
     }
-    bf->entities[bf->entityCount++] = e;
+    int slot = bf_entity_index_slot(bf, e->id);
+    if (slot < 0) {
+        fprintf(stderr, "[Battlefield] Entity id %d has no pool slot\n", e->id);
+        return;
+    }
+
+    // Ids are issued in ascending spawn order, so a new entity belongs at the
+    // end. The backwards scan only runs if an older entity is re-registered.
+    int index = bf->entityCount;
+    while (index > 0 && bf->entities[index - 1]->id > e->id) index--;
+    if (index < bf->entityCount) {
+        memmove(&bf->entities[index + 1], &bf->entities[index],
+                (size_t)(bf->entityCount - index) * sizeof(bf->entities[0]));
+    }
+    bf->entities[index] = e;
+    bf->entityCount++;
+    spatial_grid_insert(&bf->spatial, e);
+    if (spatial_grid_is_anchored(e)) bf->staticEntityVersion++;
+    if (index == bf->entityCount - 1) {
+        bf->entityIndexBySlot[slot] = index;
+    } else {
+        bf_reindex_entities_from(bf, index);
+    }
+}
+
+void bf_remove_entity_at(Battlefield *bf, int index) {
+    if (index < 0 || index >= bf->entityCount) return;
+
+    int removedSlot = bf_entity_index_slot(bf, bf->entities[index]->id);
+    spatial_grid_remove(&bf->spatial, bf->entities[index]);
+    if (spatial_grid_is_anchored(bf->entities[index])) bf->staticEntityVersion++;
+    // Shift the tail down one so the registry stays id-sorted.
+    memmove(&bf->entities[index], &bf->entities[index + 1],
+            (size_t)(bf->entityCount - index - 1) * sizeof(bf->entities[0]));
+    bf->entityCount--;
+    if (removedSlot >= 0) bf->entityIndexBySlot[removedSlot] = -1;
+    bf_reindex_entities_from(bf, index);
+    // Do NOT call entity_destroy (caller's responsibility)
 }
 
 void bf_remove_entity(Battlefield *bf, int entityID) {
-    for (int i = 0; i < bf->entityCount; i++) {
-        if (bf->entities[i]->id == entityID) {
-            // Swap with last element
-            bf->entities[i] = bf->entities[bf->entityCount - 1];
-            bf->entityCount--;
-            // Do NOT call entity_destroy (caller's responsibility)
-            return;
-        }
-    }
+    bf_remove_entity_at(bf, bf_find_entity_index(bf, entityID));
 }
 
-Entity *bf_find_entity(Battlefield *bf, int entityID) {
-    for (int i = 0; i < bf->entityCount; i++) {
-        if (bf->entities[i]->id == entityID) {
-            return bf->entities[i];
+int bf_remove_marked_entities(Battlefield *bf) {
+    if (!bf) return 0;
+
+    // Single stable compaction pass: survivors slide down over removed
+    // entries, so k removals cost O(n) rather than O(n * k).
+    int removedCount = 0;
+    int write = 0;
+    for (int read = 0; read < bf->entityCount; read++) {
+        Entity *e = bf->entities[read];
+        int slot = bf_entity_index_slot(bf, e->id);
+        if (e->markedForRemoval) {
+            if (slot >= 0) bf->entityIndexBySlot[slot] = -1;
+            spatial_grid_remove(&bf->spatial, e);
+            if (spatial_grid_is_anchored(e)) bf->staticEntityVersion++;
+            bf->removedEntities[removedCount] = e;
+            removedCount++;
+            continue;
         }
-    }
-    return NULL;
-}
-
-int bf_build_update_order(const Battlefield *bf, int *outIndices) {
-    if (!bf || !outIndices) return 0;
-    int count = bf->entityCount;
-    for (int i = 0; i < count; i++) outIndices[i] = i;
-
-    // Insertion sort by entity.id ascending. n <= MAX_ENTITIES * 2 = 128 so
-    // O(n^2) worst case is trivially cheap, and stable ordering beats
-    // quicksort for nearly-sorted per-frame state.
-    for (int i = 1; i < count; i++) {
-        int key = outIndices[i];
-        int keyId = bf->entities[key]->id;
-        int j = i - 1;
-        while (j >= 0 && bf->entities[outIndices[j]]->id > keyId) {
-            outIndices[j + 1] = outIndices[j];
-            j--;
+        if (write != read) {
+            bf->entities[write] = e;
+            if (slot >= 0) bf->entityIndexBySlot[slot] = write;
         }
-        outIndices[j + 1] = key;
+        write++;
     }
-    return count;
+    bf->entityCount = write;
+    return removedCount;
+}
+
+Entity *bf_find_entity(Battlefield *bf, int entityID) {
+    int index = bf_find_entity_index(bf, entityID);
+    return (index >= 0) ? bf->entities[index] : NULL;
+}
+
+void bf_mark_static_entities_changed(Battlefield *bf) {
+    if (bf) bf->staticEntityVersion++;
+}
+
+void bf_spatial_rebuild(Battlefield *bf) {
+    spatial_grid_rebuild(&bf->spatial, bf->entities, bf->entityCount);
+}
+
+void bf_spatial_update(Battlefield *bf, const Entity *e) {
+    spatial_grid_update(&bf->spatial, e);
 }
 
 Territory *bf_territory_at(Battlefield *bf, CanonicalPos pos) {
@@ -321,6 +424,11 @@ CanonicalPos bf_waypoint(const Battlefield *bf, BattleSide side, int lane, int w
     return bf->laneWaypoints[side][lane][waypointIdx];
 }
 
+const LaneProgressTable *bf_lane_progress(const Battlefield *bf, BattleSide side, int lane) {
+    if (!bf || lane < 0 || lane >= 3) return NULL;
+    return &bf->laneProgress[side][lane];
+}
+
 CanonicalPos bf_base_anchor(const Battlefield *bf, BattleSide side) {
     Rectangle play = bf_play_bounds(bf, side);
     CanonicalPos base = {
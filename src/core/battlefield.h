@@ -21,6 +21,8 @@
 #endif
 #include "battlefield_math.h"
 #include "sustenance.h"
+#include "spatial_grid.h"
+#include "lane_progress.h"
 
 // Forward declarations
 typedef struct Entity Entity;
@@ -50,15 +52,45 @@ typedef struct Battlefield {
     // All positions are in canonical world space (per D-05)
     CanonicalPos laneWaypoints[2][3][LANE_WAYPOINT_COUNT];
 
+    // Arc lengths and projection grid of each lane polyline, built by
+    // bf_init from laneWaypoints (see lane_progress.h).
+    LaneProgressTable laneProgress[2][3];
+
     // Canonical slot spawn anchors: slotSpawnAnchors[side][slot]
     CanonicalPos slotSpawnAnchors[2][NUM_CARD_SLOTS];
 
     // Sustenance resource nodes (battlefield-owned, not Entity instances)
     SustenanceField sustenanceField;
 
-    // Authoritative entity registry (per D-11)
-    Entity *entities[MAX_ENTITIES * 2];  // room for both sides
+    // Authoritative entity registry (per D-11). Kept in ascending id order
+    // at all times: new ids append, removals compact in place. Iterating
+    // entities[] front to back is the deterministic "lower-id wins the jam"
+    // update order for local steering.
+    // Sized to entityCapacity (runtime, see ENTITY_CAPACITY_DEFAULT) by
+    // bf_init and released by bf_cleanup.
+    Entity **entities;
     int entityCount;
+    int entityCapacity;
+
+    // id -> registry index, keyed by the pool slot encoded in the id
+    // (entity_pool.h). -1 = slot not registered. Lookups confirm the full id
+    // against entities[index], so stale ids from a reused slot miss.
+    int *entityIndexBySlot;
+
+    // Scratch written by bf_remove_marked_entities(): the entities removed
+    // by the most recent sweep, in ascending id order.
+    Entity **removedEntities;
+
+    // Uniform-grid index over the registry for range / nearest queries.
+    // Membership follows the registry; positions are re-binned by
+    // game_sim_step (see spatial_grid.h).
+    SpatialGrid spatial;
+
+    // Bumped whenever an anchored entity (spatial_grid_is_anchored) joins or
+    // leaves the registry, or is reported moved through
+    // bf_mark_static_entities_changed. The nav static layer is restamped
+    // only when this changes.
+    uint32_t staticEntityVersion;
 } Battlefield;
 
 // --- Lifecycle ---
@@ -67,25 +99,36 @@ typedef struct Battlefield {
 // bottomBiome/topBiome: biome assignment for each territory (per D-14).
 // tileSize: rendered tile size (DEFAULT_TILE_SIZE * DEFAULT_TILE_SCALE).
 // seeds: per-territory random seeds for tilemap generation.
+// entityCapacity: live entity cap for the registry (entity_pool_capacity()).
 void bf_init(Battlefield *bf, const BiomeDef biomeDefs[],
              BiomeType bottomBiome, BiomeType topBiome,
-             float tileSize, unsigned int seedBottom, unsigned int seedTop);
+             float tileSize, unsigned int seedBottom, unsigned int seedTop,
+             int entityCapacity);
 
-// Free battlefield resources (tilemaps)
+// Free battlefield resources (tilemaps, registry storage)
 void bf_cleanup(Battlefield *bf);
 
 // --- Entity registry ---
 void bf_add_entity(Battlefield *bf, Entity *e);
 void bf_remove_entity(Battlefield *bf, int entityID);
+// Remove the entry at registry index `index`, shifting later entries down
+// one to keep id order. Does not destroy.
+void bf_remove_entity_at(Battlefield *bf, int index);
+// Remove every markedForRemoval entity in one stable compaction pass.
+// Removed pointers are written to bf->removedEntities in ascending id order
+// for the caller to destroy. Returns the number removed.
+int bf_remove_marked_entities(Battlefield *bf);
+// O(1) through entityIndexBySlot. NULL when the id is not registered.
 Entity *bf_find_entity(Battlefield *bf, int entityID);
+// Call after moving an anchored entity or changing its nav footprint, so
+// the nav static layer is restamped next tick.
+void bf_mark_static_entities_changed(Battlefield *bf);
 
-// Build a stable per-tick iteration order for the entity registry.
-// Writes `bf->entityCount` indices into `outIndices`, sorted ascending by
-// entity.id. This gives deterministic "lower-id wins the jam" semantics for
-// local steering regardless of the registry's swap-with-last removal order.
-// Caller must provide `outIndices` with capacity >= MAX_ENTITIES * 2.
-// Returns the number of indices written.
-int bf_build_update_order(const Battlefield *bf, int *outIndices);
+// --- Spatial index ---
+// Re-bin every registered entity from its current position.
+void bf_spatial_rebuild(Battlefield *bf);
+// Re-bin one entity after it moved.
+void bf_spatial_update(Battlefield *bf, const Entity *e);
 
 // --- World queries ---
 // Get territory for a given canonical position
@@ -100,6 +143,9 @@ CanonicalPos bf_spawn_pos(const Battlefield *bf, BattleSide side, int slotIndex)
 // Get canonical waypoint for a given side, lane, and waypoint index
 CanonicalPos bf_waypoint(const Battlefield *bf, BattleSide side, int lane, int waypointIdx);
 
+// Get the progress tables of a side's lane, or NULL for an invalid lane
+const LaneProgressTable *bf_lane_progress(const Battlefield *bf, BattleSide side, int lane);
+
 // Get canonical home-base anchor for a given side.
 // This remains the authored base position even if the center-lane troop spawn
 // is retuned independently.
@@ -9,6 +9,16 @@
 #define SCREEN_WIDTH  1920
 #define SCREEN_HEIGHT 1080
 
+// Simulation clock. game_update feeds frame time into an accumulator and
+// advances the sim in fixed 1/SIM_TICK_RATE_HZ steps, at most
+// SIM_MAX_CATCHUP_STEPS per rendered frame; any backlog beyond that is
+// dropped so a render hitch slows the match instead of spiking it.
+// The SIM_TICK_RATE env var overrides the rate at startup.
+#define SIM_TICK_RATE_HZ        60.0f
+#define SIM_TICK_RATE_MIN_HZ    10.0f
+#define SIM_TICK_RATE_MAX_HZ    240.0f
+#define SIM_MAX_CATCHUP_STEPS   4
+
 // Paths
 #define CARD_SHEET_PATH     "src/assets/cards/ModularCardsRPG/modularCardsRPGSheet.png"
 #define GRASS_TILESET_PATH  "src/assets/environment/Pixel Art Top Down - Basic v1.2.3/Texture/TX Tileset Grass.png"
@@ -121,6 +131,7 @@
 #define PATHFIND_CANDIDATE_ANGLE_SIDE_DEG 90.0f
 #define PATHFIND_CANDIDATE_ANGLE_ESCAPE_DEG 120.0f
 #define PATHFIND_CONTACT_GAP              2.0f
+#define PATHFIND_CLEARANCE_SCORE_CAP      32.0f  // candidate score ignores clearance beyond this
 #define PATHFIND_WAYPOINT_REACH_GAP       4.0f
 #define PATHFIND_JAM_RELIEF_TICKS         6
 #define PATHFIND_BLOCKER_RESCUE_TICKS     24
@@ -152,10 +163,35 @@
 // 0.35 after the first playtest showed residual clustering near the ring.
 #define PATHFIND_FREE_MOVER_LATERAL_TOLERANCE_RATIO 1.5f
 
+// ORCA crowd avoidance (third_party/rvo2/orca.h). Bit (1u << UnitNavProfile) moves a
+// profile's units from the candidate fan onto reciprocal velocity obstacles;
+// 0 keeps the fan. This is the NavFrame default; game_sim_set_orca_profiles
+// overrides it per GameState.
+#define PATHFIND_ORCA_PROFILES            0u
+#define PATHFIND_ORCA_TIME_HORIZON_S      0.5f
+#define PATHFIND_ORCA_NEIGHBOR_GAP        48.0f  // surface gap past which neighbors are ignored
+#define PATHFIND_ORCA_MAX_NEIGHBORS       10     // nearest mobile neighbors per solve
+#define PATHFIND_ORCA_MAX_BLOCKED_CELLS   6      // nearest hard-blocked nav cells per solve
+
 // Entity / slot limits (shared by types.h and battlefield.h)
 #define NUM_CARD_SLOTS 3
 #define MAX_ENTITIES   64
 
+// Live entity capacity across both sides. Normal matches run at
+// ENTITY_CAPACITY_DEFAULT; exhibition "horde" modes raise it at runtime
+// (ENTITY_CAPACITY env var, cardgame_sim --entity-cap / --stress) up to
+// ENTITY_CAPACITY_MAX. The entity pool, Battlefield registry, nav snapshot
+// and field caches, and projectile slots are all sized from the runtime value.
+// Ids pack a spawn serial above ENTITY_ID_SLOT_BITS bits of pool slot index.
+#define ENTITY_CAPACITY_DEFAULT (MAX_ENTITIES * 2)
+#define ENTITY_ID_SLOT_BITS     12
+#define ENTITY_CAPACITY_MAX     (1 << ENTITY_ID_SLOT_BITS)
+
+// Battlefield spatial index (spatial_grid.h). 64 px cells keep a melee
+// scan to a 3x3 block while the 1080x1920 board stays at 17x30 cells.
+#define SPATIAL_GRID_CELL_SIZE_PX 64.0f
+#define SPATIAL_GRID_NEAREST_MAX  16
+
 // Canonical board dimensions (per D-01)
 #define BOARD_WIDTH   1080
 #define BOARD_HEIGHT  1920
@@ -3,16 +3,13 @@
 //
 
 #include "game.h"
+#include "game_sim.h"
 #include "config.h"
 #include "battlefield.h"
 #include "sustenance.h"
 #include "debug_events.h"
 #include "../data/card_catalog.h"
 #include "../logic/card_effects.h"
-#include "../logic/base_geometry.h"
-#include "../logic/farmer.h"
-#include "../logic/nav_frame.h"
-#include "../logic/win_condition.h"
 #include "../rendering/viewport.h"
 #include "../rendering/debug_overlay.h"
 #include "../rendering/sustenance_renderer.h"
@@ -25,7 +22,6 @@
 #include "../systems/player.h"
 #include "../systems/progression.h"
 #include "../entities/entities.h"
-#include "../entities/building.h"
 #include "../entities/projectile.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -35,32 +31,6 @@
 static bool s_showLaneDebug = false;
 static DebugOverlayFlags s_debugFlags = {0};
 
-static void player_capture_base_hud_snapshot(Player *player, const Entity *base) {
-    if (!player || !base) return;
-
-    player->hasBaseHudSnapshot = true;
-    player->baseHudHP = base->hp;
-    player->baseHudMaxHP = base->maxHP;
-    player->baseHudLevel = base->baseLevel;
-}
-
-static void game_seed_demo_hands(GameState *g) {
-    for (int playerIndex = 0; playerIndex < 2; playerIndex++) {
-        int handIndex = 0;
-        for (int presentationIndex = 0; presentationIndex < HAND_MAX_CARDS; presentationIndex++) {
-            const char *cardId = card_catalog_card_id_for_presentation_index(presentationIndex);
-            Card *card = cards_find(&g->deck, cardId);
-            if (!card) {
-                printf("[HandUI] Demo hand missing card '%s'\n", cardId);
-                continue;
-            }
-
-            player_hand_set_card(&g->players[playerIndex], handIndex, card);
-            handIndex++;
-        }
-    }
-}
-
 static MusicPhase game_resolve_music_phase(const GameState *g) {
     if (!g) return MUSIC_PHASE_1;
     if (g->gameOver) return MUSIC_PHASE_4;
@@ -81,49 +51,40 @@ bool game_init(GameState *g) {
     uint32_t sustenanceSeed = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
     if (sustenanceSeed == 0) sustenanceSeed = 1;
 
-    const char *db_path = getenv("DB_PATH");
-    if (!db_path) db_path = "cardgame.db";
-    if (!db_init(&g->db, db_path)) {
-        printf("db_init failed -- ensure %s exists (run: make init-db)\n", db_path);
+    if (!game_sim_load_data(g)) {
         return false;
     }
 
-    if (!cards_load(&g->deck, &g->db)) {
-        db_close(&g->db);
-        return false;
-    }
+    const char *entityCap = getenv("ENTITY_CAPACITY");
+    game_sim_set_entity_capacity(g, entityCap ? atoi(entityCap) : ENTITY_CAPACITY_DEFAULT);
+
+    const char *navBudget = getenv("NAV_BUDGET_US");
+    if (navBudget) game_sim_set_nav_budget_us(g, atoi(navBudget));
 
-    // Load NFC UID -> card_id mappings (non-fatal if table is empty or missing)
-    cards_load_nfc_map(&g->deck, &g->db);
+    const char *navBounded = getenv("NAV_QUERY_BOUNDED");
+    if (navBounded) game_sim_set_nav_query_bounded(g, atoi(navBounded) != 0);
 
-    SetConfigFlags(FLAG_WINDOW_UNDECORATED);
+    const char *orcaProfiles = getenv("ORCA_PROFILES");
+    if (orcaProfiles) game_sim_set_orca_profiles(g, (uint32_t)strtoul(orcaProfiles, NULL, 0));
+
+    const char *tickRate = getenv("SIM_TICK_RATE");
+    game_sim_set_tick_rate(g, tickRate ? strtof(tickRate, NULL) : SIM_TICK_RATE_HZ);
+    printf("[SIM] Fixed tick rate %.0f Hz (max %d catch-up steps/frame), entity cap %d\n",
+           1.0f / g->simTickSeconds, g->simMaxCatchUpSteps, g->entityCapacity);
+
+    // Rendering runs at the display rate; the sim clock is fixed-step
+    // (see game_update), so no SetTargetFPS cap is needed to pace gameplay.
+    SetConfigFlags(FLAG_WINDOW_UNDECORATED | FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "NFC Card Game");
     SetWindowPosition(0, 0);
-    SetTargetFPS(60);
     HideCursor();
     audio_init(&g->audio);
 
-    // Initialize card system
-    card_action_init();
     card_atlas_init(&g->cardAtlas);
 
     // Initialize biome definitions (loads textures, builds tile defs)
     biome_init_all(g->biomeDefs);
 
-    // Initialize canonical Battlefield (authoritative world model per D-11)
-    float tileSize = DEFAULT_TILE_SIZE * DEFAULT_TILE_SCALE;
-    bf_init(&g->battlefield, g->biomeDefs,
-            BIOME_GRASS, BIOME_GRASS,  // bottom/top biome (matches current setup)
-            tileSize, 42, 99);         // seeds match current hardcoded values
-
-    // Initialize per-frame flow-field navigation cache. nav_begin_frame()
-    // is called each tick before the entity update loop (wired in Phase 2).
-    nav_frame_init(&g->nav);
-    g->lastFrameDeltaTime = 1.0f / 60.0f;
-
-    // Initialize sustenance resource nodes (dedicated RNG, after bf_init generates waypoints)
-    sustenance_init(&g->battlefield, sustenanceSeed);
-
     // Load sustenance texture
     g->sustenanceTexture = sustenance_renderer_load();
     g->statusBarsTexture = status_bars_load();
@@ -139,34 +100,9 @@ bool game_init(GameState *g) {
     sprite_atlas_init(&g->spriteAtlas);
     spawn_fx_init(&g->spawnFx);
     projectile_assets_init(&g->projectileAssets);
-    projectile_system_init(&g->projectileSystem);
-
-    // Initialize split-screen viewports and players
-    viewport_init_split_screen(g);
-    game_seed_demo_hands(g);
-    for (int i = 0; i < 2; i++) {
-        g->players[i].hasBaseHudSnapshot = false;
-        g->players[i].baseHudHP = 0;
-        g->players[i].baseHudMaxHP = 0;
-        g->players[i].baseHudLevel = 0;
-    }
-
-    // Spawn home bases at the authored center-lane home anchors.
-    for (int i = 0; i < 2; i++) {
-        BattleSide side = bf_side_for_player(i);
-        CanonicalPos anchor = bf_base_anchor(&g->battlefield, side);
-        Entity *base = building_create_base(&g->players[i], anchor.v, &g->spriteAtlas);
-        if (base) {
-            g->players[i].base = base;
-            player_capture_base_hud_snapshot(&g->players[i], base);
-            bf_add_entity(&g->battlefield, base);
-        }
-        progression_sync_player(g, i);
-    }
 
-    // Match result state
-    g->gameOver = false;
-    g->winnerID = -1;
+    // Battlefield, nav, sustenance, players, and home bases (shared with cardgame_sim)
+    game_sim_init_world(g, sustenanceSeed);
 
     // P2 viewport render target: sized to the shortened battlefield sub-rect
     // (not the full half-screen) so compositing lands cleanly on the inner
@@ -275,132 +211,55 @@ static void game_handle_spawn_input(GameState *g) {
 }
 
 void game_update(GameState *g) {
-    float deltaTime = fminf(GetFrameTime(), 1.0f / 20.0f);
-    g->lastFrameDeltaTime = deltaTime;
-    spawn_fx_update(&g->spawnFx, deltaTime);
+    // The sim clock takes the raw frame time (it caps catch-up itself);
+    // presentation timers keep the 1/20 s clamp so a hitch cannot jump FX
+    // or the music crossfade by seconds.
+    float frameTime = GetFrameTime();
+    float presentDt = fminf(frameTime, 1.0f / 20.0f);
+    spawn_fx_update(&g->spawnFx, presentDt);
 
     // Debug toggles always active (even after gameOver)
     game_handle_debug_input();
 
-    // Freeze gameplay once match result is latched
-    // (debug event timers still decay so hit flashes fade naturally)
-    if (g->gameOver) {
-        audio_tick(&g->audio, game_resolve_music_phase(g), deltaTime);
-        debug_events_tick(deltaTime);
-        return;
-    }
-
-    game_handle_nfc_events(g);
-    game_handle_spawn_input(g);
-
-    // Update both players (energy regen, slot cooldowns)
-    player_update(&g->players[0], deltaTime);
-    player_update(&g->players[1], deltaTime);
-
-    Battlefield *bf = &g->battlefield;
-
-    // Per-frame nav snapshot. nav_begin_frame resets the static obstacle
-    // mask to the board-edge moat; the entity pass below stamps static
-    // building footprints and mobile troop density on top. Every movement
-    // decision this tick reads the same frozen snapshot.
-    nav_begin_frame(&g->nav, bf);
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *e = bf->entities[i];
-        if (!e || !e->alive) continue;
-        int side = (e->ownerID == 0) ? 0 : 1;
-        Vector2 navAnchor = e->position;
-        Vector2 navBlockerCenter = e->position;
-        if (e->navProfile == NAV_PROFILE_STATIC &&
-            e->type == ENTITY_BUILDING) {
-            navAnchor = base_interaction_anchor(e);
-            navBlockerCenter = base_nav_blocker_center(e);
-        }
-        // Freeze every live entity's position in the nav snapshot before
-        // any movement runs, so target fields built mid-tick always see
-        // the same pivot regardless of update order.
-        nav_snapshot_entity_position(&g->nav, e->id, navAnchor.x, navAnchor.y);
-        if (e->navProfile == NAV_PROFILE_STATIC) {
-            if (e->type == ENTITY_BUILDING) {
-                for (int cellIdx = 0; cellIdx < BASE_NAV_HARD_CORE_CELL_COUNT; ++cellIdx) {
-                    Vector2 cellPoint = { 0 };
-                    if (!base_nav_hard_core_cell_point(e, cellIdx, &cellPoint)) continue;
-                    nav_stamp_static_entity_cell(&g->nav, e->id,
-                                                cellPoint.x, cellPoint.y);
-                }
-            } else {
-                float radius = (e->navRadius > 0.0f) ? e->navRadius : e->bodyRadius;
-                if (radius <= 0.0f) radius = BASE_NAV_RADIUS;
-                nav_stamp_static_entity(&g->nav, e->id,
-                                        navBlockerCenter.x, navBlockerCenter.y, radius);
-            }
-        } else {
-            nav_stamp_density(&g->nav, side, e->position.x, e->position.y);
-        }
+    // Card input is ignored once the match result is latched; game_sim_step
+    // freezes gameplay itself and only decays debug event timers.
+    if (!g->gameOver) {
+        game_handle_nfc_events(g);
+        game_handle_spawn_input(g);
     }
 
-    // Update all entities from Battlefield registry in a stable id-sorted
-    // order so local steering jams deterministically (lower-id wins the
-    // jam) regardless of the registry's swap-with-last removal order.
-    int updateOrder[MAX_ENTITIES * 2];
-    int updateCount = bf_build_update_order(bf, updateOrder);
-    for (int i = 0; i < updateCount; i++) {
-        int idx = updateOrder[i];
-        if (idx < 0 || idx >= bf->entityCount) continue;
-        entity_update(bf->entities[idx], g, deltaTime);
-        if (g->gameOver) break;  // Win latched mid-loop -- stop processing
+    // Fixed-step clock: consume the frame's wall time in whole ticks. A slow
+    // frame runs at most simMaxCatchUpSteps ticks and drops the rest of the
+    // backlog, so render hitches never turn into oversized sim steps.
+    g->simAccumulator += frameTime;
+    int steps = 0;
+    while (g->simAccumulator >= g->simTickSeconds && steps < g->simMaxCatchUpSteps) {
+        game_sim_step(g, g->simTickSeconds);
+        g->simAccumulator -= g->simTickSeconds;
+        steps++;
     }
-
-    if (!g->gameOver) {
-        projectile_system_update(g, deltaTime);
+    if (g->simAccumulator >= g->simTickSeconds) {
+        g->simAccumulator = fmodf(g->simAccumulator, g->simTickSeconds);
     }
 
-    // Defensive fallback: catch base deaths from non-combat paths
-    win_check(g);
-
-    // Blood FX should follow damaged entities for the rest of the frame, then
-    // freeze once the entity is gone after the sweep below.
-    spawn_fx_sync_blood_attachments(&g->spawnFx, bf);
-
-    // Sweep dead/removed entities (runs once on the trigger frame, then frozen)
-    for (int i = bf->entityCount - 1; i >= 0; i--) {
-        if (bf->entities[i]->markedForRemoval) {
-            Entity *dead = bf->entities[i];
-
-            // Farmer death fallback: release claims / award sustenance.
-            // farmer_on_death is idempotent — safe if already called from combat.
-            if (dead->unitRole == UNIT_ROLE_FARMER) {
-                farmer_on_death(dead, g);
-            }
-
-            // Clear stale base pointers before freeing memory
-            if (dead == g->players[0].base) {
-                player_capture_base_hud_snapshot(&g->players[0], dead);
-                g->players[0].base = NULL;
-            }
-            if (dead == g->players[1].base) {
-                player_capture_base_hud_snapshot(&g->players[1], dead);
-                g->players[1].base = NULL;
-            }
-
-            bf->entities[i] = bf->entities[bf->entityCount - 1];
-            bf->entityCount--;
-            entity_destroy(dead);
-        }
-    }
+    // Leftover fraction of a tick drives render interpolation. A latched
+    // match no longer steps, so draw the final pose instead of lerping.
+    g->renderAlpha = g->gameOver ? 1.0f : g->simAccumulator / g->simTickSeconds;
+    if (g->renderAlpha > 1.0f) g->renderAlpha = 1.0f;
 
-    debug_events_tick(deltaTime);
-    audio_tick(&g->audio, game_resolve_music_phase(g), deltaTime);
+    audio_tick(&g->audio, game_resolve_music_phase(g), presentDt);
 }
 
 // Draw all Battlefield entities visible in the current viewport.
 // Entities are in canonical world space; the active Camera2D handles
 // projection. No ownership branching, no remap. (per D-19)
-static void game_draw_canonical_entities(const Battlefield *bf, EntityRenderLayer layer) {
+static void game_draw_canonical_entities(const Battlefield *bf, EntityRenderLayer layer,
+                                         float alpha) {
     for (int i = 0; i < bf->entityCount; i++) {
         const Entity *e = bf->entities[i];
         if (!e || e->markedForRemoval || !e->sprite) continue;
         if (e->renderLayer != layer) continue;
-        entity_draw(e);
+        entity_draw(e, alpha);
     }
 }
 
@@ -430,10 +289,10 @@ void game_render(GameState *g) {
     sustenance_renderer_draw(&bf->sustenanceField, SIDE_BOTTOM, g->sustenanceTexture, 0.0f);
     sustenance_renderer_draw(&bf->sustenanceField, SIDE_TOP, g->sustenanceTexture, 0.0f);
     spawn_fx_draw(&g->spawnFx, 180.0f);
-    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_GROUND);
-    spawn_fx_draw_overlay(&g->spawnFx, 180.0f);
-    projectile_system_draw(g);
-    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_FLYING);
+    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_GROUND, g->renderAlpha);
+    spawn_fx_draw_overlay(&g->spawnFx, 180.0f, g->renderAlpha);
+    projectile_system_draw(g, g->renderAlpha);
+    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_FLYING, g->renderAlpha);
     debug_overlay_draw(bf, g, s_debugFlags, &p1NavState);
     viewport_end();
     if (s_showLaneDebug) {
@@ -473,10 +332,10 @@ void game_render(GameState *g) {
     sustenance_renderer_draw(&bf->sustenanceField, SIDE_BOTTOM, g->sustenanceTexture, 180.0f);
     sustenance_renderer_draw(&bf->sustenanceField, SIDE_TOP, g->sustenanceTexture, 180.0f);
     spawn_fx_draw(&g->spawnFx, 0.0f);
-    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_GROUND);
-    spawn_fx_draw_overlay(&g->spawnFx, 0.0f);
-    projectile_system_draw(g);
-    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_FLYING);
+    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_GROUND, g->renderAlpha);
+    spawn_fx_draw_overlay(&g->spawnFx, 0.0f, g->renderAlpha);
+    projectile_system_draw(g, g->renderAlpha);
+    game_draw_canonical_entities(bf, ENTITY_RENDER_LAYER_FLYING, g->renderAlpha);
     debug_overlay_draw(bf, g, s_debugFlags, &p2NavState);
     EndMode2D();
     if (s_showLaneDebug) {
@@ -537,26 +396,11 @@ void game_render(GameState *g) {
 void game_cleanup(GameState *g) {
     nfc_shutdown(&g->nfc);
 
-    // Cleanup players (no resources to free -- Battlefield owns tilemaps and entities)
-    player_cleanup(&g->players[0]);
-    player_cleanup(&g->players[1]);
-
     UnloadRenderTexture(g->p2RT);
 
-    // Destroy all live entities before dropping the registry
-    for (int i = 0; i < g->battlefield.entityCount; i++) {
-        entity_destroy(g->battlefield.entities[i]);
-    }
-    g->players[0].base = NULL;
-    g->players[1].base = NULL;
-    g->players[0].hasBaseHudSnapshot = false;
-    g->players[1].hasBaseHudSnapshot = false;
-    g->players[0].baseHudHP = 0;
-    g->players[1].baseHudHP = 0;
-    g->players[0].baseHudMaxHP = 0;
-    g->players[1].baseHudMaxHP = 0;
-    g->players[0].baseHudLevel = 0;
-    g->players[1].baseHudLevel = 0;
+    // Entities, battlefield tilemaps, and nav cache (must be before
+    // biome_free_all since tilemaps reference biome textures)
+    game_sim_cleanup_world(g);
 
     // Unload sustenance texture
     UnloadTexture(g->sustenanceTexture);
@@ -570,17 +414,12 @@ void game_cleanup(GameState *g) {
     projectile_assets_cleanup(&g->projectileAssets);
     spawn_fx_cleanup(&g->spawnFx);
     audio_cleanup(&g->audio);
-    // Cleanup Battlefield (must be before biome_free_all since tilemaps reference biome textures)
-    bf_cleanup(&g->battlefield);
-    nav_frame_destroy(&g->nav);
 
     sprite_atlas_free(&g->spriteAtlas);
     card_atlas_free(&g->cardAtlas);
     biome_free_all(g->biomeDefs);
     CloseWindow();
-    cards_free_nfc_map(&g->deck);
-    cards_free(&g->deck);
-    db_close(&g->db);
+    game_sim_unload_data(g);
 }
 
 int main(void) {
@@ -0,0 +1,330 @@
+//
+// Simulation core shared by the windowed game and the headless sim.
+//
+
+#include "game_sim.h"
+#include "config.h"
+#include "battlefield.h"
+#include "sustenance.h"
+#include "debug_events.h"
+#include "../data/card_catalog.h"
+#include "../logic/card_effects.h"
+#include "../logic/base_geometry.h"
+#include "../logic/farmer.h"
+#include "../logic/nav_frame.h"
+#include "../logic/pathfinding.h"
+#include "../logic/win_condition.h"
+#include "../rendering/viewport.h"
+#include "../rendering/spawn_fx.h"
+#include "../systems/player.h"
+#include "../systems/progression.h"
+#include "../entities/entities.h"
+#include "../entities/entity_pool.h"
+#include "../entities/building.h"
+#include "../entities/projectile.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+static void player_capture_base_hud_snapshot(Player *player, const Entity *base) {
+    if (!player || !base) return;
+
+    player->hasBaseHudSnapshot = true;
+    player->baseHudHP = base->hp;
+    player->baseHudMaxHP = base->maxHP;
+    player->baseHudLevel = base->cold->baseLevel;
+}
+
+static void game_seed_demo_hands(GameState *g) {
+    for (int playerIndex = 0; playerIndex < 2; playerIndex++) {
+        int handIndex = 0;
+        for (int presentationIndex = 0; presentationIndex < HAND_MAX_CARDS; presentationIndex++) {
+            const char *cardId = card_catalog_card_id_for_presentation_index(presentationIndex);
+            Card *card = cards_find(&g->deck, cardId);
+            if (!card) {
+                printf("[HandUI] Demo hand missing card '%s'\n", cardId);
+                continue;
+            }
+
+            player_hand_set_card(&g->players[playerIndex], handIndex, card);
+            handIndex++;
+        }
+    }
+}
+
+bool game_sim_load_data(GameState *g) {
+    const char *db_path = getenv("DB_PATH");
+    if (!db_path) db_path = "cardgame.db";
+    if (!db_init(&g->db, db_path)) {
+        printf("db_init failed -- ensure %s exists (run: make init-db)\n", db_path);
+        return false;
+    }
+
+    if (!cards_load(&g->deck, &g->db)) {
+        db_close(&g->db);
+        return false;
+    }
+
+    // Load NFC UID -> card_id mappings (non-fatal if table is empty or missing)
+    cards_load_nfc_map(&g->deck, &g->db);
+
+    // Initialize card system
+    card_action_init();
+    return true;
+}
+
+void game_sim_unload_data(GameState *g) {
+    cards_free_nfc_map(&g->deck);
+    cards_free(&g->deck);
+    db_close(&g->db);
+}
+
+void game_sim_init_world(GameState *g, uint32_t sustenanceSeed) {
+    if (g->entityCapacity <= 0) game_sim_set_entity_capacity(g, ENTITY_CAPACITY_DEFAULT);
+
+    // Every match starts with spawn serial 1, so ids (and the id-derived
+    // steering parity and animation seeds) replay identically per match.
+    entity_pool_init(g->entityCapacity);
+
+    // Initialize canonical Battlefield (authoritative world model per D-11)
+    float tileSize = DEFAULT_TILE_SIZE * DEFAULT_TILE_SCALE;
+    bf_init(&g->battlefield, g->biomeDefs,
+            BIOME_GRASS, BIOME_GRASS,  // bottom/top biome (matches current setup)
+            tileSize, 42, 99,          // seeds match current hardcoded values
+            g->entityCapacity);
+
+    // Initialize per-frame flow-field navigation cache. nav_begin_frame()
+    // is called each tick before the entity update loop (wired in Phase 2).
+    nav_frame_init(&g->nav, g->entityCapacity);
+    if (g->navBudgetUsSet) nav_set_frame_budget_us(&g->nav, g->navBudgetUs);
+    if (g->navQueryBoundedSet) nav_set_query_bounded(&g->nav, g->navQueryBounded);
+    if (g->orcaProfilesSet) pathfind_set_orca_profiles(&g->nav, g->orcaProfiles);
+    if (g->simTickSeconds <= 0.0f) game_sim_set_tick_rate(g, SIM_TICK_RATE_HZ);
+    g->simAccumulator = 0.0f;
+    g->lastFrameDeltaTime = g->simTickSeconds;
+
+    // Initialize sustenance resource nodes (dedicated RNG, after bf_init generates waypoints)
+    sustenance_init(&g->battlefield, sustenanceSeed);
+
+    projectile_system_init(&g->projectileSystem, g->entityCapacity);
+    debug_events_clear();
+
+    // Initialize split-screen viewports and players
+    viewport_init_split_screen(g);
+    game_seed_demo_hands(g);
+    for (int i = 0; i < 2; i++) {
+        g->players[i].hasBaseHudSnapshot = false;
+        g->players[i].baseHudHP = 0;
+        g->players[i].baseHudMaxHP = 0;
+        g->players[i].baseHudLevel = 0;
+    }
+
+    // Spawn home bases at the authored center-lane home anchors.
+    for (int i = 0; i < 2; i++) {
+        BattleSide side = bf_side_for_player(i);
+        CanonicalPos anchor = bf_base_anchor(&g->battlefield, side);
+        Entity *base = building_create_base(&g->players[i], anchor.v, &g->spriteAtlas);
+        if (base) {
+            g->players[i].base = base;
+            player_capture_base_hud_snapshot(&g->players[i], base);
+            bf_add_entity(&g->battlefield, base);
+        }
+        progression_sync_player(g, i);
+    }
+
+    // Match result state
+    g->gameOver = false;
+    g->winnerID = -1;
+}
+
+void game_sim_cleanup_world(GameState *g) {
+    // Cleanup players (no resources to free -- Battlefield owns tilemaps and entities)
+    player_cleanup(&g->players[0]);
+    player_cleanup(&g->players[1]);
+
+    // Destroy all live entities before dropping the registry. This returns
+    // every pool slot before entity_pool_shutdown() below.
+    for (int i = 0; i < g->battlefield.entityCount; i++) {
+        entity_destroy(g->battlefield.entities[i]);
+    }
+    g->players[0].base = NULL;
+    g->players[1].base = NULL;
+    g->players[0].hasBaseHudSnapshot = false;
+    g->players[1].hasBaseHudSnapshot = false;
+    g->players[0].baseHudHP = 0;
+    g->players[1].baseHudHP = 0;
+    g->players[0].baseHudMaxHP = 0;
+    g->players[1].baseHudMaxHP = 0;
+    g->players[0].baseHudLevel = 0;
+    g->players[1].baseHudLevel = 0;
+
+    // Cleanup Battlefield (must be before biome_free_all since tilemaps reference biome textures)
+    bf_cleanup(&g->battlefield);
+    nav_frame_destroy(&g->nav);
+    projectile_system_cleanup(&g->projectileSystem);
+    entity_pool_shutdown();
+}
+
+void game_sim_set_tick_rate(GameState *g, float tickRateHz) {
+    if (!g) return;
+    if (!(tickRateHz >= SIM_TICK_RATE_MIN_HZ)) tickRateHz = SIM_TICK_RATE_MIN_HZ;
+    if (tickRateHz > SIM_TICK_RATE_MAX_HZ) tickRateHz = SIM_TICK_RATE_MAX_HZ;
+
+    g->simTickSeconds = 1.0f / tickRateHz;
+    g->simAccumulator = 0.0f;
+    if (g->simMaxCatchUpSteps <= 0) g->simMaxCatchUpSteps = SIM_MAX_CATCHUP_STEPS;
+}
+
+void game_sim_set_entity_capacity(GameState *g, int capacity) {
+    if (!g) return;
+    if (capacity < ENTITY_CAPACITY_DEFAULT) capacity = ENTITY_CAPACITY_DEFAULT;
+    if (capacity > ENTITY_CAPACITY_MAX) capacity = ENTITY_CAPACITY_MAX;
+    g->entityCapacity = capacity;
+}
+
+void game_sim_set_nav_budget_us(GameState *g, int budgetUs) {
+    if (!g) return;
+    g->navBudgetUs = budgetUs > 0 ? budgetUs : 0;
+    g->navBudgetUsSet = true;
+    if (g->nav.initialized) {
+        nav_set_frame_budget_us(&g->nav, g->navBudgetUs);
+    }
+}
+
+void game_sim_set_nav_query_bounded(GameState *g, bool enabled) {
+    if (!g) return;
+    g->navQueryBounded = enabled;
+    g->navQueryBoundedSet = true;
+    if (g->nav.initialized) {
+        nav_set_query_bounded(&g->nav, enabled);
+    }
+}
+
+void game_sim_set_orca_profiles(GameState *g, uint32_t profileMask) {
+    if (!g) return;
+    g->orcaProfiles = profileMask;
+    g->orcaProfilesSet = true;
+    if (g->nav.initialized) {
+        pathfind_set_orca_profiles(&g->nav, profileMask);
+    }
+}
+
+void game_sim_step(GameState *g, float deltaTime) {
+    g->lastFrameDeltaTime = deltaTime;
+
+    // Freeze gameplay once match result is latched
+    // (debug event timers still decay so hit flashes fade naturally)
+    if (g->gameOver) {
+        debug_events_tick(deltaTime);
+        return;
+    }
+
+    // Update both players (energy regen, slot cooldowns)
+    player_update(&g->players[0], deltaTime);
+    player_update(&g->players[1], deltaTime);
+
+    Battlefield *bf = &g->battlefield;
+
+    // Per-frame nav snapshot. The entity pass below stamps mobile troop
+    // density and snapshots positions; static building footprints persist
+    // in the nav static layer and are restamped only after an anchored
+    // entity was added, removed or moved. Every movement decision this tick
+    // reads the same frozen snapshot.
+    nav_begin_frame(&g->nav, bf);
+    bool stampStatics = nav_static_layer_begin(&g->nav, bf->staticEntityVersion);
+    for (int i = 0; i < bf->entityCount; i++) {
+        Entity *e = bf->entities[i];
+        if (!e) continue;
+        // Start-of-tick pose for render interpolation.
+        e->prevPosition = e->position;
+        if (!e->alive) continue;
+        int side = (e->ownerID == 0) ? 0 : 1;
+        Vector2 navAnchor = e->position;
+        Vector2 navBlockerCenter = e->position;
+        if (e->navProfile == NAV_PROFILE_STATIC &&
+            e->type == ENTITY_BUILDING) {
+            navAnchor = base_interaction_anchor(e);
+            navBlockerCenter = base_nav_blocker_center(e);
+        }
+        // Freeze every live entity's position in the nav snapshot before
+        // any movement runs, so target fields built mid-tick always see
+        // the same pivot regardless of update order.
+        nav_snapshot_entity_position(&g->nav, e->id, navAnchor.x, navAnchor.y);
+        if (e->navProfile == NAV_PROFILE_STATIC) {
+            if (!stampStatics) continue;
+            if (e->type == ENTITY_BUILDING) {
+                for (int cellIdx = 0; cellIdx < BASE_NAV_HARD_CORE_CELL_COUNT; ++cellIdx) {
+                    Vector2 cellPoint = { 0 };
+                    if (!base_nav_hard_core_cell_point(e, cellIdx, &cellPoint)) continue;
+                    nav_stamp_static_entity_cell(&g->nav, e->id,
+                                                cellPoint.x, cellPoint.y);
+                }
+            } else {
+                float radius = (e->navRadius > 0.0f) ? e->navRadius : e->bodyRadius;
+                if (radius <= 0.0f) radius = BASE_NAV_RADIUS;
+                nav_stamp_static_entity(&g->nav, e->id,
+                                        navBlockerCenter.x, navBlockerCenter.y, radius);
+            }
+        } else {
+            nav_stamp_density(&g->nav, side, e->position.x, e->position.y);
+        }
+    }
+
+    // Bring last tick's flow fields up to date for this snapshot in one
+    // parallel pass, so lookups during the update loop are mostly hits.
+    nav_build_requested_fields(&g->nav, bf);
+
+    // Spatial index snapshot for combat range queries. Each entity is
+    // re-binned right after its own update so later updaters query current
+    // positions.
+    bf_spatial_rebuild(bf);
+
+    // Update all entities in registry order. The registry is kept id-sorted,
+    // so local steering jams resolve deterministically (lower-id wins the
+    // jam). Entities spawned mid-loop append past updateCount and first
+    // update next tick.
+    int updateCount = bf->entityCount;
+    for (int i = 0; i < updateCount && i < bf->entityCount; i++) {
+        Entity *e = bf->entities[i];
+        entity_update(e, g, deltaTime);
+        bf_spatial_update(bf, e);
+        if (g->gameOver) break;  // Win latched mid-loop -- stop processing
+    }
+
+    if (!g->gameOver) {
+        projectile_system_update(g, deltaTime);
+    }
+
+    // Defensive fallback: catch base deaths from non-combat paths
+    win_check(g);
+
+    // Blood FX should follow damaged entities for the rest of the frame, then
+    // freeze once the entity is gone after the sweep below.
+    spawn_fx_sync_blood_attachments(&g->spawnFx, bf);
+
+    // Sweep dead/removed entities (runs once on the trigger frame, then frozen).
+    // Compaction keeps the registry id-sorted for next tick's update order.
+    int removedCount = bf_remove_marked_entities(bf);
+    for (int i = 0; i < removedCount; i++) {
+        Entity *dead = bf->removedEntities[i];
+
+        // Farmer death fallback: release claims / award sustenance.
+        // farmer_on_death is idempotent — safe if already called from combat.
+        if (dead->unitRole == UNIT_ROLE_FARMER) {
+            farmer_on_death(dead, g);
+        }
+
+        // Clear stale base pointers before freeing memory
+        if (dead == g->players[0].base) {
+            player_capture_base_hud_snapshot(&g->players[0], dead);
+            g->players[0].base = NULL;
+        }
+        if (dead == g->players[1].base) {
+            player_capture_base_hud_snapshot(&g->players[1], dead);
+            g->players[1].base = NULL;
+        }
+
+        entity_destroy(dead);
+    }
+
+    debug_events_tick(deltaTime);
+}
@@ -0,0 +1,61 @@
+//
+// Simulation core shared by the windowed game and the headless sim.
+//
+// Nothing in here opens a window, touches audio, polls input, or reads
+// GetFrameTime(): callers own the clock and pass deltaTime explicitly.
+//
+
+#ifndef NFC_CARDGAME_GAME_SIM_H
+#define NFC_CARDGAME_GAME_SIM_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Open the DB, load the card deck + NFC map, and register card handlers.
+bool game_sim_load_data(GameState *g);
+
+// Release everything game_sim_load_data acquired.
+void game_sim_unload_data(GameState *g);
+
+// Build a fresh match: battlefield, nav cache, sustenance, projectiles,
+// players, demo hands, and both home bases. Requires g->biomeDefs and
+// g->spriteAtlas to be initialized (headless variants are fine).
+void game_sim_init_world(GameState *g, uint32_t sustenanceSeed);
+
+// Destroy every live entity and tear down the battlefield and nav cache.
+// Safe to follow with another game_sim_init_world for the next match.
+void game_sim_cleanup_world(GameState *g);
+
+// Set the fixed simulation tick rate, clamped to
+// [SIM_TICK_RATE_MIN_HZ, SIM_TICK_RATE_MAX_HZ]. Resets the accumulator.
+void game_sim_set_tick_rate(GameState *g, float tickRateHz);
+
+// Set the live entity cap (both sides) used by the next
+// game_sim_init_world, clamped to [ENTITY_CAPACITY_DEFAULT,
+// ENTITY_CAPACITY_MAX]. Has no effect on a match already in progress.
+void game_sim_set_entity_capacity(GameState *g, int capacity);
+
+// Set the per-tick nav build budget (microseconds) for the match in
+// progress and every later game_sim_init_world; <= 0 turns the budget off.
+// Until this is called, matches use NAV_FRAME_BUDGET_US. A budget trades
+// deterministic replays for a bounded tick: which fields are deferred
+// depends on machine speed.
+void game_sim_set_nav_budget_us(GameState *g, int budgetUs);
+
+// Turn query-bounded nav target / free-goal builds on or off for the match
+// in progress and every later game_sim_init_world. Until this is called,
+// matches use NAV_QUERY_BOUNDED. Sampled flow is unchanged, so replays
+// still match.
+void game_sim_set_nav_query_bounded(GameState *g, bool enabled);
+
+// Steer the UnitNavProfile bits in `profileMask` (1u << profile) with ORCA
+// crowd avoidance instead of the candidate fan, for the match in progress
+// and every later game_sim_init_world; 0 keeps the fan for every profile.
+// Until this is called, matches use PATHFIND_ORCA_PROFILES.
+void game_sim_set_orca_profiles(GameState *g, uint32_t profileMask);
+
+// Advance the match by one simulation tick of deltaTime seconds.
+void game_sim_step(GameState *g, float deltaTime);
+
+#endif //NFC_CARDGAME_GAME_SIM_H
@@ -0,0 +1,129 @@
+//
+// Lane arc-length tables and a coarse projection grid.
+//
+
+#include "lane_progress.h"
+#include <math.h>
+#include <string.h>
+
+_Static_assert(LANE_SEGMENT_COUNT >= 1 && LANE_SEGMENT_COUNT <= 8,
+               "lane candidate masks hold one bit per segment in a uint8_t");
+
+// Every point of a cell lies within half a diagonal of its center, so a
+// segment can only be nearest somewhere in the cell if its distance from the
+// center is within a full diagonal of the best one. The extra pixel absorbs
+// float rounding in the distances compared.
+#define LANE_PROGRESS_SLACK_PX \
+    ((float)LANE_PROGRESS_CELL_SIZE_PX * 1.41421356f + 1.0f)
+
+// Project `position` onto segment `s`. Returns the squared distance and the
+// clamped segment parameter.
+static float lane_segment_project(const LaneProgressTable *table, int s,
+                                  Vector2 position, float *outT, Vector2 *outClosest) {
+    Vector2 a = table->points[s];
+    Vector2 b = table->points[s + 1];
+    float abx = b.x - a.x;
+    float aby = b.y - a.y;
+    float abLenSq = abx * abx + aby * aby;
+    float t = 0.0f;
+    Vector2 closest = a;
+
+    if (abLenSq > 0.0001f) {
+        float apx = position.x - a.x;
+        float apy = position.y - a.y;
+        t = (apx * abx + apy * aby) / abLenSq;
+        if (t < 0.0f) t = 0.0f;
+        if (t > 1.0f) t = 1.0f;
+        closest.x = a.x + abx * t;
+        closest.y = a.y + aby * t;
+    }
+
+    float dx = position.x - closest.x;
+    float dy = position.y - closest.y;
+    *outT = t;
+    *outClosest = closest;
+    return dx * dx + dy * dy;
+}
+
+void lane_progress_build(LaneProgressTable *table,
+                         const CanonicalPos waypoints[LANE_WAYPOINT_COUNT]) {
+    if (!table || !waypoints) return;
+    memset(table, 0, sizeof(*table));
+    for (int wp = 0; wp < LANE_WAYPOINT_COUNT; wp++) {
+        table->points[wp] = waypoints[wp].v;
+    }
+
+    float accumulated = 0.0f;
+    table->cumulative[0] = 0.0f;
+    for (int s = 0; s < LANE_SEGMENT_COUNT; s++) {
+        float dx = table->points[s + 1].x - table->points[s].x;
+        float dy = table->points[s + 1].y - table->points[s].y;
+        table->segmentLength[s] = sqrtf(dx * dx + dy * dy);
+        accumulated += table->segmentLength[s];
+        table->cumulative[s + 1] = accumulated;
+    }
+    table->total = accumulated;
+
+    for (int row = 0; row < LANE_PROGRESS_ROWS; row++) {
+        for (int col = 0; col < LANE_PROGRESS_COLS; col++) {
+            Vector2 center = {
+                ((float)col + 0.5f) * (float)LANE_PROGRESS_CELL_SIZE_PX,
+                ((float)row + 0.5f) * (float)LANE_PROGRESS_CELL_SIZE_PX
+            };
+            float dist[LANE_SEGMENT_COUNT];
+            float best = INFINITY;
+            for (int s = 0; s < LANE_SEGMENT_COUNT; s++) {
+                float t;
+                Vector2 closest;
+                dist[s] = sqrtf(lane_segment_project(table, s, center, &t, &closest));
+                if (dist[s] < best) best = dist[s];
+            }
+            uint8_t mask = 0;
+            for (int s = 0; s < LANE_SEGMENT_COUNT; s++) {
+                if (dist[s] <= best + LANE_PROGRESS_SLACK_PX) mask |= (uint8_t)(1u << s);
+            }
+            table->candidates[row * LANE_PROGRESS_COLS + col] = mask;
+        }
+    }
+}
+
+uint8_t lane_progress_candidates(const LaneProgressTable *table, Vector2 position) {
+    float col = floorf(position.x / (float)LANE_PROGRESS_CELL_SIZE_PX);
+    float row = floorf(position.y / (float)LANE_PROGRESS_CELL_SIZE_PX);
+    // Written so NaN coordinates also take the full scan.
+    if (!(col >= 0.0f && col < (float)LANE_PROGRESS_COLS &&
+          row >= 0.0f && row < (float)LANE_PROGRESS_ROWS)) {
+        return LANE_SEGMENT_MASK_ALL;
+    }
+    return table->candidates[(int)row * LANE_PROGRESS_COLS + (int)col];
+}
+
+float lane_progress_project(const LaneProgressTable *table, Vector2 position,
+                            Vector2 *outClosest) {
+    float bestDistSq = INFINITY;
+    float bestProgress = 0.0f;
+    Vector2 bestPoint = table->points[0];
+
+    uint8_t mask = lane_progress_candidates(table, position);
+    for (int s = 0; s < LANE_SEGMENT_COUNT; s++) {
+        if (!(mask & (1u << s))) continue;
+        float t;
+        Vector2 closest;
+        float distSq = lane_segment_project(table, s, position, &t, &closest);
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            bestProgress = table->cumulative[s] + table->segmentLength[s] * t;
+            bestPoint = closest;
+        }
+    }
+
+    if (outClosest) *outClosest = bestPoint;
+    return bestProgress;
+}
+
+int lane_progress_waypoint_index(const LaneProgressTable *table, float progress) {
+    for (int wp = 1; wp < LANE_WAYPOINT_COUNT; wp++) {
+        if (table->cumulative[wp] > progress + 0.001f) return wp;
+    }
+    return LANE_WAYPOINT_COUNT;
+}
@@ -0,0 +1,67 @@
+//
+// Lane arc-length tables and a coarse projection grid.
+//
+// Lane waypoints never change once bf_init has generated them, so what
+// pathfinding used to re-derive every tick is built there once per match:
+// each segment's length, the cumulative arc length at every waypoint, and
+// for each LANE_PROGRESS_CELL_SIZE_PX cell of the board the segments that
+// can be nearest to some point inside it. A projection only visits those
+// candidates -- one or two away from the bends -- in polyline order and
+// with the same arithmetic as a scan of every segment, so it returns
+// exactly what the full scan would.
+//
+
+#ifndef NFC_CARDGAME_LANE_PROGRESS_H
+#define NFC_CARDGAME_LANE_PROGRESS_H
+
+#include <raylib.h>
+
+// Raylib's Vector2 is already defined; suppress battlefield_math.h's fallback.
+#ifndef VECTOR2_DEFINED
+#define VECTOR2_DEFINED
+#endif
+#include "battlefield_math.h"
+#include "config.h"
+#include <stdint.h>
+
+#define LANE_SEGMENT_COUNT (LANE_WAYPOINT_COUNT - 1)
+
+// Edge length of a candidate-grid cell. Smaller cells give fewer
+// candidates per cell at a larger table.
+#ifndef LANE_PROGRESS_CELL_SIZE_PX
+#define LANE_PROGRESS_CELL_SIZE_PX 32
+#endif
+
+#define LANE_PROGRESS_COLS  ((BOARD_WIDTH  + LANE_PROGRESS_CELL_SIZE_PX - 1) / LANE_PROGRESS_CELL_SIZE_PX)
+#define LANE_PROGRESS_ROWS  ((BOARD_HEIGHT + LANE_PROGRESS_CELL_SIZE_PX - 1) / LANE_PROGRESS_CELL_SIZE_PX)
+#define LANE_PROGRESS_CELLS (LANE_PROGRESS_COLS * LANE_PROGRESS_ROWS)
+
+// Every segment, as a candidate mask. Used off the board.
+#define LANE_SEGMENT_MASK_ALL ((uint8_t)((1u << LANE_SEGMENT_COUNT) - 1u))
+
+typedef struct {
+    Vector2 points[LANE_WAYPOINT_COUNT];
+    float   segmentLength[LANE_SEGMENT_COUNT];
+    float   cumulative[LANE_WAYPOINT_COUNT];   // arc length at each waypoint
+    float   total;
+    // Bit s set when segment s is nearest to some point of the cell.
+    uint8_t candidates[LANE_PROGRESS_CELLS];
+} LaneProgressTable;
+
+// Build the tables for one lane polyline.
+void lane_progress_build(LaneProgressTable *table,
+                         const CanonicalPos waypoints[LANE_WAYPOINT_COUNT]);
+
+// Candidate segments for `position`; every segment when it is off the board.
+uint8_t lane_progress_candidates(const LaneProgressTable *table, Vector2 position);
+
+// Arc length at the point of the polyline nearest to `position` (the
+// earliest segment wins ties), written to outClosest when given.
+float lane_progress_project(const LaneProgressTable *table, Vector2 position,
+                            Vector2 *outClosest);
+
+// Lowest waypoint index whose arc length exceeds `progress` by more than
+// 0.001 px, or LANE_WAYPOINT_COUNT past the end.
+int lane_progress_waypoint_index(const LaneProgressTable *table, float progress);
+
+#endif //NFC_CARDGAME_LANE_PROGRESS_H
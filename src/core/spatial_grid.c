@@ -0,0 +1,395 @@
+//
+// Uniform-grid spatial index over the Battlefield entity registry.
+//
+
+#include "spatial_grid.h"
+#include "types.h"
+#include "../entities/entities.h"
+#include "../entities/entity_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+// Owners are player indices; anything that is not player 0 buckets with
+// player 1, matching the nav density split in game_sim_step.
+static int spatial_owner_bucket(int ownerID) {
+    return (ownerID == 0) ? 0 : 1;
+}
+
+// Owner buckets a filter has to walk. Faction-filtered queries skip the
+// other side's lists entirely -- the common "nearest enemy" scan would
+// otherwise wade through every friendly unit between it and the front.
+static void spatial_filter_buckets(const SpatialFilter *filter, int *first, int *last) {
+    *first = 0;
+    *last = SPATIAL_GRID_OWNER_BUCKETS - 1;
+    if (!filter || filter->owner == SPATIAL_OWNER_ANY) return;
+    int bucket = spatial_owner_bucket(filter->ownerId);
+    if (filter->owner == SPATIAL_OWNER_OTHER) bucket = 1 - bucket;
+    *first = bucket;
+    *last = bucket;
+}
+
+// Axis cell index, clamped so off-board positions land in the edge cells.
+// Clamped in float first so huge query extents cannot overflow the cast.
+static int spatial_axis_cell(const SpatialGrid *grid, float v, int count) {
+    float c = floorf(v / grid->cellSize);
+    if (!(c >= 0.0f)) return 0;
+    if (c >= (float)(count - 1)) return count - 1;
+    return (int)c;
+}
+
+// Index into cellHead: (cell, owner bucket) pairs.
+static int spatial_list_for(const SpatialGrid *grid, Vector2 pos, int ownerID) {
+    int cx = spatial_axis_cell(grid, pos.x, grid->cols);
+    int cy = spatial_axis_cell(grid, pos.y, grid->rows);
+    return (cy * grid->cols + cx) * SPATIAL_GRID_OWNER_BUCKETS +
+           spatial_owner_bucket(ownerID);
+}
+
+static int spatial_slot_for(const SpatialGrid *grid, const Entity *e) {
+    if (!e || e->id < 0) return -1;
+    int slot = entity_id_slot(e->id);
+    return (slot < grid->capacity) ? slot : -1;
+}
+
+static void spatial_link(SpatialGrid *grid, int slot, int list) {
+    int head = grid->cellHead[list];
+    grid->prev[slot] = -1;
+    grid->next[slot] = head;
+    if (head >= 0) grid->prev[head] = slot;
+    grid->cellHead[list] = slot;
+    grid->cellOf[slot] = list;
+}
+
+static void spatial_unlink(SpatialGrid *grid, int slot) {
+    int list = grid->cellOf[slot];
+    if (list < 0) return;
+    int prev = grid->prev[slot];
+    int next = grid->next[slot];
+    if (prev >= 0) grid->next[prev] = next;
+    else grid->cellHead[list] = next;
+    if (next >= 0) grid->prev[next] = prev;
+    grid->prev[slot] = -1;
+    grid->next[slot] = -1;
+    grid->cellOf[slot] = -1;
+}
+
+static bool spatial_filter_matches(const SpatialFilter *filter, const Entity *e,
+                                   bool airborne) {
+    if (!e->alive || e->markedForRemoval) return false;
+    if (!filter) return true;
+    if (filter->owner == SPATIAL_OWNER_SAME && e->ownerID != filter->ownerId) return false;
+    if (filter->owner == SPATIAL_OWNER_OTHER && e->ownerID == filter->ownerId) return false;
+    if (filter->air == SPATIAL_AIR_EXCLUDE && airborne) return false;
+    if (filter->air == SPATIAL_AIR_ONLY && !airborne) return false;
+    if (filter->accept && !filter->accept(e, filter->ctx)) return false;
+    return true;
+}
+
+// Airborne-only queries against a side with no fliers are common (anti-air
+// units scanning for birds); answer those without walking any cell.
+static bool spatial_filter_has_no_candidates(const SpatialGrid *grid,
+                                             const SpatialFilter *filter) {
+    if (!filter || filter->air != SPATIAL_AIR_ONLY) return false;
+    int bucket = spatial_owner_bucket(filter->ownerId);
+    switch (filter->owner) {
+        case SPATIAL_OWNER_SAME:  return grid->airborneCount[bucket] == 0;
+        case SPATIAL_OWNER_OTHER: return grid->airborneCount[1 - bucket] == 0;
+        default:
+            return grid->airborneCount[0] + grid->airborneCount[1] == 0;
+    }
+}
+
+static void spatial_statics_insert(SpatialGrid *grid, Entity *e) {
+    int i = grid->staticCount;
+    while (i > 0 && grid->statics[i - 1]->id > e->id) {
+        grid->statics[i] = grid->statics[i - 1];
+        i--;
+    }
+    grid->statics[i] = e;
+    grid->staticCount++;
+}
+
+static void spatial_statics_remove(SpatialGrid *grid, const Entity *e) {
+    for (int i = 0; i < grid->staticCount; i++) {
+        if (grid->statics[i] != e) continue;
+        memmove(&grid->statics[i], &grid->statics[i + 1],
+                (size_t)(grid->staticCount - i - 1) * sizeof(grid->statics[0]));
+        grid->staticCount--;
+        return;
+    }
+}
+
+static int spatial_compare_entity_id(const void *a, const void *b) {
+    const Entity *ea = *(Entity *const *)a;
+    const Entity *eb = *(Entity *const *)b;
+    return (ea->id > eb->id) - (ea->id < eb->id);
+}
+
+// Lower bound on the distance from `center` to anything binned in ring r
+// (cells at Chebyshev cell-distance r from the center cell). Edge cells
+// extend to infinity, which only moves their entities further outward, so
+// the bound stays conservative for clamped positions.
+static float spatial_ring_lower_bound(const SpatialGrid *grid, Vector2 center,
+                                      int ccx, int ccy, int r) {
+    if (r <= 0) return 0.0f;
+    float cs = grid->cellSize;
+    float bound = (float)(ccx + r) * cs - center.x;
+    float left = center.x - (float)(ccx - r + 1) * cs;
+    float down = (float)(ccy + r) * cs - center.y;
+    float up = center.y - (float)(ccy - r + 1) * cs;
+    if (left < bound) bound = left;
+    if (down < bound) bound = down;
+    if (up < bound) bound = up;
+    // Half a pixel of margin absorbs rounding in the cell assignment.
+    bound -= 0.5f;
+    return (bound > 0.0f) ? bound : 0.0f;
+}
+
+// Running top-k for spatial_grid_query_nearest, kept sorted by
+// (distance, id). dist[] mirrors out[] so callers may omit outDist.
+typedef struct {
+    Entity **out;
+    float dist[SPATIAL_GRID_NEAREST_MAX];
+    int k;
+    int found;
+} SpatialNearest;
+
+static void spatial_nearest_visit_list(const SpatialGrid *grid, int head,
+                                       const SpatialFilter *filter,
+                                       CanonicalPos centerPos, SpatialNearest *best) {
+    for (int slot = head; slot >= 0; slot = grid->next[slot]) {
+        Entity *e = grid->slotEntity[slot];
+        if (!spatial_filter_matches(filter, e, grid->slotAirborne[slot])) continue;
+
+        CanonicalPos pos = { e->position };
+        float d = bf_distance(centerPos, pos);
+        int last = best->k - 1;
+        if (best->found == best->k &&
+            (d > best->dist[last] ||
+             (d == best->dist[last] && e->id > best->out[last]->id))) {
+            continue;
+        }
+
+        int i = (best->found < best->k) ? best->found++ : last;
+        while (i > 0 && (best->dist[i - 1] > d ||
+                         (best->dist[i - 1] == d && best->out[i - 1]->id > e->id))) {
+            best->dist[i] = best->dist[i - 1];
+            best->out[i] = best->out[i - 1];
+            i--;
+        }
+        best->dist[i] = d;
+        best->out[i] = e;
+    }
+}
+
+// --- Public API ---
+
+bool spatial_grid_init(SpatialGrid *grid, float width, float height,
+                       float cellSize, int capacity) {
+    memset(grid, 0, sizeof(*grid));
+    if (cellSize <= 0.0f) cellSize = SPATIAL_GRID_CELL_SIZE_PX;
+    if (capacity < 1) capacity = 1;
+
+    grid->cellSize = cellSize;
+    grid->cols = (int)ceilf(width / cellSize);
+    grid->rows = (int)ceilf(height / cellSize);
+    if (grid->cols < 1) grid->cols = 1;
+    if (grid->rows < 1) grid->rows = 1;
+    grid->capacity = capacity;
+
+    size_t cells = (size_t)grid->cols * (size_t)grid->rows * SPATIAL_GRID_OWNER_BUCKETS;
+    grid->cellHead = malloc(cells * sizeof(int));
+    grid->next = malloc((size_t)capacity * sizeof(int));
+    grid->prev = malloc((size_t)capacity * sizeof(int));
+    grid->cellOf = malloc((size_t)capacity * sizeof(int));
+    grid->slotEntity = calloc((size_t)capacity, sizeof(Entity *));
+    grid->slotAirborne = calloc((size_t)capacity, sizeof(bool));
+    grid->scratch = calloc((size_t)capacity, sizeof(Entity *));
+    grid->statics = calloc((size_t)capacity, sizeof(Entity *));
+    if (!grid->cellHead || !grid->next || !grid->prev || !grid->cellOf ||
+        !grid->slotEntity || !grid->slotAirborne || !grid->scratch ||
+        !grid->statics) {
+        fprintf(stderr, "[SpatialGrid] Out of memory for %d entities\n", capacity);
+        spatial_grid_destroy(grid);
+        return false;
+    }
+
+    for (size_t i = 0; i < cells; i++) grid->cellHead[i] = -1;
+    for (int i = 0; i < capacity; i++) {
+        grid->next[i] = -1;
+        grid->prev[i] = -1;
+        grid->cellOf[i] = -1;
+    }
+    return true;
+}
+
+void spatial_grid_destroy(SpatialGrid *grid) {
+    if (!grid) return;
+    free(grid->cellHead);
+    free(grid->next);
+    free(grid->prev);
+    free(grid->cellOf);
+    free(grid->slotEntity);
+    free(grid->slotAirborne);
+    free(grid->scratch);
+    free(grid->statics);
+    memset(grid, 0, sizeof(*grid));
+}
+
+bool spatial_grid_is_anchored(const Entity *e) {
+    if (!e) return false;
+    return e->type == ENTITY_BUILDING || e->navProfile == NAV_PROFILE_STATIC;
+}
+
+void spatial_grid_insert(SpatialGrid *grid, Entity *e) {
+    int slot = spatial_slot_for(grid, e);
+    if (slot < 0 || !grid->cellHead) return;
+    if (grid->cellOf[slot] >= 0) spatial_grid_remove(grid, grid->slotEntity[slot]);
+
+    bool airborne = entity_is_airborne(e);
+    grid->slotEntity[slot] = e;
+    grid->slotAirborne[slot] = airborne;
+    if (airborne) grid->airborneCount[spatial_owner_bucket(e->ownerID)]++;
+    if (spatial_grid_is_anchored(e)) {
+        spatial_statics_insert(grid, e);
+    } else {
+        float radius = (e->navRadius > e->bodyRadius) ? e->navRadius : e->bodyRadius;
+        if (radius > grid->maxMobileRadius) grid->maxMobileRadius = radius;
+    }
+    spatial_link(grid, slot, spatial_list_for(grid, e->position, e->ownerID));
+}
+
+void spatial_grid_remove(SpatialGrid *grid, const Entity *e) {
+    int slot = spatial_slot_for(grid, e);
+    if (slot < 0 || !grid->cellHead) return;
+    if (grid->cellOf[slot] < 0 || grid->slotEntity[slot] != e) return;
+
+    spatial_unlink(grid, slot);
+    if (grid->slotAirborne[slot]) {
+        grid->airborneCount[spatial_owner_bucket(e->ownerID)]--;
+    }
+    if (spatial_grid_is_anchored(e)) spatial_statics_remove(grid, e);
+    grid->slotEntity[slot] = NULL;
+    grid->slotAirborne[slot] = false;
+}
+
+void spatial_grid_update(SpatialGrid *grid, const Entity *e) {
+    int slot = spatial_slot_for(grid, e);
+    if (slot < 0 || !grid->cellHead) return;
+    if (grid->cellOf[slot] < 0 || grid->slotEntity[slot] != e) return;
+
+    int list = spatial_list_for(grid, e->position, e->ownerID);
+    if (list == grid->cellOf[slot]) return;
+    spatial_unlink(grid, slot);
+    spatial_link(grid, slot, list);
+}
+
+void spatial_grid_rebuild(SpatialGrid *grid, Entity *const *entities, int count) {
+    if (!grid->cellHead) return;
+
+    size_t cells = (size_t)grid->cols * (size_t)grid->rows * SPATIAL_GRID_OWNER_BUCKETS;
+    for (size_t i = 0; i < cells; i++) grid->cellHead[i] = -1;
+    for (int i = 0; i < grid->capacity; i++) {
+        grid->next[i] = -1;
+        grid->prev[i] = -1;
+        grid->cellOf[i] = -1;
+        grid->slotEntity[i] = NULL;
+        grid->slotAirborne[i] = false;
+    }
+    grid->airborneCount[0] = 0;
+    grid->airborneCount[1] = 0;
+    grid->staticCount = 0;
+    grid->maxMobileRadius = 0.0f;
+
+    // Insert in reverse so each cell list ends up in ascending id order.
+    // Queries sort anyway; this just keeps the sort close to a no-op.
+    for (int i = count - 1; i >= 0; i--) {
+        if (entities[i]) spatial_grid_insert(grid, entities[i]);
+    }
+}
+
+int spatial_grid_query_radius(const SpatialGrid *grid, Vector2 center, float radius,
+                              const SpatialFilter *filter) {
+    if (!grid->cellHead || radius < 0.0f) return 0;
+    if (spatial_filter_has_no_candidates(grid, filter)) return 0;
+
+    // One pixel of slack so a candidate whose exact float distance lands on
+    // the radius is never lost to cell-edge rounding.
+    float extent = radius + 1.0f;
+    int x0 = spatial_axis_cell(grid, center.x - extent, grid->cols);
+    int x1 = spatial_axis_cell(grid, center.x + extent, grid->cols);
+    int y0 = spatial_axis_cell(grid, center.y - extent, grid->rows);
+    int y1 = spatial_axis_cell(grid, center.y + extent, grid->rows);
+
+    int b0, b1;
+    spatial_filter_buckets(filter, &b0, &b1);
+
+    int count = 0;
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int base = (cy * grid->cols + cx) * SPATIAL_GRID_OWNER_BUCKETS;
+            for (int b = b0; b <= b1; b++) {
+                for (int slot = grid->cellHead[base + b]; slot >= 0;
+                     slot = grid->next[slot]) {
+                    Entity *e = grid->slotEntity[slot];
+                    if (!spatial_filter_matches(filter, e, grid->slotAirborne[slot])) continue;
+                    grid->scratch[count++] = e;
+                }
+            }
+        }
+    }
+
+    if (count > 1) {
+        qsort(grid->scratch, (size_t)count, sizeof(grid->scratch[0]),
+              spatial_compare_entity_id);
+    }
+    return count;
+}
+
+int spatial_grid_query_nearest(const SpatialGrid *grid, Vector2 center, int k,
+                               const SpatialFilter *filter,
+                               Entity **out, float *outDist) {
+    if (!grid->cellHead || k <= 0 || !out) return 0;
+    if (spatial_filter_has_no_candidates(grid, filter)) return 0;
+
+    SpatialNearest best = { .out = out, .found = 0 };
+    best.k = (k > SPATIAL_GRID_NEAREST_MAX) ? SPATIAL_GRID_NEAREST_MAX : k;
+
+    int ccx = spatial_axis_cell(grid, center.x, grid->cols);
+    int ccy = spatial_axis_cell(grid, center.y, grid->rows);
+    int maxRing = (grid->cols > grid->rows) ? grid->cols : grid->rows;
+    CanonicalPos centerPos = { center };
+    int b0, b1;
+    spatial_filter_buckets(filter, &b0, &b1);
+
+    for (int r = 0; r <= maxRing; r++) {
+        // Every unvisited cell is at least this far away; stop once it
+        // cannot beat (or tie) the current k-th best.
+        if (best.found == best.k &&
+            spatial_ring_lower_bound(grid, center, ccx, ccy, r) > best.dist[best.k - 1]) {
+            break;
+        }
+
+        // Walk only the perimeter of the (2r+1)^2 block.
+        int y0 = ccy - r, y1 = ccy + r;
+        for (int cy = y0; cy <= y1; cy++) {
+            if (cy < 0 || cy >= grid->rows) continue;
+            int step = (cy == y0 || cy == y1) ? 1 : 2 * r;
+            for (int cx = ccx - r; cx <= ccx + r; cx += step) {
+                if (cx < 0 || cx >= grid->cols) continue;
+                int base = (cy * grid->cols + cx) * SPATIAL_GRID_OWNER_BUCKETS;
+                for (int b = b0; b <= b1; b++) {
+                    spatial_nearest_visit_list(grid, grid->cellHead[base + b],
+                                               filter, centerPos, &best);
+                }
+            }
+        }
+    }
+
+    if (outDist) {
+        for (int i = 0; i < best.found; i++) outDist[i] = best.dist[i];
+    }
+    return best.found;
+}
@@ -0,0 +1,118 @@
+//
+// Uniform-grid spatial index over the Battlefield entity registry.
+//
+// Every registered entity is binned into one SPATIAL_GRID_CELL_SIZE_PX cell
+// by its position, in a per-owner list so faction-filtered queries never
+// touch the other side. Lists are intrusive and doubly linked, keyed by pool
+// slot (entity_pool.h), so insert, remove and re-bin are O(1).
+//
+// Ownership and freshness: the Battlefield owns one grid. bf_add_entity /
+// bf_remove_* keep membership in sync; game_sim_step rebuilds every bin
+// once per tick alongside nav_begin_frame and re-bins each entity right
+// after its own entity_update(), so queries made by any other entity
+// mid-tick see current positions.
+//
+// Query results are candidate supersets in ascending id order (= registry
+// order), so callers that run their original registry-order selection loop
+// over the result pick exactly the same entity as a full registry scan.
+//
+
+#ifndef NFC_CARDGAME_SPATIAL_GRID_H
+#define NFC_CARDGAME_SPATIAL_GRID_H
+
+#include <raylib.h>
+
+// Raylib's Vector2 is already defined; suppress battlefield_math.h's fallback.
+#ifndef VECTOR2_DEFINED
+#define VECTOR2_DEFINED
+#endif
+#include "battlefield_math.h"
+#include <stdbool.h>
+
+typedef struct Entity Entity;
+
+// Owners are player indices 0 and 1; each gets its own list per cell.
+#define SPATIAL_GRID_OWNER_BUCKETS 2
+
+typedef enum {
+    SPATIAL_OWNER_ANY = 0,
+    SPATIAL_OWNER_SAME,         // entity->ownerID == filter.ownerId
+    SPATIAL_OWNER_OTHER         // entity->ownerID != filter.ownerId
+} SpatialOwnerMatch;
+
+typedef enum {
+    SPATIAL_AIR_ANY = 0,
+    SPATIAL_AIR_EXCLUDE,        // ground only
+    SPATIAL_AIR_ONLY            // airborne only
+} SpatialAirPolicy;
+
+// Candidate filter. Dead / markedForRemoval entities never match. `accept`
+// is optional and runs last, after the owner and airborne tests.
+typedef struct {
+    int ownerId;
+    SpatialOwnerMatch owner;
+    SpatialAirPolicy air;
+    bool (*accept)(const Entity *e, const void *ctx);
+    const void *ctx;
+} SpatialFilter;
+
+typedef struct {
+    float cellSize;
+    int cols;
+    int rows;
+    int *cellHead;              // [cols * rows * SPATIAL_GRID_OWNER_BUCKETS]
+                                // first slot per (cell, owner), -1 = empty
+    int capacity;               // pool slots (entity_pool_capacity())
+    int *next;                  // [capacity] per-slot list links, -1 = none
+    int *prev;
+    int *cellOf;                // [capacity] current cellHead list, -1 = not binned
+    Entity **slotEntity;        // [capacity]
+    bool *slotAirborne;         // [capacity] airborne flag cached at insert
+    int airborneCount[2];       // binned airborne entities per ownerID
+    Entity **scratch;           // [capacity] query result buffer
+
+    // Anchored entities (buildings / NAV_PROFILE_STATIC) have large footprints
+    // centered away from their position, so blocker searches take them from
+    // this id-sorted list instead of a radius query. Everything else is
+    // "mobile"; maxMobileRadius bounds their nav/body radius so a radius
+    // query padded by it finds every mobile footprint that reaches a point.
+    Entity **statics;           // [capacity]
+    int staticCount;
+    float maxMobileRadius;      // raised on insert, recomputed by rebuild
+} SpatialGrid;
+
+// Allocate a grid covering [0, width) x [0, height). Positions outside the
+// board clamp into the edge cells.
+bool spatial_grid_init(SpatialGrid *grid, float width, float height,
+                       float cellSize, int capacity);
+void spatial_grid_destroy(SpatialGrid *grid);
+
+// Membership, keyed by entity_id_slot(e->id).
+void spatial_grid_insert(SpatialGrid *grid, Entity *e);
+void spatial_grid_remove(SpatialGrid *grid, const Entity *e);
+
+// Re-bin one entity after its position changed. O(1); no-op if the entity
+// stayed inside its cell or is not binned.
+void spatial_grid_update(SpatialGrid *grid, const Entity *e);
+
+// Clear every bin and re-insert entities[0..count).
+void spatial_grid_rebuild(SpatialGrid *grid, Entity *const *entities, int count);
+
+// True for entities kept on the statics list.
+bool spatial_grid_is_anchored(const Entity *e);
+
+// Every matching entity whose cell touches the square of half-extent
+// `radius` around `center`. A superset of the exact disk -- callers apply
+// their own distance test. Written to grid->scratch in ascending id order;
+// returns the count. The scratch buffer is overwritten by the next query.
+int spatial_grid_query_radius(const SpatialGrid *grid, Vector2 center, float radius,
+                              const SpatialFilter *filter);
+
+// Up to k matching entities nearest to `center`, ordered by canonical
+// distance (bf_distance) and then ascending id. Distances are written to
+// outDist when non-NULL. Returns the count written to out.
+int spatial_grid_query_nearest(const SpatialGrid *grid, Vector2 center, int k,
+                               const SpatialFilter *filter,
+                               Entity **out, float *outDist);
+
+#endif //NFC_CARDGAME_SPATIAL_GRID_H
@@ -23,8 +23,6 @@ typedef struct Entity Entity;
 typedef struct Player Player;
 typedef struct GameState GameState;
 
-#define PROJECTILE_CAPACITY (MAX_ENTITIES * 2)
-
 // Entity enums
 typedef enum { ENTITY_TROOP, ENTITY_BUILDING, ENTITY_PROJECTILE } EntityType;
 
@@ -166,23 +164,61 @@ typedef struct {
     Texture2D birdBombTexture;
 } ProjectileAssets;
 
+// Slot array sized to the live entity cap by projectile_system_init().
 typedef struct {
-    Projectile projectiles[PROJECTILE_CAPACITY];
+    Projectile *projectiles;
+    int capacity;
 } ProjectileSystem;
 
+// Cold per-entity payloads: read only by the owning entity's own attack
+// release or by base systems, never by registry-wide scans. Stored in a
+// pool-slot side table (entity_pool.c) so they stay out of Entity.
+typedef struct {
+    // Projectile presentation tuning (ranged attackers)
+    float projectileSpeed;
+    float projectileHitRadius;
+    float projectileSplashRadius;
+    float projectileRenderScale;
+    Vector2 projectileLaunchOffset;
+
+    // Base-only payloads. Non-base entities leave these zero-initialized.
+    DepositSlotRing depositSlots;
+    int  baseLevel;                    // 1..PROGRESSION_MAX_LEVEL; 0 for non-bases
+    bool basePendingKingBurst;         // true while a queued King swing awaits hit-marker
+    int  basePendingKingBurstDamage;   // damage to apply at the swing's hit frame
+} EntityCold;
+
 // Entity definition
+//
+// Field order is deliberate. The leading hot block holds everything the
+// registry-wide scans (combat target search, burst damage, steering
+// candidate evaluation) read about *other* entities, and fits one cache
+// line, so a scan touches 64 bytes per entity instead of the whole struct.
+// Keep new scan-read fields inside it (entity_pool.c asserts its size).
 struct Entity {
-    int id;
+    // --- Hot: read by registry-wide scans ---
+    _Alignas(64) int id;
     EntityType type;
-    Faction faction;
-    EntityState state;
-
-    // Transform
+    int ownerID; // Player index (0 or 1)
     Vector2 position;
+    int hp, maxHP;
+    float bodyRadius;           // collision/footprint radius in canonical world units
+    float navRadius;            // pathfinding footprint; 0 => fall back to bodyRadius
+    UnitNavProfile navProfile;  // steering algorithm selector (LANE / ASSAULT / FREE_GOAL / STATIC)
+    UnitRole unitRole;
+    CombatProfileId combatProfileId;
+    ProjectileVisualType projectileVisualType;
+    int movementTargetId;       // local aggro pursuit target, -1 when none
     float moveSpeed;
+    bool alive;
+    bool markedForRemoval;
+
+    // --- Warm: read by the entity's own update ---
+    Faction faction;
+    EntityState state;
+    Vector2 prevPosition;   // position at the start of the current sim tick (render interpolation)
 
     // Stats
-    int hp, maxHP;
     int attack;
     int bonusDamageVsFarmers;  // bonus hostile damage applied only when the target is a farmer-role unit
     float attackSpeed;
@@ -194,65 +230,47 @@ struct Entity {
     int reservedProjectileSlotIndex; // offensive projectile slot reserved before release, -1 when none
     TargetingMode targeting;    // targeting preference
     const char *targetType;     // for TARGET_SPECIFIC_TYPE (owned, freed in entity_destroy)
-    CombatProfileId combatProfileId;
     AttackEngagementMode engagementMode;
     AttackDeliveryMode deliveryMode;
-    ProjectileVisualType projectileVisualType;
-    float projectileSpeed;
-    float projectileHitRadius;
-    float projectileSplashRadius;
-    float projectileRenderScale;
-    Vector2 projectileLaunchOffset;
-
-    // Animation
-    AnimState anim;
-    const CharacterSprite *sprite;
-    SpriteType spriteType;
-    float spriteScale;
-    float spriteRotationDegrees;
-    BattleSide presentationSide;
-    EntityRenderLayer renderLayer;
 
-    // Ownership
-    int ownerID; // Player index (0 or 1)
+    // Lane
     int lane; // Which lane (0-2)
     int waypointIndex; // Derived: first authored waypoint still ahead along the lane path
     float laneProgress; // Monotonic distance traveled along the authored lane polyline
 
-    // Debug
-    float hitFlashTimer;        // countdown for hit-marker visual flash (debug overlay)
-
-    // Unit role (farmer vs combat)
-    UnitRole unitRole;
+    // Farmer
     FarmerState farmerState;
     int claimedSustenanceNodeId;       // sustenance node ID this farmer is targeting, -1 if none
     int carriedSustenanceValue;        // sustenance value being carried back to base
     float workTimer;            // elapsed time in current work cycle (gathering/depositing)
 
-    // Flags
-    bool alive;
-    bool markedForRemoval;
-
     // Support stats
     int healAmount;             // > 0 marks this unit as a supporter; HP restored per hit on a friendly troop
 
     // Local steering
-    float bodyRadius;           // collision/footprint radius in canonical world units
-    float navRadius;            // pathfinding footprint; 0 => fall back to bodyRadius
-    UnitNavProfile navProfile;  // steering algorithm selector (LANE / ASSAULT / FREE_GOAL / STATIC)
-    int movementTargetId;       // local aggro pursuit target, -1 when none
     int ticksSinceProgress;     // ticks since the last forward step toward the current goal
     int lastSteerSideSign;      // continuity bias for scored sidestep selection (-1/0/+1)
+    Vector2 navVelocity;        // displacement / dt of the last step; read by ORCA neighbors
 
     // Deposit slot reservation (farmers only)
     int             reservedDepositSlotIndex;  // -1 when no reservation held
     DepositSlotKind reservedDepositSlotKind;   // DEPOSIT_SLOT_NONE when unclaimed
 
-    // Base-only payloads. Non-base entities leave these zero-initialized.
-    DepositSlotRing depositSlots;
-    int  baseLevel;                    // 1..PROGRESSION_MAX_LEVEL; 0 for non-bases
-    bool basePendingKingBurst;         // true while a queued King swing awaits hit-marker
-    int  basePendingKingBurstDamage;   // damage to apply at the swing's hit frame
+    // Debug
+    float hitFlashTimer;        // countdown for hit-marker visual flash (debug overlay)
+
+    // Animation / presentation
+    AnimState anim;
+    const CharacterSprite *sprite;
+    SpriteType spriteType;
+    float spriteScale;
+    float spriteRotationDegrees;
+    BattleSide presentationSide;
+    EntityRenderLayer renderLayer;
+
+    // Cold payloads in the pool side table. Always non-NULL for pool
+    // entities; copies of an Entity share their source's table entry.
+    EntityCold *cold;
 };
 
 // Card slot - represents a physical NFC reader position
@@ -357,6 +375,39 @@ struct GameState {
     NavFrame nav;
     float lastFrameDeltaTime;
 
+    // Fixed-step simulation clock (see game_update). Frame time accumulates
+    // in simAccumulator and is consumed in simTickSeconds steps.
+    float simTickSeconds;
+    float simAccumulator;
+    int simMaxCatchUpSteps;
+    // Fraction of a tick left in the accumulator after the last step, in
+    // [0,1]. Draw code lerps prevPosition -> position (and projectile
+    // prevPos -> currentPos) by this amount.
+    float renderAlpha;
+
+    // Live entity cap for the next game_sim_init_world (both sides). Sizes
+    // the entity pool, registry, nav caches and projectile slots; 0 means
+    // ENTITY_CAPACITY_DEFAULT.
+    int entityCapacity;
+
+    // Nav field build budget per tick in microseconds for the next
+    // game_sim_init_world (0 is no budget). Only applied once
+    // navBudgetUsSet; until then matches use NAV_FRAME_BUDGET_US.
+    int navBudgetUs;
+    bool navBudgetUsSet;
+
+    // Query-bounded nav target / free-goal builds for the next
+    // game_sim_init_world. Only applied once navQueryBoundedSet; until then
+    // matches use NAV_QUERY_BOUNDED.
+    bool navQueryBounded;
+    bool navQueryBoundedSet;
+
+    // UnitNavProfile bits steered by ORCA for the next game_sim_init_world
+    // (0 is the fan for every profile). Only applied once orcaProfilesSet;
+    // until then matches use PATHFIND_ORCA_PROFILES.
+    uint32_t orcaProfiles;
+    bool orcaProfilesSet;
+
     // Character sprites (shared by all entities)
     SpriteAtlas spriteAtlas;
     SpawnFxSystem spawnFx;
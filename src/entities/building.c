@@ -57,9 +57,9 @@ Entity *building_create_base(Player *owner, Vector2 position, const SpriteAtlas
     // presentationSide are finalized.
     deposit_slots_build_for_base(e);
 
-    e->baseLevel = 1;
-    e->basePendingKingBurst = false;
-    e->basePendingKingBurstDamage = 0;
+    e->cold->baseLevel = 1;
+    e->cold->basePendingKingBurst = false;
+    e->cold->basePendingKingBurstDamage = 0;
 
     printf("[BASE] Spawned base (id=%d) for player %d at (%.0f, %.0f)\n",
            e->id, owner->id, position.x, position.y);
@@ -4,6 +4,7 @@
 
 #include "entities.h"
 #include "entity_animation.h"
+#include "entity_pool.h"
 #include "projectile.h"
 #include "../core/battlefield.h"
 #include "../core/config.h"
@@ -17,11 +18,6 @@
 #include <string.h>
 #include <stdio.h>
 
-// TODO: s_nextEntityID is a static global that grows monotonically and never rolls over.
-// TODO: At 60fps with many spawns this is practically fine, but it will overflow int after ~2 billion
-// TODO: entities. Consider resetting between matches or using a uint32_t with explicit wrap handling.
-static int s_nextEntityID = 1;
-
 // Orient entity's animation facing toward a target position.
 static void entity_face_toward(Entity *e, const Battlefield *bf, Vector2 targetPos) {
     pathfind_commit_presentation(e, bf);
@@ -97,6 +93,12 @@ static Entity *entity_validate_enemy_pursuit(Entity *e, const Entity *candidate,
     if (!combat_can_damage_target(e, candidate)) return NULL;
     if (maxRadius < 0.0f) return NULL;
 
+    // Cheap radius reject before the lane projections below, which dominate
+    // pursuit scans at horde scale.
+    float dx = candidate->position.x - e->position.x;
+    float dy = candidate->position.y - e->position.y;
+    if (dx * dx + dy * dy > maxRadius * maxRadius) return NULL;
+
     if (e->lane >= 0 && e->lane < 3) {
         pathfind_sync_lane_progress(e, bf);
         float targetProgress = pathfind_lane_progress_for_position(e, bf, candidate->position);
@@ -104,10 +106,6 @@ static Entity *entity_validate_enemy_pursuit(Entity *e, const Entity *candidate,
             return NULL;
         }
     }
-
-    float dx = candidate->position.x - e->position.x;
-    float dy = candidate->position.y - e->position.y;
-    if (dx * dx + dy * dy > maxRadius * maxRadius) return NULL;
     return (Entity *)candidate;
 }
 
@@ -138,8 +136,15 @@ static Entity *entity_find_forward_pursuit_target(Entity *e, GameState *gs, floa
     Entity *bestTarget = NULL;
     float bestDistSq = INFINITY;
 
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *candidate = entity_validate_enemy_pursuit(e, bf->entities[i], bf, maxRadius);
+    // Grid candidates come back in registry order, so ties resolve exactly
+    // as the full registry walk did.
+    SpatialFilter enemies = {
+        .ownerId = e->ownerID,
+        .owner = SPATIAL_OWNER_OTHER,
+    };
+    int count = spatial_grid_query_radius(&bf->spatial, e->position, maxRadius, &enemies);
+    for (int i = 0; i < count; i++) {
+        Entity *candidate = entity_validate_enemy_pursuit(e, bf->spatial.scratch[i], bf, maxRadius);
         if (!candidate) continue;
 
         float dx = candidate->position.x - e->position.x;
@@ -291,14 +296,14 @@ static Entity *entity_retarget_or_walk(Entity *e, GameState *gs) {
 }
 
 Entity *entity_create(EntityType type, Faction faction, Vector2 pos) {
-    Entity *e = malloc(sizeof(Entity));
+    // Pool hands back a zeroed slot with its generation-tagged id assigned.
+    Entity *e = entity_pool_acquire();
     if (!e) return NULL;
-    memset(e, 0, sizeof(Entity));
 
-    e->id = s_nextEntityID++;
     e->type = type;
     e->faction = faction;
     e->position = pos;
+    e->prevPosition = pos;
     e->state = ESTATE_IDLE;
     e->alive = true;
     e->markedForRemoval = false;
@@ -315,6 +320,7 @@ Entity *entity_create(EntityType type, Faction faction, Vector2 pos) {
     e->reservedDepositSlotIndex = -1;
     e->reservedDepositSlotKind = DEPOSIT_SLOT_NONE;
     e->lastSteerSideSign = 0;
+    e->navVelocity = (Vector2){ 0.0f, 0.0f };
     // TODO: spriteScale is hardcoded to 2.0f here; troop_spawn overrides it correctly, but other
     // TODO: entity types that don't override this may inadvertently inherit the wrong scale.
     e->spriteScale = 2.0f;
@@ -328,11 +334,11 @@ Entity *entity_create(EntityType type, Faction faction, Vector2 pos) {
     e->deliveryMode = ATTACK_DELIVERY_INSTANT;
     e->bonusDamageVsFarmers = 0;
     e->projectileVisualType = PROJECTILE_VISUAL_NONE;
-    e->projectileSpeed = 0.0f;
-    e->projectileHitRadius = 0.0f;
-    e->projectileSplashRadius = 0.0f;
-    e->projectileRenderScale = 1.0f;
-    e->projectileLaunchOffset = (Vector2){ 0.0f, 0.0f };
+    e->cold->projectileSpeed = 0.0f;
+    e->cold->projectileHitRadius = 0.0f;
+    e->cold->projectileSplashRadius = 0.0f;
+    e->cold->projectileRenderScale = 1.0f;
+    e->cold->projectileLaunchOffset = (Vector2){ 0.0f, 0.0f };
 
     // Default to combat role; farmer overrides in troop_spawn
     e->unitRole = UNIT_ROLE_COMBAT;
@@ -349,7 +355,8 @@ Entity *entity_create(EntityType type, Faction faction, Vector2 pos) {
 void entity_destroy(Entity *e) {
     if (!e) return;
     free((char *)e->targetType);
-    free(e);
+    e->targetType = NULL;
+    entity_pool_release(e);
 }
 
 static AnimationType entity_anim_type_for_state(EntityState state) {
@@ -364,7 +371,7 @@ static AnimationType entity_anim_type_for_state(EntityState state) {
 }
 
 static unsigned int entity_anim_seed(const Entity *e, AnimationType animType) {
-    unsigned int seed = (unsigned int) (e ? (e->id + 1) : 1) * 0x9e3779b9u;
+    unsigned int seed = (unsigned int) (e ? (entity_id_serial(e->id) + 1) : 1) * 0x9e3779b9u;
     seed ^= (unsigned int) ((e ? e->spriteType : 0) + 1) * 0x85ebca6bu;
     seed ^= (unsigned int) ((e ? e->ownerID : 0) + 1) * 0xc2b2ae35u;
     seed ^= (unsigned int) (animType + 1) * 0x27d4eb2du;
@@ -391,6 +398,12 @@ static void entity_note_attack_progress(Entity *e, const AnimPlaybackEvent *evt)
     }
 }
 
+bool entity_is_airborne(const Entity *e) {
+    if (!e) return false;
+    return e->combatProfileId == COMBAT_PROFILE_BIRD ||
+           e->projectileVisualType == PROJECTILE_VISUAL_BIRD_BOMB;
+}
+
 void entity_sync_animation(Entity *e) {
     if (!e) return;
 
@@ -540,16 +553,16 @@ void entity_update(Entity *e, GameState *gs, float deltaTime) {
                 if (spec->hitNormalized >= 0.0f &&
                     evt.prevNormalized < spec->hitNormalized &&
                     evt.currNormalized >= spec->hitNormalized &&
-                    e->basePendingKingBurst) {
+                    e->cold->basePendingKingBurst) {
                     combat_apply_king_burst(e, PROGRESSION_KING_BURST_RADIUS,
-                                            e->basePendingKingBurstDamage, gs);
-                    e->basePendingKingBurst = false;
-                    e->basePendingKingBurstDamage = 0;
+                                            e->cold->basePendingKingBurstDamage, gs);
+                    e->cold->basePendingKingBurst = false;
+                    e->cold->basePendingKingBurstDamage = 0;
                 }
 
                 if (evt.finishedThisTick) {
-                    e->basePendingKingBurst = false;
-                    e->basePendingKingBurstDamage = 0;
+                    e->cold->basePendingKingBurst = false;
+                    e->cold->basePendingKingBurstDamage = 0;
                     entity_set_state(e, ESTATE_IDLE);
                 }
                 return;
@@ -662,7 +675,16 @@ void entity_update(Entity *e, GameState *gs, float deltaTime) {
     }
 }
 
-void entity_draw(const Entity *e) {
+Vector2 entity_render_position(const Entity *e, float alpha) {
+    if (!e) return (Vector2){ 0.0f, 0.0f };
+    return (Vector2){
+        e->prevPosition.x + (e->position.x - e->prevPosition.x) * alpha,
+        e->prevPosition.y + (e->position.y - e->prevPosition.y) * alpha,
+    };
+}
+
+void entity_draw(const Entity *e, float alpha) {
     if (!e || e->markedForRemoval || !e->sprite) return;
-    sprite_draw(e->sprite, &e->anim, e->position, e->spriteScale, e->spriteRotationDegrees);
+    sprite_draw(e->sprite, &e->anim, entity_render_position(e, alpha),
+                e->spriteScale, e->spriteRotationDegrees);
 }
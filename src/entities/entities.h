@@ -15,7 +15,15 @@ void entity_destroy(Entity * e);
 // Per-frame
 void entity_update(Entity *e, GameState *gs, float deltaTime);
 
-void entity_draw(const Entity *e);
+// Draw at the render-interpolated position (alpha in [0,1] between the
+// previous and current sim tick; see GameState.renderAlpha).
+void entity_draw(const Entity *e, float alpha);
+
+Vector2 entity_render_position(const Entity *e, float alpha);
+
+// Fliers (bird troops and their bomb visuals). Only anti-air attackers can
+// target them; see combat_can_damage_target().
+bool entity_is_airborne(const Entity *e);
 
 // State transitions
 void entity_set_state(Entity *e, EntityState newState);
@@ -0,0 +1,137 @@
+//
+// Fixed-capacity entity storage with generation-tagged ids.
+//
+
+#include "entity_pool.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Entity's hot block (see types.h) must stay within the first cache line.
+_Static_assert(offsetof(Entity, markedForRemoval) < 64,
+               "Entity hot block no longer fits one cache line");
+_Static_assert(sizeof(Entity) % 64 == 0,
+               "Entity size must keep pool slots cache-line aligned");
+
+// Storage is allocated once per match by entity_pool_init() and never grows
+// mid-match, so Entity pointers stay stable for the whole match.
+static Entity *s_pool;
+// Cold side table, indexed by the same slot as s_pool.
+static EntityCold *s_cold;
+static bool *s_slotLive;
+// LIFO free list of slot indices; a freshly released slot is reused first
+// so the working set stays in the low, already-warm part of the pool.
+static int *s_freeSlots;
+static int s_capacity;
+static int s_freeCount;
+static int s_nextSerial = 1;
+
+static void entity_pool_build_free_list(void) {
+    // Push in reverse so slot 0 is handed out first.
+    s_freeCount = 0;
+    for (int slot = s_capacity - 1; slot >= 0; slot--) {
+        if (!s_slotLive[slot]) s_freeSlots[s_freeCount++] = slot;
+    }
+}
+
+static void entity_pool_free_storage(void) {
+    free(s_pool);
+    free(s_cold);
+    free(s_slotLive);
+    free(s_freeSlots);
+    s_pool = NULL;
+    s_cold = NULL;
+    s_slotLive = NULL;
+    s_freeSlots = NULL;
+    s_capacity = 0;
+    s_freeCount = 0;
+}
+
+bool entity_pool_init(int capacity) {
+    if (entity_pool_live_count() != 0) {
+        fprintf(stderr, "[EntityPool] Init with %d live entities ignored\n",
+                entity_pool_live_count());
+        return false;
+    }
+    if (capacity < 1) capacity = 1;
+    if (capacity > ENTITY_CAPACITY_MAX) capacity = ENTITY_CAPACITY_MAX;
+
+    if (capacity != s_capacity) {
+        entity_pool_free_storage();
+        // aligned_alloc keeps every slot's hot block on its own cache line.
+        s_pool = aligned_alloc(64, (size_t)capacity * sizeof(Entity));
+        s_cold = calloc((size_t)capacity, sizeof(EntityCold));
+        s_slotLive = calloc((size_t)capacity, sizeof(bool));
+        s_freeSlots = malloc((size_t)capacity * sizeof(int));
+        if (!s_pool || !s_cold || !s_slotLive || !s_freeSlots) {
+            fprintf(stderr, "[EntityPool] Out of memory for %d entities\n", capacity);
+            entity_pool_free_storage();
+            return false;
+        }
+        s_capacity = capacity;
+    }
+
+    s_nextSerial = 1;
+    entity_pool_build_free_list();
+    return true;
+}
+
+void entity_pool_shutdown(void) {
+    if (entity_pool_live_count() != 0) {
+        fprintf(stderr, "[EntityPool] Shutdown with %d live entities\n",
+                entity_pool_live_count());
+    }
+    entity_pool_free_storage();
+}
+
+int entity_pool_capacity(void) {
+    return s_capacity;
+}
+
+Entity *entity_pool_acquire(void) {
+    if (s_freeCount == 0) {
+        fprintf(stderr, "[EntityPool] Pool exhausted (%d live)\n", s_capacity);
+        return NULL;
+    }
+    if (s_nextSerial > (0x7fffffff >> ENTITY_ID_SLOT_BITS)) {
+        fprintf(stderr, "[EntityPool] Spawn serial exhausted; reset between matches\n");
+        return NULL;
+    }
+
+    int slot = s_freeSlots[--s_freeCount];
+    Entity *e = &s_pool[slot];
+    memset(e, 0, sizeof(*e));
+    memset(&s_cold[slot], 0, sizeof(s_cold[slot]));
+    e->id = (s_nextSerial++ << ENTITY_ID_SLOT_BITS) | slot;
+    e->cold = &s_cold[slot];
+    s_slotLive[slot] = true;
+    return e;
+}
+
+void entity_pool_release(Entity *e) {
+    if (!e || !s_pool) return;
+    ptrdiff_t slot = e - s_pool;
+    if (slot < 0 || slot >= s_capacity || !s_slotLive[slot]) {
+        fprintf(stderr, "[EntityPool] Release of non-pool or free entity %p\n", (void *)e);
+        return;
+    }
+
+    s_slotLive[slot] = false;
+    // Poison the id so any dangling pointer compares unequal to every live id.
+    e->id = -1;
+    s_freeSlots[s_freeCount++] = (int)slot;
+}
+
+Entity *entity_pool_resolve(int id) {
+    if (id < 0) return NULL;
+    int slot = entity_id_slot(id);
+    if (slot >= s_capacity || !s_slotLive[slot]) return NULL;
+
+    Entity *e = &s_pool[slot];
+    return (e->id == id) ? e : NULL;
+}
+
+int entity_pool_live_count(void) {
+    return s_capacity - s_freeCount;
+}
@@ -0,0 +1,55 @@
+//
+// Fixed-capacity entity storage with generation-tagged ids.
+//
+// Capacity is chosen per match (entity_pool_init) and fixed for its
+// duration. Every Entity lives in one contiguous pool slot. Its id packs
+// a per-match spawn serial above the slot index:
+//
+//     id = (serial << ENTITY_ID_SLOT_BITS) | slot
+//
+// Serials only grow, so ids still sort in spawn order (the update-order and
+// jam tie-break rules depend on that), and the slot bits resolve an id in
+// O(1). A stale id fails the lookup because the slot's current occupant
+// carries a different serial, i.e. the serial doubles as the generation.
+//
+
+#ifndef NFC_CARDGAME_ENTITY_POOL_H
+#define NFC_CARDGAME_ENTITY_POOL_H
+
+#include "../core/types.h"
+
+// Spawn serial of an id: the legacy monotonic counter (1, 2, 3, ...).
+// Use this wherever gameplay derives parity or seeds from an entity's id.
+static inline int entity_id_serial(int id) {
+    return id >> ENTITY_ID_SLOT_BITS;
+}
+
+static inline int entity_id_slot(int id) {
+    return id & ((1 << ENTITY_ID_SLOT_BITS) - 1);
+}
+
+// Allocate storage for `capacity` entities (clamped to
+// [1, ENTITY_CAPACITY_MAX]) and restart spawn serials at 1 for a new match.
+// Reuses the existing storage when the capacity is unchanged. Only valid
+// while no entities are live. Returns false on allocation failure.
+bool entity_pool_init(int capacity);
+
+// Release pool storage. Every entity must have been released first.
+void entity_pool_shutdown(void);
+
+int entity_pool_capacity(void);
+
+// Hand out a zeroed slot with its id assigned and e->cold pointing at a
+// zeroed side-table entry, or NULL when the pool is full.
+Entity *entity_pool_acquire(void);
+
+// Return an entity's slot to the free list. The pointer must not be used
+// afterwards; its id stops resolving immediately.
+void entity_pool_release(Entity *e);
+
+// O(1) id -> entity. NULL for negative, stale, or released ids.
+Entity *entity_pool_resolve(int id);
+
+int entity_pool_live_count(void);
+
+#endif //NFC_CARDGAME_ENTITY_POOL_H
@@ -9,6 +9,7 @@
 #include "../rendering/sprite_renderer.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 enum {
@@ -106,7 +107,7 @@ static Vector2 projectile_rotate(Vector2 v, float rotationDegrees) {
 static Vector2 projectile_launch_origin(const Entity *attacker) {
     if (!attacker) return (Vector2){ 0.0f, 0.0f };
 
-    Vector2 local = attacker->projectileLaunchOffset;
+    Vector2 local = attacker->cold->projectileLaunchOffset;
     if (attacker->anim.flipH) {
         local.x = -local.x;
     }
@@ -127,7 +128,7 @@ static bool projectile_slot_in_use(const Projectile *projectile) {
 
 static Projectile *projectile_slot_at(ProjectileSystem *system, int slotIndex) {
     if (!system) return NULL;
-    if (slotIndex < 0 || slotIndex >= PROJECTILE_CAPACITY) return NULL;
+    if (slotIndex < 0 || slotIndex >= system->capacity) return NULL;
     return &system->projectiles[slotIndex];
 }
 
@@ -147,11 +148,11 @@ static bool projectile_fill_attack(Projectile *projectile, const Entity *attacke
         .prevPos = startPos,
         .currentPos = startPos,
         .snapshotTargetPos = target->position,
-        .speed = attacker->projectileSpeed,
-        .hitRadius = attacker->projectileHitRadius,
-        .splashRadius = attacker->projectileSplashRadius,
+        .speed = attacker->cold->projectileSpeed,
+        .hitRadius = attacker->cold->projectileHitRadius,
+        .splashRadius = attacker->cold->projectileSplashRadius,
         .visualType = attacker->projectileVisualType,
-        .renderScale = attacker->projectileRenderScale,
+        .renderScale = attacker->cold->projectileRenderScale,
         .animElapsed = 0.0f,
     };
     return true;
@@ -299,16 +300,36 @@ void projectile_assets_cleanup(ProjectileAssets *assets) {
     memset(assets, 0, sizeof(*assets));
 }
 
-void projectile_system_init(ProjectileSystem *system) {
+void projectile_system_init(ProjectileSystem *system, int capacity) {
     if (!system) return;
-    memset(system, 0, sizeof(*system));
+    if (capacity < 1) capacity = 1;
+
+    if (system->projectiles && system->capacity == capacity) {
+        memset(system->projectiles, 0, (size_t)capacity * sizeof(Projectile));
+        return;
+    }
+
+    projectile_system_cleanup(system);
+    system->projectiles = calloc((size_t)capacity, sizeof(Projectile));
+    if (!system->projectiles) {
+        fprintf(stderr, "[Projectile] Out of memory for %d slots\n", capacity);
+        return;
+    }
+    system->capacity = capacity;
+}
+
+void projectile_system_cleanup(ProjectileSystem *system) {
+    if (!system) return;
+    free(system->projectiles);
+    system->projectiles = NULL;
+    system->capacity = 0;
 }
 
 int projectile_reserve_slot(GameState *gs) {
     if (!gs) return -1;
 
     ProjectileSystem *system = &gs->projectileSystem;
-    for (int i = 0; i < PROJECTILE_CAPACITY; i++) {
+    for (int i = 0; i < system->capacity; i++) {
         Projectile *projectile = &system->projectiles[i];
         if (projectile_slot_in_use(projectile)) continue;
 
@@ -371,7 +392,7 @@ bool projectile_spawn_for_attack(GameState *gs, const Entity *attacker,
 void projectile_system_update(GameState *gs, float dt) {
     if (!gs || gs->gameOver) return;
 
-    for (int i = 0; i < PROJECTILE_CAPACITY; i++) {
+    for (int i = 0; i < gs->projectileSystem.capacity; i++) {
         Projectile *projectile = &gs->projectileSystem.projectiles[i];
         if (!projectile->active) continue;
 
@@ -427,10 +448,10 @@ void projectile_system_update(GameState *gs, float dt) {
     }
 }
 
-void projectile_system_draw(const GameState *gs) {
+void projectile_system_draw(const GameState *gs, float alpha) {
     if (!gs) return;
 
-    for (int i = 0; i < PROJECTILE_CAPACITY; i++) {
+    for (int i = 0; i < gs->projectileSystem.capacity; i++) {
         const Projectile *projectile = &gs->projectileSystem.projectiles[i];
         const ProjectileVisualDef *visual = projectile_visual_def(gs, projectile->visualType);
         if (!projectile->active) continue;
@@ -452,8 +473,8 @@ void projectile_system_draw(const GameState *gs) {
         float drawWidth = (float)visual->frameWidth * projectile->renderScale;
         float drawHeight = (float)visual->frameHeight * projectile->renderScale;
         Rectangle dst = {
-            projectile->currentPos.x,
-            projectile->currentPos.y,
+            projectile->prevPos.x + (projectile->currentPos.x - projectile->prevPos.x) * alpha,
+            projectile->prevPos.y + (projectile->currentPos.y - projectile->prevPos.y) * alpha,
             drawWidth,
             drawHeight
         };
@@ -10,9 +10,12 @@
 void projectile_assets_init(ProjectileAssets *assets);
 void projectile_assets_cleanup(ProjectileAssets *assets);
 
-void projectile_system_init(ProjectileSystem *system);
+// Size the slot array for `capacity` in-flight projectiles (the live entity
+// cap) and clear every slot. Reuses the allocation when capacity is unchanged.
+void projectile_system_init(ProjectileSystem *system, int capacity);
+void projectile_system_cleanup(ProjectileSystem *system);
 void projectile_system_update(GameState *gs, float dt);
-void projectile_system_draw(const GameState *gs);
+void projectile_system_draw(const GameState *gs, float alpha);
 
 int projectile_reserve_slot(GameState *gs);
 void projectile_release_slot(GameState *gs, int slotIndex);
@@ -220,11 +220,11 @@ Entity *troop_spawn(Player *owner, const TroopData *data, Vector2 position,
     e->engagementMode = data->engagementMode;
     e->deliveryMode = data->deliveryMode;
     e->projectileVisualType = data->projectileVisualType;
-    e->projectileSpeed = data->projectileSpeed;
-    e->projectileHitRadius = data->projectileHitRadius;
-    e->projectileSplashRadius = data->projectileSplashRadius;
-    e->projectileRenderScale = data->projectileRenderScale;
-    e->projectileLaunchOffset = data->projectileLaunchOffset;
+    e->cold->projectileSpeed = data->projectileSpeed;
+    e->cold->projectileHitRadius = data->projectileHitRadius;
+    e->cold->projectileSplashRadius = data->projectileSplashRadius;
+    e->cold->projectileRenderScale = data->projectileRenderScale;
+    e->cold->projectileLaunchOffset = data->projectileLaunchOffset;
     e->bodyRadius = (data->bodyRadius > 0.0f)
         ? data->bodyRadius
         : troop_default_body_radius(data->spriteType);
@@ -259,11 +259,11 @@ Entity *troop_spawn(Player *owner, const TroopData *data, Vector2 position,
         e->engagementMode = ATTACK_ENGAGEMENT_CONTACT;
         e->deliveryMode = ATTACK_DELIVERY_INSTANT;
         e->projectileVisualType = PROJECTILE_VISUAL_NONE;
-        e->projectileSpeed = 0.0f;
-        e->projectileHitRadius = 0.0f;
-        e->projectileSplashRadius = 0.0f;
-        e->projectileRenderScale = 1.0f;
-        e->projectileLaunchOffset = (Vector2){ 0.0f, 0.0f };
+        e->cold->projectileSpeed = 0.0f;
+        e->cold->projectileHitRadius = 0.0f;
+        e->cold->projectileSplashRadius = 0.0f;
+        e->cold->projectileRenderScale = 1.0f;
+        e->cold->projectileLaunchOffset = (Vector2){ 0.0f, 0.0f };
         e->renderLayer = ENTITY_RENDER_LAYER_GROUND;
         e->farmerState = FARMER_SEEKING;
         e->claimedSustenanceNodeId = -1;
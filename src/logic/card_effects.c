@@ -220,9 +220,9 @@ static void play_king(const Card *card, GameState *state, int playerIndex, int s
 
     if (!card_try_pay_cost(player, card)) return;
 
-    int level = (base->baseLevel > 0) ? base->baseLevel : 1;
-    base->basePendingKingBurst = true;
-    base->basePendingKingBurstDamage =
+    int level = (base->cold->baseLevel > 0) ? base->cold->baseLevel : 1;
+    base->cold->basePendingKingBurst = true;
+    base->cold->basePendingKingBurstDamage =
         progression_king_burst_damage_for_level(level);
 
     if (base->state == ESTATE_ATTACKING) {
@@ -234,7 +234,7 @@ static void play_king(const Card *card, GameState *state, int playerIndex, int s
 
     player_hand_restart_animation_for_card(player, card);
     printf("[PLAY] king '%s' activated base burst for player %d (level %d, dmg %d, paid %d %s)\n",
-           card->name, playerIndex, level, base->basePendingKingBurstDamage,
+           card->name, playerIndex, level, base->cold->basePendingKingBurstDamage,
            card->cost, card_cost_label(card));
 }
 
@@ -46,9 +46,7 @@ bool combat_enemy_target_is_better(const Entity *attacker,
                                    const Entity *bestTarget, float bestDist);
 
 static bool combat_target_is_airborne(const Entity *target) {
-    if (!target) return false;
-    return target->combatProfileId == COMBAT_PROFILE_BIRD ||
-           target->projectileVisualType == PROJECTILE_VISUAL_BIRD_BOMB;
+    return entity_is_airborne(target);
 }
 
 static bool combat_attacker_can_hit_air(const Entity *attacker) {
@@ -90,6 +88,9 @@ static int combat_enemy_target_category(const Entity *attacker, const Entity *ca
     return 0;
 }
 
+// Highest value combat_enemy_target_category() returns for a valid target.
+#define COMBAT_TARGET_CATEGORY_MAX 2
+
 static bool combat_enemy_target_prefers_low_health(const Entity *attacker,
                                                    int category) {
     return combat_target_mode_is(attacker, "farmer_first_lowest_hp") &&
@@ -99,13 +100,8 @@ static bool combat_enemy_target_prefers_low_health(const Entity *attacker,
 static Entity *combat_find_source_entity(GameState *gs, int sourceEntityId) {
     if (!gs || sourceEntityId < 0) return NULL;
 
-    Battlefield *bf = &gs->battlefield;
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *source = bf->entities[i];
-        if (source && source->id == sourceEntityId) {
-            return source;
-        }
-    }
+    Entity *source = bf_find_entity(&gs->battlefield, sourceEntityId);
+    if (source) return source;
 
     for (int i = 0; i < 2; i++) {
         Entity *base = gs->players[i].base;
@@ -343,14 +339,22 @@ bool combat_can_heal_target(const Entity *attacker, const Entity *target) {
 // units via combat_can_heal_target() / combat_can_damage_target().
 // Returns NULL if no eligible ally exists; the caller then falls back to enemy targeting.
 static Entity *combat_find_heal_target(Entity *attacker, GameState *gs) {
-    Battlefield *bf = &gs->battlefield;
+    SpatialGrid *grid = &gs->battlefield.spatial;
     Entity *bestTarget = NULL;
     float bestDist = FLT_MAX;
     float bestRatio = FLT_MAX;
     CanonicalPos attackerPos = { attacker->position };
 
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *candidate = bf->entities[i];
+    // Grid candidates arrive in registry (id) order, so the epsilon ratio
+    // tie-break below resolves exactly as the old full-registry scan did.
+    SpatialFilter allies = {
+        .ownerId = attacker->ownerID,
+        .owner = SPATIAL_OWNER_SAME,
+    };
+    int count = spatial_grid_query_radius(grid, attacker->position,
+                                          attacker->attackRange, &allies);
+    for (int i = 0; i < count; i++) {
+        Entity *candidate = grid->scratch[i];
         if (!combat_can_heal_target(attacker, candidate)) continue;
 
         CanonicalPos candidatePos = { candidate->position };
@@ -368,19 +372,20 @@ static Entity *combat_find_heal_target(Entity *attacker, GameState *gs) {
     return bestTarget;
 }
 
-// Shared enemy-scan helper. Returns the nearest valid enemy within maxRadius
-// (center-to-center canonical distance), honoring the attacker's targeting
-// mode (nearest-valid, with TARGET_BUILDING priority). Pass FLT_MAX for an
-// unlimited search. Does NOT run the heal-first branch -- callers that need
-// heal-first semantics must run combat_find_heal_target themselves.
-static Entity *combat_find_enemy_within(Entity *attacker, GameState *gs, float maxRadius) {
-    Battlefield *bf = &gs->battlefield;
+// Enemy selection over a registry-ordered candidate list: the nearest valid
+// enemy within maxRadius (center-to-center canonical distance), honoring the
+// attacker's targeting mode. Ties fall to the earliest candidate, so any
+// id-sorted superset of the eligible enemies picks the same target as the
+// full registry.
+static Entity *combat_select_enemy(const Entity *attacker,
+                                   Entity *const *candidates, int count,
+                                   float maxRadius) {
     Entity *bestTarget = NULL;
     float bestDist = FLT_MAX;
     CanonicalPos attackerPos = { attacker->position };
 
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *candidate = bf->entities[i];
+    for (int i = 0; i < count; i++) {
+        Entity *candidate = candidates[i];
         if (!combat_can_damage_target(attacker, candidate)) continue;
 
         CanonicalPos candidatePos = { candidate->position };
@@ -396,6 +401,78 @@ static Entity *combat_find_enemy_within(Entity *attacker, GameState *gs, float m
     return bestTarget;
 }
 
+static SpatialFilter combat_enemy_filter(const Entity *attacker) {
+    SpatialFilter filter = {
+        .ownerId = attacker->ownerID,
+        .owner = SPATIAL_OWNER_OTHER,
+        .air = combat_attacker_can_hit_air(attacker) ? SPATIAL_AIR_ANY
+                                                     : SPATIAL_AIR_EXCLUDE,
+    };
+    return filter;
+}
+
+typedef struct {
+    const Entity *attacker;
+    int category;
+} CombatCategoryQuery;
+
+static bool combat_accept_enemy_in_category(const Entity *candidate, const void *ctx) {
+    const CombatCategoryQuery *query = ctx;
+    return combat_can_damage_target(query->attacker, candidate) &&
+           combat_enemy_target_category(query->attacker, candidate) == query->category;
+}
+
+// Unlimited-range selection. Category always outranks distance, so walk the
+// categories best-first: the first one with any eligible enemy holds the
+// winner. Within a distance-ranked category, the winner is no farther than
+// that category's nearest member, so only enemies inside that radius need
+// the full comparison. A health-ranked category has no such cutoff and
+// falls back to the registry scan.
+static Entity *combat_find_enemy_anywhere(Entity *attacker, GameState *gs) {
+    Battlefield *bf = &gs->battlefield;
+    SpatialFilter enemies = combat_enemy_filter(attacker);
+
+    for (int category = 0; category <= COMBAT_TARGET_CATEGORY_MAX; category++) {
+        if (combat_enemy_target_prefers_low_health(attacker, category)) {
+            return combat_select_enemy(attacker, bf->entities, bf->entityCount, FLT_MAX);
+        }
+
+        CombatCategoryQuery query = { attacker, category };
+        SpatialFilter inCategory = enemies;
+        inCategory.accept = combat_accept_enemy_in_category;
+        inCategory.ctx = &query;
+        if (combat_target_mode_is(attacker, "anti_air_first") && category == 0) {
+            inCategory.air = SPATIAL_AIR_ONLY;
+        }
+
+        Entity *nearest = NULL;
+        float nearestDist = 0.0f;
+        if (spatial_grid_query_nearest(&bf->spatial, attacker->position, 1,
+                                       &inCategory, &nearest, &nearestDist) == 0) {
+            continue;
+        }
+
+        int count = spatial_grid_query_radius(&bf->spatial, attacker->position,
+                                              nearestDist, &enemies);
+        return combat_select_enemy(attacker, bf->spatial.scratch, count, FLT_MAX);
+    }
+    return NULL;
+}
+
+// Shared enemy-scan helper. Returns the nearest valid enemy within maxRadius
+// (center-to-center canonical distance), honoring the attacker's targeting
+// mode (nearest-valid, with TARGET_BUILDING priority). Pass FLT_MAX for an
+// unlimited search. Does NOT run the heal-first branch -- callers that need
+// heal-first semantics must run combat_find_heal_target themselves.
+static Entity *combat_find_enemy_within(Entity *attacker, GameState *gs, float maxRadius) {
+    if (maxRadius >= FLT_MAX) return combat_find_enemy_anywhere(attacker, gs);
+
+    SpatialGrid *grid = &gs->battlefield.spatial;
+    SpatialFilter enemies = combat_enemy_filter(attacker);
+    int count = spatial_grid_query_radius(grid, attacker->position, maxRadius, &enemies);
+    return combat_select_enemy(attacker, grid->scratch, count, maxRadius);
+}
+
 Entity *combat_find_target(Entity *attacker, GameState *gs) {
     if (!attacker || !gs) return NULL;
 
@@ -652,11 +729,23 @@ static void combat_apply_enemy_burst_with_air_policy(Vector2 center, float radiu
                                                      int sourceOwnerId,
                                                      bool sourceCanHitAir,
                                                      GameState *gs) {
-    Battlefield *bf = &gs->battlefield;
+    SpatialGrid *grid = &gs->battlefield.spatial;
     CanonicalPos burstPos = { center };
 
-    for (int i = 0; i < bf->entityCount; i++) {
-        Entity *target = bf->entities[i];
+    // Candidates come back in registry order -- ascending id, i.e. spawn
+    // order -- so damage and kill hooks fire in the same sequence as a full
+    // registry walk. The kill hooks
+    // (farmer_on_death, win latch) never query the grid, so the scratch
+    // buffer stays valid for the whole loop.
+    SpatialFilter enemies = {
+        .ownerId = sourceOwnerId,
+        .owner = SPATIAL_OWNER_OTHER,
+        .air = sourceCanHitAir ? SPATIAL_AIR_ANY : SPATIAL_AIR_EXCLUDE,
+    };
+    int count = spatial_grid_query_radius(grid, center, radius, &enemies);
+
+    for (int i = 0; i < count; i++) {
+        Entity *target = grid->scratch[i];
         if (!target) continue;
         if (!target->alive || target->markedForRemoval) continue;
         if (target->type == ENTITY_PROJECTILE) continue;
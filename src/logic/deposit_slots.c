@@ -50,7 +50,7 @@ static void deposit_slots_build_arc(DepositSlot *slots, int count,
 void deposit_slots_build_for_base(Entity *base) {
     if (!base) return;
 
-    DepositSlotRing *ring = &base->depositSlots;
+    DepositSlotRing *ring = &base->cold->depositSlots;
     Vector2 anchor = base_interaction_anchor(base);
 
     float navR = (base->navRadius > 0.0f) ? base->navRadius : base->bodyRadius;
@@ -108,7 +108,7 @@ static int deposit_slots_closest_free_index(const DepositSlot *slots, int count,
 DepositSlotKind deposit_slots_reserve_for(Entity *base, int entityId,
                                           Vector2 fromPos, int *outSlotIndex) {
     if (outSlotIndex) *outSlotIndex = -1;
-    if (!base || !base->depositSlots.initialized || !outSlotIndex) {
+    if (!base || !base->cold->depositSlots.initialized || !outSlotIndex) {
         return DEPOSIT_SLOT_NONE;
     }
 
@@ -116,7 +116,7 @@ DepositSlotKind deposit_slots_reserve_for(Entity *base, int entityId,
     // re-enters FARMER_RETURNING does not double-book slots.
     deposit_slots_release_for_entity(base, entityId);
 
-    DepositSlotRing *ring = &base->depositSlots;
+    DepositSlotRing *ring = &base->cold->depositSlots;
 
     int idx = deposit_slots_closest_free_index(
         ring->primary, BASE_DEPOSIT_PRIMARY_SLOT_COUNT, fromPos);
@@ -139,14 +139,14 @@ DepositSlotKind deposit_slots_reserve_for(Entity *base, int entityId,
 
 bool deposit_slots_try_promote(Entity *base, int entityId, int queueSlotIndex,
                                int *outPrimarySlotIndex) {
-    if (!base || !base->depositSlots.initialized || !outPrimarySlotIndex) {
+    if (!base || !base->cold->depositSlots.initialized || !outPrimarySlotIndex) {
         return false;
     }
     if (queueSlotIndex < 0 || queueSlotIndex >= BASE_DEPOSIT_QUEUE_SLOT_COUNT) {
         return false;
     }
 
-    DepositSlotRing *ring = &base->depositSlots;
+    DepositSlotRing *ring = &base->cold->depositSlots;
     if (ring->queue[queueSlotIndex].claimedByEntityId != entityId) {
         return false;
     }
@@ -166,9 +166,9 @@ bool deposit_slots_try_promote(Entity *base, int entityId, int queueSlotIndex,
 
 void deposit_slots_release(Entity *base, DepositSlotKind kind, int slotIndex,
                            int entityId) {
-    if (!base || !base->depositSlots.initialized) return;
+    if (!base || !base->cold->depositSlots.initialized) return;
 
-    DepositSlotRing *ring = &base->depositSlots;
+    DepositSlotRing *ring = &base->cold->depositSlots;
 
     if (kind == DEPOSIT_SLOT_PRIMARY &&
         slotIndex >= 0 && slotIndex < BASE_DEPOSIT_PRIMARY_SLOT_COUNT) {
@@ -186,9 +186,9 @@ void deposit_slots_release(Entity *base, DepositSlotKind kind, int slotIndex,
 }
 
 void deposit_slots_release_for_entity(Entity *base, int entityId) {
-    if (!base || !base->depositSlots.initialized) return;
+    if (!base || !base->cold->depositSlots.initialized) return;
 
-    DepositSlotRing *ring = &base->depositSlots;
+    DepositSlotRing *ring = &base->cold->depositSlots;
     for (int i = 0; i < BASE_DEPOSIT_PRIMARY_SLOT_COUNT; i++) {
         if (ring->primary[i].claimedByEntityId == entityId) {
             ring->primary[i].claimedByEntityId = -1;
@@ -204,9 +204,9 @@ void deposit_slots_release_for_entity(Entity *base, int entityId) {
 Vector2 deposit_slots_get_position(const Entity *base, DepositSlotKind kind,
                                    int slotIndex) {
     Vector2 zero = { 0.0f, 0.0f };
-    if (!base || !base->depositSlots.initialized) return zero;
+    if (!base || !base->cold->depositSlots.initialized) return zero;
 
-    const DepositSlotRing *ring = &base->depositSlots;
+    const DepositSlotRing *ring = &base->cold->depositSlots;
 
     if (kind == DEPOSIT_SLOT_PRIMARY &&
         slotIndex >= 0 && slotIndex < BASE_DEPOSIT_PRIMARY_SLOT_COUNT) {
@@ -233,12 +233,12 @@ const DepositSlot *deposit_slots_primary_at(const Entity *base, int slotIndex) {
     if (!base || slotIndex < 0 || slotIndex >= BASE_DEPOSIT_PRIMARY_SLOT_COUNT) {
         return NULL;
     }
-    return &base->depositSlots.primary[slotIndex];
+    return &base->cold->depositSlots.primary[slotIndex];
 }
 
 const DepositSlot *deposit_slots_queue_at(const Entity *base, int slotIndex) {
     if (!base || slotIndex < 0 || slotIndex >= BASE_DEPOSIT_QUEUE_SLOT_COUNT) {
         return NULL;
     }
-    return &base->depositSlots.queue[slotIndex];
+    return &base->cold->depositSlots.queue[slotIndex];
 }
@@ -13,7 +13,6 @@
 #include "../core/config.h"
 #include "../entities/entities.h"
 #include "../systems/player.h"
-#include <limits.h>
 #include <math.h>
 #include <stdio.h>
 
@@ -67,55 +66,23 @@ static void farmer_resolve_return_goal(const Entity *farmer, const Entity *base,
     }
 }
 
-static void farmer_build_sustenance_goal_request(const Entity *farmer,
-                                                 const GameState *gs,
-                                                 const SustenanceNode *node,
-                                                 NavFreeGoalRequest *outRequest) {
-    if (!farmer || !gs || !node || !outRequest) return;
-    (void)gs;
-
-    *outRequest = (NavFreeGoalRequest){
-        .goalX = node->worldPos.v.x,
-        .goalY = node->worldPos.v.y,
-        .stopRadius = FARMER_SUSTENANCE_INTERACT_RADIUS,
-        .perspectiveSide = (int16_t)bf_side_for_player(farmer->ownerID),
-        .carveTargetId = -1,
-        .carveCenterX = 0.0f,
-        .carveCenterY = 0.0f,
-        .carveInnerRadius = 0.0f,
-    };
-}
-
-static bool farmer_try_score_sustenance_node(const Entity *farmer,
-                                             GameState *gs,
-                                             const SustenanceNode *node,
-                                             int32_t *outCost) {
-    if (!farmer || !gs || !node || !outCost) return false;
-    if (!gs->nav.initialized) return false;
-
-    NavFreeGoalRequest request;
-    farmer_build_sustenance_goal_request(farmer, gs, node, &request);
-    const NavField *field = nav_get_or_build_free_goal_field(&gs->nav,
-                                                             &gs->battlefield,
-                                                             &request);
-    if (!field) return false;
-
-    int32_t cell = nav_cell_index_for_world(farmer->position.x, farmer->position.y);
-    int32_t cost = field->distance[cell];
-    if (cost == NAV_DIST_UNREACHABLE) return false;
-
-    *outCost = cost;
-    return true;
-}
+_Static_assert(SUSTENANCE_MATCH_COUNT_PER_SIDE <= NAV_HARVEST_MAX_SOURCES,
+               "every sustenance node of a side needs a harvest source bit");
 
+// Pick the free node with the cheapest nav cost from the farmer's cell, read
+// from the side's harvest field (one shared build for all seeking farmers
+// instead of one free-goal field per node). Cost ties go to the closest
+// node, then the lowest slot. Falls back to the closest free node when none
+// is reachable.
 static SustenanceNode *farmer_find_best_sustenance_node(Entity *farmer, GameState *gs) {
     if (!farmer || !gs) return NULL;
 
     Battlefield *bf = &gs->battlefield;
     BattleSide side = bf_side_for_player(farmer->ownerID);
-    SustenanceNode *bestReachable = NULL;
-    int32_t bestCost = INT_MAX;
-    float bestReachableDistSq = INFINITY;
+    SustenanceNode *sources[NAV_HARVEST_MAX_SOURCES];
+    float sourceDistSq[NAV_HARVEST_MAX_SOURCES];
+    NavHarvestRequest request = { 0 };
+    request.stopRadius = FARMER_SUSTENANCE_INTERACT_RADIUS;
     SustenanceNode *bestNearest = NULL;
     float bestNearestDistSq = INFINITY;
 
@@ -131,20 +98,29 @@ static SustenanceNode *farmer_find_best_sustenance_node(Entity *farmer, GameStat
             bestNearestDistSq = distSq;
         }
 
-        int32_t navCost = NAV_DIST_UNREACHABLE;
-        if (!farmer_try_score_sustenance_node(farmer, gs, node, &navCost)) {
-            continue;
-        }
+        int32_t k = request.sourceCount++;
+        sources[k] = node;
+        sourceDistSq[k] = distSq;
+        request.sourceX[k] = node->worldPos.v.x;
+        request.sourceY[k] = node->worldPos.v.y;
+    }
+    if (!bestNearest || !gs->nav.initialized) return bestNearest;
+
+    const NavHarvestField *harvest = nav_get_or_build_harvest_field(&gs->nav, side,
+                                                                    &request);
+    if (!harvest) return bestNearest;
+    int32_t cell = nav_cell_index_for_world(farmer->position.x, farmer->position.y);
+    if (harvest->field.distance[cell] == NAV_DIST_UNREACHABLE) return bestNearest;
 
-        if (!bestReachable ||
-            navCost < bestCost ||
-            (navCost == bestCost && distSq < bestReachableDistSq)) {
-            bestReachable = node;
-            bestCost = navCost;
-            bestReachableDistSq = distSq;
+    SustenanceNode *bestReachable = NULL;
+    float bestReachableDistSq = INFINITY;
+    for (int32_t k = 0; k < request.sourceCount; ++k) {
+        if (!(harvest->sourceMask[cell] & (1u << k))) continue;
+        if (!bestReachable || sourceDistSq[k] < bestReachableDistSq) {
+            bestReachable = sources[k];
+            bestReachableDistSq = sourceDistSq[k];
         }
     }
-
     return bestReachable ? bestReachable : bestNearest;
 }
 
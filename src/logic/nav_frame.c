@@ -14,19 +14,41 @@
 
 #include <assert.h>
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if NAV_BUILD_WORKERS > 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #include "../core/battlefield.h"
 
 // Compile-time safety check for the center-based edge invariant documented
-// in nav_frame.h. If a future unit's body radius exceeds the clearance the
-// moat provides, this line fails to compile and forces a deliberate review
-// of NAV_EDGE_MOAT_CELLS.
+// in nav_frame.h. NAV_EDGE_MOAT_CELLS is derived to satisfy it; this guards
+// the derivation against later edits.
 _Static_assert(
     NAV_MAX_MOBILE_BODY_RADIUS <= (NAV_EDGE_MOAT_CELLS * NAV_CELL_SIZE + NAV_CELL_SIZE / 2),
     "NAV_EDGE_MOAT_CELLS too small for NAV_MAX_MOBILE_BODY_RADIUS; see nav_frame.h");
 
-#define NAV_HEAP_CAPACITY ((int32_t)(sizeof(((NavFrame*)0)->heapStorage) / sizeof(NavHeapNode)))
+#define NAV_HEAP_CAPACITY ((int32_t)(sizeof(((NavScratch*)0)->heapStorage) / sizeof(NavHeapNode)))
+
+_Static_assert((NAV_BUCKET_COUNT & (NAV_BUCKET_COUNT - 1)) == 0,
+               "NAV_BUCKET_COUNT must be a power of two");
+_Static_assert(NAV_MAX_STEP_COST < NAV_BUCKET_COUNT,
+               "NAV_BUCKET_COUNT must exceed NAV_MAX_STEP_COST; raise it after "
+               "increasing the density penalties");
+
+static bool nav_field_cache_init(NavFieldCache *cache, int32_t capacity,
+                                 int32_t indexCapacity);
+static void nav_field_cache_destroy(NavFieldCache *cache);
+static void nav_field_cache_expire(NavFieldCache *cache, uint32_t lastFrame);
+static void nav_penalty_init_edge_masks(void);
+static void nav_reset_static_blockers(NavFrame *nav);
+static void nav_pool_start(NavFrame *nav);
+static void nav_pool_stop(NavFrame *nav);
 
 // ---------- Coordinate helpers ----------
 
@@ -65,65 +87,146 @@ int32_t nav_cell_index_for_world(float worldX, float worldY) {
     return nav_index(col, row);
 }
 
+// Inclusive cell rectangle. Seeders record the rectangle they scanned, so
+// integration looks for seeds there instead of across the whole board.
+typedef struct {
+    int32_t c0, r0, c1, r1;
+} NavCellBox;
+
+static const NavCellBox NAV_BOX_ALL = { 0, 0, NAV_COLS - 1, NAV_ROWS - 1 };
+static const NavCellBox NAV_BOX_EMPTY = { NAV_COLS, NAV_ROWS, -1, -1 };
+
+// Grow `box` (when given) to cover [c0, c1] x [r0, r1], clamped to the board.
+static void nav_box_include(NavCellBox *box, int32_t c0, int32_t r0,
+                            int32_t c1, int32_t r1) {
+    if (!box) return;
+    c0 = nav_clampi(c0, 0, NAV_COLS - 1);
+    r0 = nav_clampi(r0, 0, NAV_ROWS - 1);
+    c1 = nav_clampi(c1, 0, NAV_COLS - 1);
+    r1 = nav_clampi(r1, 0, NAV_ROWS - 1);
+    if (c0 < box->c0) box->c0 = c0;
+    if (r0 < box->r0) box->r0 = r0;
+    if (c1 > box->c1) box->c1 = c1;
+    if (r1 > box->r1) box->r1 = r1;
+}
+
 // ---------- Lifecycle ----------
 
-void nav_frame_init(NavFrame *nav) {
+void nav_frame_init(NavFrame *nav, int entityCapacity) {
     if (!nav) return;
     memset(nav, 0, sizeof(*nav));
+    if (entityCapacity < 1) entityCapacity = 1;
+    nav->budgetUs = NAV_FRAME_BUDGET_US;
+    nav->queryBounded = NAV_QUERY_BOUNDED;
+    nav->orcaProfiles = PATHFIND_ORCA_PROFILES;
+    nav_penalty_init_edge_masks();
+    nav_reset_static_blockers(nav);
+
+    int32_t snapCapacity = 1;
+    while (snapCapacity < entityCapacity * 2) snapCapacity <<= 1;
+
+    nav->entityPosId = malloc((size_t)snapCapacity * sizeof(int32_t));
+    nav->entityPosX = calloc((size_t)snapCapacity, sizeof(float));
+    nav->entityPosY = calloc((size_t)snapCapacity, sizeof(float));
+    bool cachesOk = nav_field_cache_init(&nav->targetCache, entityCapacity, snapCapacity);
+    cachesOk = nav_field_cache_init(&nav->freeGoalCache, entityCapacity, snapCapacity) &&
+               cachesOk;
+
+    int32_t workers = NAV_BUILD_WORKERS;
+#if NAV_BUILD_WORKERS > 1
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus >= 1 && cpus < workers) workers = (int32_t)cpus;
+#endif
+    if (workers < 1) workers = 1;
+    nav->scratch = calloc((size_t)workers, sizeof(NavScratch));
+    nav->jobs = malloc((size_t)(NAV_LANE_FIELD_COUNT + 2 * entityCapacity) *
+                       sizeof(NavFieldJob));
+    if (!nav->entityPosId || !nav->entityPosX || !nav->entityPosY || !cachesOk ||
+        !nav->scratch || !nav->jobs) {
+        fprintf(stderr, "[NavFrame] Out of memory for %d entities\n", entityCapacity);
+        nav_frame_destroy(nav);
+        return;
+    }
+    for (int32_t i = 0; i < snapCapacity; ++i) {
+        nav->entityPosId[i] = NAV_ENTITY_ID_NONE;
+    }
+    nav->entitySnapCapacity = snapCapacity;
+    nav->workerCount = workers;
+    nav_pool_start(nav);
 }
 
 void nav_frame_destroy(NavFrame *nav) {
-    (void)nav;
+    if (!nav) return;
+    nav_pool_stop(nav);
+    free(nav->scratch);
+    free(nav->jobs);
+    nav->scratch = NULL;
+    nav->jobs = NULL;
+    nav->workerCount = 0;
+    nav->jobCount = 0;
+    free(nav->entityPosId);
+    free(nav->entityPosX);
+    free(nav->entityPosY);
+    nav_field_cache_destroy(&nav->targetCache);
+    nav_field_cache_destroy(&nav->freeGoalCache);
+    nav->entityPosId = NULL;
+    nav->entityPosX = NULL;
+    nav->entityPosY = NULL;
+    nav->entitySnapCapacity = 0;
 }
 
-// Rebuild the static obstacle mask for a fresh frame. Phase 1 rasterizes the
-// one-cell outer border so every flow field has a guaranteed hard moat at
-// the board edge -- without it, flow integration can legally path an entity
-// into a cell that clips past the canonical board bounds, which the old
-// candidate-fan pathfinder would reject via radius-against-edge checks.
-// Phase 2 extends this with NAV_PROFILE_STATIC entity footprints from bf.
-static void nav_rebuild_static_blockers(NavFrame *nav, const Battlefield *bf) {
-    (void)bf;
+// Reset the static obstacle mask to the NAV_EDGE_MOAT_CELLS-wide outer
+// border, so every flow field has a guaranteed hard moat at the board
+// edge -- without it, flow integration can legally path an entity into a
+// cell that clips past the canonical board bounds, which the old
+// candidate-fan pathfinder would reject via radius-against-edge checks. NAV_PROFILE_STATIC footprints are
+// stamped on top by the caller of nav_static_layer_begin.
+static void nav_reset_static_blockers(NavFrame *nav) {
     memset(nav->staticBlockers.blocked, 0, sizeof(nav->staticBlockers.blocked));
     for (int32_t i = 0; i < NAV_CELLS; ++i) {
         nav->staticBlockers.blockerSrc[i] = NAV_BLOCKER_SRC_NONE;
     }
-    for (int32_t col = 0; col < NAV_COLS; ++col) {
-        nav->staticBlockers.blocked[nav_index(col, 0)] = 1;
-        nav->staticBlockers.blocked[nav_index(col, NAV_ROWS - 1)] = 1;
-    }
-    for (int32_t row = 0; row < NAV_ROWS; ++row) {
-        nav->staticBlockers.blocked[nav_index(0, row)] = 1;
-        nav->staticBlockers.blocked[nav_index(NAV_COLS - 1, row)] = 1;
+    for (int32_t ring = 0; ring < NAV_EDGE_MOAT_CELLS; ++ring) {
+        for (int32_t col = 0; col < NAV_COLS; ++col) {
+            nav_bit_set(nav->staticBlockers.blocked, nav_index(col, ring));
+            nav_bit_set(nav->staticBlockers.blocked, nav_index(col, NAV_ROWS - 1 - ring));
+        }
+        for (int32_t row = 0; row < NAV_ROWS; ++row) {
+            nav_bit_set(nav->staticBlockers.blocked, nav_index(ring, row));
+            nav_bit_set(nav->staticBlockers.blocked, nav_index(NAV_COLS - 1 - ring, row));
+        }
     }
+    nav->staticDirty = true;
 }
 
 void nav_begin_frame(NavFrame *nav, const Battlefield *bf) {
     if (!nav) return;
+    uint32_t lastFrame = nav->frameCounter;
     nav->frameCounter++;
     nav->initialized = true;
-
-    nav_rebuild_static_blockers(nav, bf);
+    nav->inputsSealed = false;
+    nav->budgetSpentNs = 0;
+    (void)bf;
 
     memset(nav->density, 0, sizeof(nav->density));
-    for (int32_t i = 0; i < NAV_ENTITY_SNAP_CAPACITY; ++i) {
+    for (int32_t i = 0; i < nav->entitySnapCapacity; ++i) {
         nav->entityPosId[i] = NAV_ENTITY_ID_NONE;
     }
 
-    for (int s = 0; s < 2; ++s) {
-        for (int l = 0; l < 3; ++l) {
-            nav->laneFields[s][l].built = false;
-        }
-    }
-    for (int i = 0; i < NAV_TARGET_CACHE_CAPACITY; ++i) {
-        nav->targetFields[i].built = false;
-    }
-    for (int i = 0; i < NAV_FREE_GOAL_CACHE_CAPACITY; ++i) {
-        nav->freeGoalFields[i].built = false;
-    }
-    nav->targetCacheSize = 0;
-    nav->freeGoalCacheSize = 0;
-    nav->heapSize = 0;
+    // Fields persist and are revalidated on lookup. Cache entries nobody
+    // asked for last frame are released so the caches track the live set.
+    nav_field_cache_expire(&nav->targetCache, lastFrame);
+    nav_field_cache_expire(&nav->freeGoalCache, lastFrame);
+}
+
+bool nav_static_layer_begin(NavFrame *nav, uint32_t version) {
+    if (!nav) return false;
+    if (nav->staticLayerStamped && nav->staticLayerVersion == version) return false;
+    nav_reset_static_blockers(nav);
+    nav->staticLayerVersion = version;
+    nav->staticLayerStamped = true;
+    nav->inputsSealed = false;
+    return true;
 }
 
 // ---------- Blocker queries ----------
@@ -131,62 +234,120 @@ void nav_begin_frame(NavFrame *nav, const Battlefield *bf) {
 bool nav_cell_is_static_blocked(const NavFrame *nav, int32_t cellIndex) {
     if (!nav) return true;
     if (cellIndex < 0 || cellIndex >= NAV_CELLS) return true;
-    return nav->staticBlockers.blocked[cellIndex] != 0;
+    return nav_bit_test(nav->staticBlockers.blocked, cellIndex);
+}
+
+// ---------- Distances ----------
+
+// Clamp a tentative distance into the uint16_t storage range.
+static inline int32_t nav_dist_saturate(int32_t d) {
+    return d < NAV_DIST_MAX ? d : NAV_DIST_MAX;
 }
 
 // ---------- Binary min-heap ----------
 
-// Standard array-backed binary min-heap. `heap` stores NavHeapNodes indexed
+// Indexed array-backed binary min-heap. `heap` stores NavHeapNodes indexed
 // from 0. Parent = (i-1)/2; left child = 2i+1; right child = 2i+2.
+// heapPos[cell] holds 1 + the cell's heap position, 0 when not queued, so
+// zeroed scratch starts out consistent.
 
-static void nav_heap_reset(NavFrame *nav) {
-    nav->heapSize = 0;
+static inline void nav_heap_place(NavScratch *s, int32_t i, NavHeapNode node) {
+    s->heapStorage[i] = node;
+    s->heapPos[node.cell] = i + 1;
 }
 
-static void nav_heap_push(NavFrame *nav, int32_t cell, int32_t dist) {
-    // Lazy-deletion Dijkstra: same cell can be enqueued up to 8 times on
-    // the 8-neighbor grid. Capacity is 9 * NAV_CELLS; overflow is a bug,
-    // not a recoverable condition.
-    assert(nav->heapSize < NAV_HEAP_CAPACITY);
-    int32_t i = nav->heapSize++;
-    NavHeapNode *heap = nav->heapStorage;
-    heap[i].cell = cell;
-    heap[i].dist = dist;
+static void nav_heap_reset(NavScratch *s) {
+    for (int32_t i = 0; i < s->heapSize; ++i) {
+        s->heapPos[s->heapStorage[i].cell] = 0;
+    }
+    s->heapSize = 0;
+}
+
+// Queue `cell` at `dist`, or lower its key if it is already queued. Each
+// cell holds at most one entry, so NAV_CELLS entries always suffice.
+static void nav_heap_push(NavScratch *s, int32_t cell, int32_t dist) {
+    NavHeapNode *heap = s->heapStorage;
+    int32_t i = s->heapPos[cell] - 1;
+    if (i < 0) {
+        assert(s->heapSize < NAV_HEAP_CAPACITY);
+        i = s->heapSize++;
+    } else if (heap[i].dist <= dist) {
+        return;
+    }
+    NavHeapNode node = { dist, cell };
     while (i > 0) {
         int32_t parent = (i - 1) / 2;
-        if (heap[parent].dist <= heap[i].dist) break;
-        NavHeapNode tmp = heap[parent];
-        heap[parent] = heap[i];
-        heap[i] = tmp;
+        if (heap[parent].dist <= dist) break;
+        nav_heap_place(s, i, heap[parent]);
         i = parent;
     }
+    nav_heap_place(s, i, node);
 }
 
-static NavHeapNode nav_heap_pop(NavFrame *nav) {
-    NavHeapNode *heap = nav->heapStorage;
+static NavHeapNode nav_heap_pop(NavScratch *s) {
+    NavHeapNode *heap = s->heapStorage;
     NavHeapNode top = heap[0];
-    nav->heapSize--;
-    if (nav->heapSize > 0) {
-        heap[0] = heap[nav->heapSize];
+    s->heapPos[top.cell] = 0;
+    s->heapSize--;
+    if (s->heapSize > 0) {
+        NavHeapNode last = heap[s->heapSize];
         int32_t i = 0;
         for (;;) {
             int32_t l = 2 * i + 1;
             int32_t r = 2 * i + 2;
-            int32_t smallest = i;
-            if (l < nav->heapSize && heap[l].dist < heap[smallest].dist) smallest = l;
-            if (r < nav->heapSize && heap[r].dist < heap[smallest].dist) smallest = r;
-            if (smallest == i) break;
-            NavHeapNode tmp = heap[smallest];
-            heap[smallest] = heap[i];
-            heap[i] = tmp;
+            int32_t smallest = l;
+            if (l >= s->heapSize) break;
+            if (r < s->heapSize && heap[r].dist < heap[l].dist) smallest = r;
+            if (heap[smallest].dist >= last.dist) break;
+            nav_heap_place(s, i, heap[smallest]);
             i = smallest;
         }
+        nav_heap_place(s, i, last);
     }
     return top;
 }
 
-static bool nav_heap_empty(const NavFrame *nav) {
-    return nav->heapSize == 0;
+static bool nav_heap_empty(const NavScratch *s) {
+    return s->heapSize == 0;
+}
+
+// ---------- Bucket queue ----------
+
+// Dial's bucket queue. Cell c with tentative distance d lives in bucket
+// d & (NAV_BUCKET_COUNT - 1). Every queued distance lies within
+// [current, current + NAV_MAX_STEP_COST], so one ring never aliases two
+// live distances. bucketPrev[c] == NAV_BUCKET_NOT_QUEUED marks cells that
+// are not in any bucket; -1 marks a bucket head.
+
+#define NAV_BUCKET_NOT_QUEUED (-2)
+#define NAV_BUCKET_MASK       (NAV_BUCKET_COUNT - 1)
+
+static void nav_bucket_reset(NavScratch *s) {
+    for (int32_t b = 0; b < NAV_BUCKET_COUNT; ++b) s->bucketHead[b] = -1;
+    for (int32_t i = 0; i < NAV_CELLS; ++i) s->bucketPrev[i] = NAV_BUCKET_NOT_QUEUED;
+}
+
+static void nav_bucket_unlink(NavScratch *s, int32_t cell, int32_t bucket) {
+    int32_t prev = s->bucketPrev[cell];
+    int32_t next = s->bucketNext[cell];
+    if (prev >= 0) s->bucketNext[prev] = next;
+    else s->bucketHead[bucket] = next;
+    if (next >= 0) s->bucketPrev[next] = prev;
+    s->bucketPrev[cell] = NAV_BUCKET_NOT_QUEUED;
+}
+
+// Insert `cell` at distance `dist`, moving it out of the bucket for
+// `oldDist` first if it is already queued (decrease-key).
+static void nav_bucket_push(NavScratch *s, int32_t cell, int32_t dist, int32_t oldDist) {
+    if (s->bucketPrev[cell] != NAV_BUCKET_NOT_QUEUED) {
+        nav_bucket_unlink(s, cell, oldDist & NAV_BUCKET_MASK);
+    }
+    int32_t bucket = dist & NAV_BUCKET_MASK;
+    int32_t head = s->bucketHead[bucket];
+    s->bucketNext[cell] = head;
+    s->bucketPrev[cell] = -1;
+    if (head >= 0) s->bucketPrev[head] = cell;
+    s->bucketHead[bucket] = cell;
 }
 
 // ---------- Dijkstra kernel ----------
@@ -216,18 +377,27 @@ static inline bool nav_neighbor_is_diagonal(int n) {
     return n >= 4;
 }
 
-// Per-cell density cost contribution from the perspective of `allySide`.
-// Ally-occupied cells add NAV_ALLY_OCCUPIED_COST; enemy-occupied cells add
-// NAV_ENEMY_OCCUPIED_COST. Adjacent-cell (NEAR) contribution is added by
-// scanning the phase 4 orthogonal neighbors for their occupancy, weighted with
-// NAV_ALLY_NEAR_COST / NAV_ENEMY_NEAR_COST. The result is the additional
-// integer penalty tacked onto a relaxation that steps INTO `cell`.
-static int32_t nav_density_penalty(const NavFrame *nav, int32_t cell,
-                                    int allySide) {
+// Per-cell density cost contribution from the perspective of `allySide`:
+// the additional integer penalty tacked onto a relaxation that steps INTO
+// `cell`, read from the grid nav_seal_inputs precomputes (see Density
+// penalty grid below).
+static inline int32_t nav_density_penalty(const NavFrame *nav, int32_t cell,
+                                           int allySide) {
+    return nav->penalty[allySide][cell];
+}
+
+// Penalty for stepping into `cell` from per-side occupancy bitsets
+// (density > 0). Ally-occupied cells add NAV_ALLY_OCCUPIED_COST;
+// enemy-occupied cells add NAV_ENEMY_OCCUPIED_COST. Each occupied
+// orthogonal neighbor adds NAV_ALLY_NEAR_COST / NAV_ENEMY_NEAR_COST. This
+// is the reference definition of the penalty grid; density repair also
+// uses it to recover the costs a field was integrated against.
+static int32_t nav_occupancy_penalty(const uint64_t (*occ)[NAV_CELL_WORDS],
+                                     int32_t cell, int allySide) {
     int enemySide = 1 - allySide;
     int32_t penalty = 0;
-    if (nav->density[allySide][cell] > 0) penalty += NAV_ALLY_OCCUPIED_COST;
-    if (nav->density[enemySide][cell] > 0) penalty += NAV_ENEMY_OCCUPIED_COST;
+    if (nav_bit_test(occ[allySide], cell)) penalty += NAV_ALLY_OCCUPIED_COST;
+    if (nav_bit_test(occ[enemySide], cell)) penalty += NAV_ENEMY_OCCUPIED_COST;
     NavCellCoord coord = nav_cell_coord(cell);
     static const int8_t NEAR[4][2] = { {0,-1}, {1,0}, {0,1}, {-1,0} };
     for (int i = 0; i < 4; ++i) {
@@ -235,61 +405,992 @@ static int32_t nav_density_penalty(const NavFrame *nav, int32_t cell,
         int32_t nr = coord.row + NEAR[i][1];
         if (!nav_in_bounds(nc, nr)) continue;
         int32_t nidx = nav_index(nc, nr);
-        if (nav->density[allySide][nidx] > 0) penalty += NAV_ALLY_NEAR_COST;
-        if (nav->density[enemySide][nidx] > 0) penalty += NAV_ENEMY_NEAR_COST;
+        if (nav_bit_test(occ[allySide], nidx)) penalty += NAV_ALLY_NEAR_COST;
+        if (nav_bit_test(occ[enemySide], nidx)) penalty += NAV_ENEMY_NEAR_COST;
     }
     return penalty;
 }
 
-// Run reverse Dijkstra on `field` starting from every cell already assigned
-// a finite distance (seed cells). Density-cost shaping is read from nav's
-// frozen per-side density snapshot; allies are cheap, enemies are costly,
-// computed from the perspective of field->perspectiveSide.
-static void nav_integrate_field(NavFrame *nav, NavField *field) {
+// NAV_NEIGHBORS index of the opposite direction.
+static inline int nav_neighbor_opposite(int n) {
+    return (n < 4) ? (n + 2) % 4 : 4 + (n - 4 + 2) % 4;
+}
+
+// Base (density-free) cost of stepping from `cell` to its n-th neighbor,
+// or -1 if that move is off-grid, into a hard-blocked cell, or a diagonal
+// corner cut. Writes the neighbor's index to *outNeighbor.
+static inline int32_t nav_step_base_cost(const NavField *field, NavCellCoord coord,
+                                         int n, int32_t *outNeighbor) {
+    int32_t ncol = coord.col + NAV_NEIGHBORS[n].dcol;
+    int32_t nrow = coord.row + NAV_NEIGHBORS[n].drow;
+    if (!nav_in_bounds(ncol, nrow)) return -1;
+    int32_t nidx = nav_index(ncol, nrow);
+    if (nav_bit_test(field->hardBlocked, nidx)) return -1;
+    // Corner-cut prevention: a diagonal step is only legal if both
+    // of the two adjacent orthogonal cells are also passable. This
+    // stops flow fields from squeezing through the shared corner of
+    // two hard-blocked cells (e.g. around a building footprint) in
+    // ways the old radius-aware blocker test never allowed.
+    if (nav_neighbor_is_diagonal(n)) {
+        int32_t orthoColIdx = nav_index(coord.col + NAV_NEIGHBORS[n].dcol,
+                                        coord.row);
+        int32_t orthoRowIdx = nav_index(coord.col,
+                                        coord.row + NAV_NEIGHBORS[n].drow);
+        if (nav_bit_test(field->hardBlocked, orthoColIdx)) return -1;
+        if (nav_bit_test(field->hardBlocked, orthoRowIdx)) return -1;
+    }
+    *outNeighbor = nidx;
+    return NAV_NEIGHBORS[n].cost;
+}
+
+// Full relaxation cost of the step above under the current density.
+static inline int32_t nav_relax_step(const NavFrame *nav, const NavField *field,
+                                     NavCellCoord coord, int n, int allySide,
+                                     int32_t *outNeighbor) {
+    int32_t base = nav_step_base_cost(field, coord, n, outNeighbor);
+    if (base < 0) return -1;
+    return base + nav_density_penalty(nav, *outNeighbor, allySide);
+}
+
+// One integration pass. Seeds are the finite cells above `settled` inside
+// `box`: a fresh build passes -1 and its seed rectangle; a resumed one its
+// settledLimit and the whole board, because the cells at or below it are
+// final and everything they queued is still tentative. `pending` counts
+// requester cells (s->requesterMask) not settled yet; when the last one
+// settles, `stopAt` drops from NAV_DIST_UNREACHABLE to its distance plus
+// NAV_QUERY_MARGIN_COST and the pass ends once that distance is settled,
+// setting `stopped`.
+typedef struct {
+    NavCellBox box;
+    int32_t settled;
+    int32_t pending;
+    int32_t stopAt;
+    bool    stopped;
+} NavIntegrateRun;
+
+// Note that `cell` was settled at `dist`.
+static inline void nav_run_settle(const NavScratch *s, NavIntegrateRun *run,
+                                  int32_t cell, int32_t dist) {
+    if (run->pending == 0 || !nav_bit_test(s->requesterMask, cell)) return;
+    if (--run->pending == 0) run->stopAt = dist + NAV_QUERY_MARGIN_COST;
+}
+
+// Dial's-algorithm integration. Returns false without touching the field if
+// the seed distances span more than one bucket ring; the caller then falls
+// back to the heap kernel.
+static bool nav_integrate_field_buckets(const NavFrame *nav, NavScratch *s,
+                                        NavField *field, int allySide,
+                                        NavIntegrateRun *run) {
+    const NavCellBox *box = &run->box;
+    int32_t minSeed = NAV_DIST_UNREACHABLE;
+    int32_t maxSeed = 0;
+    int32_t queued = 0;
+    for (int32_t row = box->r0; row <= box->r1; ++row) {
+        for (int32_t i = row * NAV_COLS + box->c0; i <= row * NAV_COLS + box->c1; ++i) {
+            int32_t d = field->distance[i];
+            if (d == NAV_DIST_UNREACHABLE || d <= run->settled) continue;
+            if (d < minSeed) minSeed = d;
+            if (d > maxSeed) maxSeed = d;
+            queued++;
+        }
+    }
+    if (queued == 0) return true;
+    if (maxSeed - minSeed >= NAV_BUCKET_COUNT) return false;
+
+    nav_bucket_reset(s);
+    // Seed in descending index order so each bucket list pops in ascending
+    // cell order; ties do not affect distance[], but this keeps the visit
+    // order stable and cache-friendly.
+    for (int32_t row = box->r1; row >= box->r0; --row) {
+        for (int32_t i = row * NAV_COLS + box->c1; i >= row * NAV_COLS + box->c0; --i) {
+            int32_t d = field->distance[i];
+            if (d != NAV_DIST_UNREACHABLE && d > run->settled) {
+                nav_bucket_push(s, i, d, d);
+            }
+        }
+    }
+
+    int32_t current = minSeed;
+    while (queued > 0) {
+        int32_t bucket = current & NAV_BUCKET_MASK;
+        int32_t cell = s->bucketHead[bucket];
+        if (cell < 0) {
+            current++;
+            continue;
+        }
+        if (current > run->stopAt) {
+            run->stopped = true;
+            break;
+        }
+        nav_bucket_unlink(s, cell, bucket);
+        queued--;
+        nav_run_settle(s, run, cell, current);
+
+        NavCellCoord coord = nav_cell_coord(cell);
+        for (int n = 0; n < 8; ++n) {
+            int32_t nidx = -1;
+            int32_t step = nav_relax_step(nav, field, coord, n, allySide, &nidx);
+            if (step < 0) continue;
+            int32_t nd = nav_dist_saturate(current + step);
+            int32_t old = field->distance[nidx];
+            if (nd < old) {
+                if (s->bucketPrev[nidx] == NAV_BUCKET_NOT_QUEUED) queued++;
+                field->distance[nidx] = nd;
+                nav_bucket_push(s, nidx, nd, old);
+            }
+        }
+    }
+    return true;
+}
+
+static void nav_heap_drain(const NavFrame *nav, NavScratch *s, NavField *field,
+                           int allySide, NavIntegrateRun *run);
+
+// Run reverse Dijkstra on `field` from the seeds `run` selects. Density-cost
+// shaping is read from nav's frozen per-side density snapshot; allies are
+// cheap, enemies are costly, computed from the perspective of
+// field->perspectiveSide. Leaves field->settledLimit at the last distance
+// settled when the run stopped early.
+static void nav_integrate_run(const NavFrame *nav, NavScratch *s, NavField *field,
+                              NavIntegrateRun *run) {
     int allySide = field->perspectiveSide;
     if (allySide != 0 && allySide != 1) allySide = 0;
 
-    nav_heap_reset(nav);
-    for (int32_t i = 0; i < NAV_CELLS; ++i) {
-        if (field->distance[i] != NAV_DIST_UNREACHABLE) {
-            nav_heap_push(nav, i, field->distance[i]);
+    bool done = false;
+#if NAV_INTEGRATE_BUCKET_QUEUE
+    done = nav_integrate_field_buckets(nav, s, field, allySide, run);
+#endif
+    if (!done) {
+        const NavCellBox *box = &run->box;
+        nav_heap_reset(s);
+        for (int32_t row = box->r0; row <= box->r1; ++row) {
+            for (int32_t i = row * NAV_COLS + box->c0; i <= row * NAV_COLS + box->c1; ++i) {
+                int32_t d = field->distance[i];
+                if (d != NAV_DIST_UNREACHABLE && d > run->settled) {
+                    nav_heap_push(s, i, d);
+                }
+            }
         }
+        nav_heap_drain(nav, s, field, allySide, run);
     }
-    while (!nav_heap_empty(nav)) {
-        NavHeapNode node = nav_heap_pop(nav);
-        if (node.dist != field->distance[node.cell]) {
-            // Stale heap entry from a prior relaxation.
-            continue;
+    field->settledLimit = run->stopped ? run->stopAt : NAV_DIST_UNREACHABLE;
+}
+
+// Integrate `field` over the whole board from the seeds inside `seedBox`
+// (anywhere when NULL).
+static void nav_integrate_field(const NavFrame *nav, NavScratch *s, NavField *field,
+                                const NavCellBox *seedBox) {
+    NavIntegrateRun run = {
+        .box = seedBox ? *seedBox : NAV_BOX_ALL,
+        .settled = -1,
+        .pending = 0,
+        .stopAt = NAV_DIST_UNREACHABLE,
+        .stopped = false,
+    };
+    nav_integrate_run(nav, s, field, &run);
+}
+
+// Pop the heap until empty, relaxing outward under the current density.
+// Every queued entry must carry its cell's current distance. `run`, when
+// given, tracks requesters and may stop the drain early.
+static void nav_heap_drain(const NavFrame *nav, NavScratch *s, NavField *field,
+                           int allySide, NavIntegrateRun *run) {
+    while (!nav_heap_empty(s)) {
+        NavHeapNode node = nav_heap_pop(s);
+        if (run) {
+            if (node.dist > run->stopAt) {
+                run->stopped = true;
+                break;
+            }
+            nav_run_settle(s, run, node.cell, node.dist);
         }
         NavCellCoord coord = nav_cell_coord(node.cell);
         for (int n = 0; n < 8; ++n) {
-            int32_t ncol = coord.col + NAV_NEIGHBORS[n].dcol;
-            int32_t nrow = coord.row + NAV_NEIGHBORS[n].drow;
-            if (!nav_in_bounds(ncol, nrow)) continue;
-            int32_t nidx = nav_index(ncol, nrow);
-            if (field->hardBlocked[nidx]) continue;
-            // Corner-cut prevention: a diagonal step is only legal if both
-            // of the two adjacent orthogonal cells are also passable. This
-            // stops flow fields from squeezing through the shared corner of
-            // two hard-blocked cells (e.g. around a building footprint) in
-            // ways the old radius-aware blocker test never allowed.
-            if (nav_neighbor_is_diagonal(n)) {
-                int32_t orthoColIdx = nav_index(coord.col + NAV_NEIGHBORS[n].dcol,
-                                                coord.row);
-                int32_t orthoRowIdx = nav_index(coord.col,
-                                                coord.row + NAV_NEIGHBORS[n].drow);
-                if (field->hardBlocked[orthoColIdx]) continue;
-                if (field->hardBlocked[orthoRowIdx]) continue;
-            }
-            int32_t step = NAV_NEIGHBORS[n].cost
-                         + nav_density_penalty(nav, nidx, allySide);
-            int32_t nd = node.dist + step;
+            int32_t nidx = -1;
+            int32_t step = nav_relax_step(nav, field, coord, n, allySide, &nidx);
+            if (step < 0) continue;
+            int32_t nd = nav_dist_saturate(node.dist + step);
             if (nd < field->distance[nidx]) {
                 field->distance[nidx] = nd;
-                nav_heap_push(nav, nidx, nd);
+                nav_heap_push(s, nidx, nd);
+            }
+        }
+    }
+}
+
+// ---------- Flow direction tables ----------
+
+// Steepest-descent neighbor of `cell`: the NAV_NEIGHBORS index with the
+// lowest distance strictly below the cell's own (first in neighbor order on
+// ties), or NAV_FLOW_DIR_NONE. The blocker tests only veto a candidate, so
+// they run after the cheaper distance test.
+static uint8_t nav_flow_scan(const NavField *field, int32_t cell) {
+    int32_t bestDist = field->distance[cell];
+    if (bestDist == NAV_DIST_UNREACHABLE) return NAV_FLOW_DIR_NONE;
+    uint8_t best = NAV_FLOW_DIR_NONE;
+    NavCellCoord coord = nav_cell_coord(cell);
+    for (int n = 0; n < 8; ++n) {
+        int32_t nc = coord.col + NAV_NEIGHBORS[n].dcol;
+        int32_t nr = coord.row + NAV_NEIGHBORS[n].drow;
+        if (!nav_in_bounds(nc, nr)) continue;
+        int32_t nidx = nav_index(nc, nr);
+        int32_t d = field->distance[nidx];
+        if (d >= bestDist) continue;
+        if (nav_bit_test(field->hardBlocked, nidx)) continue;
+        // Corner-cut prevention applies to flow sampling too, otherwise
+        // the per-cell direction could point through the shared corner
+        // of two blockers even though the Dijkstra integration refused
+        // to propagate that way.
+        if (nav_neighbor_is_diagonal(n)) {
+            if (nav_bit_test(field->hardBlocked, nav_index(nc, coord.row))) continue;
+            if (nav_bit_test(field->hardBlocked, nav_index(coord.col, nr))) continue;
+        }
+        bestDist = d;
+        best = (uint8_t)n;
+    }
+    return best;
+}
+
+// nav_flow_scan for a cell off the board edge, where every neighbor is in
+// bounds and can be addressed by a flat offset.
+static inline uint8_t nav_flow_scan_interior(const NavField *field, int32_t cell) {
+    static const int32_t OFFSET[8] = {
+        -NAV_COLS, 1, NAV_COLS, -1,
+        1 - NAV_COLS, 1 + NAV_COLS, NAV_COLS - 1, -1 - NAV_COLS,
+    };
+    const uint16_t *dist = field->distance;
+    const uint64_t *blocked = field->hardBlocked;
+    int32_t bestDist = dist[cell];
+    if (bestDist == NAV_DIST_UNREACHABLE) return NAV_FLOW_DIR_NONE;
+    uint8_t best = NAV_FLOW_DIR_NONE;
+    for (int n = 0; n < 4; ++n) {
+        int32_t nidx = cell + OFFSET[n];
+        int32_t d = dist[nidx];
+        if (d < bestDist && !nav_bit_test(blocked, nidx)) {
+            bestDist = d;
+            best = (uint8_t)n;
+        }
+    }
+    for (int n = 4; n < 8; ++n) {
+        int32_t nidx = cell + OFFSET[n];
+        int32_t d = dist[nidx];
+        if (d < bestDist && !nav_bit_test(blocked, nidx) &&
+            !nav_bit_test(blocked, cell + NAV_NEIGHBORS[n].dcol) &&
+            !nav_bit_test(blocked, cell + NAV_NEIGHBORS[n].drow * NAV_COLS)) {
+            bestDist = d;
+            best = (uint8_t)n;
+        }
+    }
+    return best;
+}
+
+// Forget every cached direction; called whenever the distances change.
+static void nav_field_reset_flow(NavField *field) {
+    memset(field->flowDir, NAV_FLOW_DIR_UNKNOWN, sizeof(field->flowDir));
+}
+
+// Steering direction of cell (col, row) from the cached table, scanned
+// when the cell has not been filled in yet. Never writes.
+static inline uint8_t nav_field_peek_flow_dir(const NavField *field, int32_t col, int32_t row) {
+    int32_t cell = nav_index(col, row);
+    uint8_t dir = field->flowDir[cell];
+    if (dir != NAV_FLOW_DIR_UNKNOWN) return dir;
+    // Unsettled cells of a query-bounded field report no flow: their
+    // distance may still drop.
+    if (field->distance[cell] > field->settledLimit) return NAV_FLOW_DIR_NONE;
+    if (col > 0 && col < NAV_COLS - 1 && row > 0 && row < NAV_ROWS - 1) {
+        return nav_flow_scan_interior(field, cell);
+    }
+    return nav_flow_scan(field, cell);
+}
+
+// As nav_field_peek_flow_dir, caching a scanned direction of a settled cell
+// in the field's table. Writes the field, so the caller must own it.
+static inline uint8_t nav_field_flow_dir(NavField *field, int32_t col, int32_t row) {
+    int32_t cell = nav_index(col, row);
+    uint8_t dir = field->flowDir[cell];
+    if (dir != NAV_FLOW_DIR_UNKNOWN) return dir;
+    dir = nav_field_peek_flow_dir(field, col, row);
+    if (field->distance[cell] <= field->settledLimit) field->flowDir[cell] = dir;
+    return dir;
+}
+
+// ---------- Density penalty grid ----------
+//
+// Every relaxation steps into a cell and pays that cell's density penalty,
+// which depends only on the perspective side and the occupancy of the cell
+// and its four orthogonal neighbors. nav_seal_inputs rebuilds
+// nav->penalty for both sides whenever occupancy changes, so builds and
+// repairs read one byte instead of re-deriving it per edge.
+//
+// The rebuild works on byte masks (0x00 / 0xFF per cell) in whole-grid
+// passes: self terms from the cell's own masks, NEAR terms shifted by one
+// row (+-NAV_COLS) or one column (+-1, masked at the board edges). With GCC
+// vector extensions it runs NAV_PENALTY_LANES cells per operation; the
+// scalar loop handles the tail and other compilers.
+
+_Static_assert(NAV_ALLY_OCCUPIED_COST + NAV_ENEMY_OCCUPIED_COST +
+               4 * (NAV_ALLY_NEAR_COST + NAV_ENEMY_NEAR_COST) <= UINT8_MAX,
+               "density penalties must fit nav->penalty's uint8_t cells");
+
+#if defined(__GNUC__) && !defined(NAV_PENALTY_SCALAR)
+#define NAV_PENALTY_LANES 16
+typedef uint8_t NavByteVec __attribute__((vector_size(NAV_PENALTY_LANES)));
+
+static inline NavByteVec nav_byte_vec_load(const uint8_t *p) {
+    NavByteVec v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+#else
+#define NAV_PENALTY_LANES 0
+#endif
+
+// 0xFF where the cell has a west / east neighbor, 0x00 on the board edge.
+static uint8_t s_navHasWest[NAV_CELLS];
+static uint8_t s_navHasEast[NAV_CELLS];
+
+static void nav_penalty_init_edge_masks(void) {
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        int32_t col = i % NAV_COLS;
+        s_navHasWest[i] = col > 0 ? 0xFF : 0x00;
+        s_navHasEast[i] = col < NAV_COLS - 1 ? 0xFF : 0x00;
+    }
+}
+
+// Rebuild nav->penalty[allySide] from per-side occupancy byte masks.
+// occMask[side] points NAV_COLS bytes into a zero-padded buffer, so the row
+// above the first and below the last read as unoccupied.
+static void nav_penalty_build_side(NavFrame *nav, const uint8_t *const occMask[2],
+                                   int allySide, uint8_t *nearPad) {
+    const uint8_t *ally = occMask[allySide];
+    const uint8_t *enemy = occMask[1 - allySide];
+    uint8_t *near = nearPad + NAV_COLS;
+    uint8_t *out = nav->penalty[allySide];
+    int32_t i = 0;
+
+#if NAV_PENALTY_LANES > 0
+    const NavByteVec allyNear = (NavByteVec){ 0 } + NAV_ALLY_NEAR_COST;
+    const NavByteVec enemyNear = (NavByteVec){ 0 } + NAV_ENEMY_NEAR_COST;
+    for (; i + NAV_PENALTY_LANES <= NAV_CELLS; i += NAV_PENALTY_LANES) {
+        NavByteVec v = (nav_byte_vec_load(ally + i) & allyNear) +
+                       (nav_byte_vec_load(enemy + i) & enemyNear);
+        memcpy(near + i, &v, sizeof(v));
+    }
+#endif
+    for (; i < NAV_CELLS; ++i) {
+        near[i] = (uint8_t)((ally[i] & NAV_ALLY_NEAR_COST) +
+                            (enemy[i] & NAV_ENEMY_NEAR_COST));
+    }
+
+    i = 0;
+#if NAV_PENALTY_LANES > 0
+    const NavByteVec allyOcc = (NavByteVec){ 0 } + NAV_ALLY_OCCUPIED_COST;
+    const NavByteVec enemyOcc = (NavByteVec){ 0 } + NAV_ENEMY_OCCUPIED_COST;
+    for (; i + NAV_PENALTY_LANES <= NAV_CELLS; i += NAV_PENALTY_LANES) {
+        NavByteVec v = (nav_byte_vec_load(ally + i) & allyOcc) +
+                       (nav_byte_vec_load(enemy + i) & enemyOcc) +
+                       nav_byte_vec_load(near + i - NAV_COLS) +
+                       nav_byte_vec_load(near + i + NAV_COLS) +
+                       (nav_byte_vec_load(near + i - 1) & nav_byte_vec_load(s_navHasWest + i)) +
+                       (nav_byte_vec_load(near + i + 1) & nav_byte_vec_load(s_navHasEast + i));
+        memcpy(out + i, &v, sizeof(v));
+    }
+#endif
+    for (; i < NAV_CELLS; ++i) {
+        out[i] = (uint8_t)((ally[i] & NAV_ALLY_OCCUPIED_COST) +
+                           (enemy[i] & NAV_ENEMY_OCCUPIED_COST) +
+                           near[i - NAV_COLS] + near[i + NAV_COLS] +
+                           (near[i - 1] & s_navHasWest[i]) +
+                           (near[i + 1] & s_navHasEast[i]));
+    }
+}
+
+static void nav_penalty_rebuild(NavFrame *nav) {
+    // Both buffers carry NAV_COLS bytes of zero padding on each end.
+    uint8_t maskPad[2][NAV_CELLS + 2 * NAV_COLS];
+    uint8_t nearPad[NAV_CELLS + 2 * NAV_COLS];
+    memset(maskPad, 0, sizeof(maskPad));
+    memset(nearPad, 0, sizeof(nearPad));
+    const uint8_t *occMask[2];
+    for (int side = 0; side < 2; ++side) {
+        uint8_t *mask = maskPad[side] + NAV_COLS;
+        const int16_t *density = nav->density[side];
+        for (int32_t i = 0; i < NAV_CELLS; ++i) {
+            mask[i] = density[i] > 0 ? 0xFF : 0x00;
+        }
+        occMask[side] = mask;
+    }
+    for (int side = 0; side < 2; ++side) {
+        nav_penalty_build_side(nav, occMask, side, nearPad);
+    }
+}
+
+// ---------- Persistent fields ----------
+
+// Freeze this frame's inputs into version stamps. Runs on the first field
+// lookup after the stamping pass (stamps clear inputsSealed). The static
+// mask is only compared after something stamped it, and a density version
+// bump also rebuilds the penalty grid.
+static void nav_seal_inputs(NavFrame *nav) {
+    if (nav->inputsSealed) return;
+    if (nav->staticDirty &&
+        memcmp(&nav->staticBlockers, &nav->sealedStatic, sizeof(NavBlockerMask)) != 0) {
+        memcpy(&nav->sealedStatic, &nav->staticBlockers, sizeof(NavBlockerMask));
+        nav->staticVersion++;
+    }
+    nav->staticDirty = false;
+    uint64_t occ[2][NAV_CELL_WORDS];
+    memset(occ, 0, sizeof(occ));
+    for (int side = 0; side < 2; ++side) {
+        for (int32_t i = 0; i < NAV_CELLS; ++i) {
+            if (nav->density[side][i] > 0) nav_bit_set(occ[side], i);
+        }
+    }
+    if (memcmp(occ, nav->occupancy, sizeof(occ)) != 0) {
+        memcpy(nav->occupancy, occ, sizeof(occ));
+        nav->densityVersion++;
+        nav_penalty_rebuild(nav);
+    }
+    nav->inputsSealed = true;
+}
+
+// Record that `field` now matches this frame's inputs.
+static void nav_field_mark_current(const NavFrame *nav, NavField *field,
+                                   const NavSeedInputs *seeds) {
+    field->built = true;
+    field->pending = false;
+    field->frameStamp = nav->frameCounter;
+    field->staticVersion = nav->staticVersion;
+    field->densityVersion = nav->densityVersion;
+    memcpy(field->occupancy, nav->occupancy, sizeof(field->occupancy));
+    field->seedInputs = *seeds;
+}
+
+// Cheapest way into `cell` from any finite neighbor under the current
+// density, or NAV_DIST_UNREACHABLE.
+static int32_t nav_repair_incoming(const NavFrame *nav, const NavField *field,
+                                   int32_t cell, int allySide) {
+    NavCellCoord coord = nav_cell_coord(cell);
+    int32_t penalty = nav_density_penalty(nav, cell, allySide);
+    int32_t best = NAV_DIST_UNREACHABLE;
+    for (int n = 0; n < 8; ++n) {
+        int32_t ucol = coord.col + NAV_NEIGHBORS[n].dcol;
+        int32_t urow = coord.row + NAV_NEIGHBORS[n].drow;
+        if (!nav_in_bounds(ucol, urow)) continue;
+        int32_t u = nav_index(ucol, urow);
+        int32_t du = field->distance[u];
+        if (du == NAV_DIST_UNREACHABLE) continue;
+        int32_t target = -1;
+        int32_t base = nav_step_base_cost(field, nav_cell_coord(u),
+                                          nav_neighbor_opposite(n), &target);
+        if (base < 0) continue;
+        int32_t d = nav_dist_saturate(du + base + penalty);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+enum {
+    NAV_REPAIR_NONE = 0,
+    NAV_REPAIR_CANDIDATE,   // penalty may have changed
+    NAV_REPAIR_DECREASED,   // penalty dropped; distance may drop
+    NAV_REPAIR_AFFECTED     // distance may rise; recomputed from scratch
+};
+
+static void nav_repair_clear(NavScratch *s, int32_t cellCount, int32_t queueCount) {
+    for (int32_t i = 0; i < cellCount; ++i) s->repairState[s->repairCells[i]] = NAV_REPAIR_NONE;
+    for (int32_t i = 0; i < queueCount; ++i) s->repairState[s->repairQueue[i]] = NAV_REPAIR_NONE;
+}
+
+// Bring `field` from the occupancy it was integrated against to the current
+// one without re-seeding. Static mask and seeds must be unchanged. Exact
+// two-phase dynamic Dijkstra:
+//   1. Cells whose step-in penalty rose, plus every cell reachable from them
+//      over edges that were tight under the old costs, may have lost their
+//      shortest path. They are reset to unreachable.
+//   2. Reset cells and cells whose penalty fell are re-labelled from their
+//      untouched neighbors and the heap propagates improvements outward.
+// Every other cell keeps a label realized by a path of unchanged or cheaper
+// edges, so the result equals a full integration. Returns false (field
+// untouched) when the change is too large to be worth repairing.
+static bool nav_field_repair(const NavFrame *nav, NavScratch *s, NavField *field) {
+    int allySide = field->perspectiveSide;
+    if (allySide != 0 && allySide != 1) allySide = 0;
+    uint16_t *dist = field->distance;
+    uint8_t *state = s->repairState;
+    int32_t cellCount = 0;
+    int32_t queueCount = 0;
+    int32_t dirty = 0;
+
+    static const int8_t NEAR[5][2] = { {0,0}, {0,-1}, {1,0}, {0,1}, {-1,0} };
+    for (int side = 0; side < 2; ++side) {
+        for (int32_t w = 0; w < NAV_CELL_WORDS; ++w) {
+            uint64_t diff = field->occupancy[side][w] ^ nav->occupancy[side][w];
+            while (diff) {
+                int32_t cell = w * 64 + __builtin_ctzll(diff);
+                diff &= diff - 1;
+                if (++dirty > NAV_FIELD_REPAIR_MAX_DIRTY_CELLS) {
+                    nav_repair_clear(s, cellCount, 0);
+                    return false;
+                }
+                // A cell's occupancy feeds its own penalty and its four
+                // orthogonal neighbors' NEAR terms.
+                NavCellCoord c = nav_cell_coord(cell);
+                for (int k = 0; k < 5; ++k) {
+                    int32_t col = c.col + NEAR[k][0];
+                    int32_t row = c.row + NEAR[k][1];
+                    if (!nav_in_bounds(col, row)) continue;
+                    int32_t idx = nav_index(col, row);
+                    if (state[idx] != NAV_REPAIR_NONE) continue;
+                    state[idx] = NAV_REPAIR_CANDIDATE;
+                    s->repairCells[cellCount++] = idx;
+                }
             }
         }
     }
+
+    const uint64_t (*oldOcc)[NAV_CELL_WORDS] = (const uint64_t (*)[NAV_CELL_WORDS])field->occupancy;
+    for (int32_t i = 0; i < cellCount; ++i) {
+        int32_t x = s->repairCells[i];
+        if (dist[x] == 0 || dist[x] == NAV_DIST_UNREACHABLE) continue;
+        int32_t oldPenalty = nav_occupancy_penalty(oldOcc, x, allySide);
+        int32_t newPenalty = nav_density_penalty(nav, x, allySide);
+        if (newPenalty > oldPenalty) {
+            state[x] = NAV_REPAIR_AFFECTED;
+            s->repairQueue[queueCount++] = x;
+        } else if (newPenalty < oldPenalty) {
+            state[x] = NAV_REPAIR_DECREASED;
+        }
+    }
+
+    // Phase 1: close over old-cost tight edges. Labels are still the old
+    // ones here, so dist[u] + cost == dist[v] identifies shortest-path
+    // successors.
+    for (int32_t head = 0; head < queueCount; ++head) {
+        int32_t u = s->repairQueue[head];
+        NavCellCoord coord = nav_cell_coord(u);
+        for (int n = 0; n < 8; ++n) {
+            int32_t v = -1;
+            int32_t base = nav_step_base_cost(field, coord, n, &v);
+            if (base < 0) continue;
+            if (state[v] == NAV_REPAIR_AFFECTED) continue;
+            int32_t dv = dist[v];
+            if (dv == 0 || dv == NAV_DIST_UNREACHABLE) continue;
+            if (dv != dist[u] + base + nav_occupancy_penalty(oldOcc, v, allySide)) continue;
+            if (queueCount >= NAV_FIELD_REPAIR_MAX_AFFECTED) {
+                nav_repair_clear(s, cellCount, queueCount);
+                return false;
+            }
+            state[v] = NAV_REPAIR_AFFECTED;
+            s->repairQueue[queueCount++] = v;
+        }
+    }
+
+    // Phase 2: re-label and propagate under the current costs.
+    for (int32_t i = 0; i < queueCount; ++i) {
+        dist[s->repairQueue[i]] = NAV_DIST_UNREACHABLE;
+    }
+    nav_heap_reset(s);
+    for (int32_t i = 0; i < queueCount; ++i) {
+        int32_t v = s->repairQueue[i];
+        int32_t d = nav_repair_incoming(nav, field, v, allySide);
+        if (d < dist[v]) {
+            dist[v] = d;
+            nav_heap_push(s, v, d);
+        }
+    }
+    for (int32_t i = 0; i < cellCount; ++i) {
+        int32_t x = s->repairCells[i];
+        if (state[x] != NAV_REPAIR_DECREASED) continue;
+        int32_t d = nav_repair_incoming(nav, field, x, allySide);
+        if (d < dist[x]) {
+            dist[x] = d;
+            nav_heap_push(s, x, d);
+        }
+    }
+    nav_heap_drain(nav, s, field, allySide, NULL);
+    nav_field_reset_flow(field);
+
+    nav_repair_clear(s, cellCount, queueCount);
+    return true;
+}
+
+// Revalidate a field left over from an earlier frame. Returns true if it now
+// matches this frame's inputs (unchanged, or repaired in place); false if
+// the caller must rebuild it.
+static bool nav_field_refresh(const NavFrame *nav, NavScratch *s, NavField *field,
+                              const NavSeedInputs *seeds) {
+    if (!field->built) return false;
+    if (field->staticVersion != nav->staticVersion) return false;
+    if (memcmp(&field->seedInputs, seeds, sizeof(*seeds)) != 0) return false;
+    // Repair relabels cells from their neighbors, so a query-bounded field
+    // with a tentative frontier is rebuilt instead.
+    bool complete = field->settledLimit == NAV_DIST_UNREACHABLE;
+    if (field->densityVersion == nav->densityVersion) {
+        s->stats.hits++;
+    } else if (complete && nav_field_repair(nav, s, field)) {
+        s->stats.repairs++;
+    } else {
+        return false;
+    }
+    nav_field_mark_current(nav, field, seeds);
+    return true;
+}
+
+// ---------- Frame budget ----------
+
+static uint64_t nav_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t nav_budget_ns(const NavFrame *nav) {
+    return (uint64_t)nav->budgetUs * 1000u;
+}
+
+static bool nav_budget_exhausted(const NavFrame *nav) {
+    return nav->budgetUs > 0 && nav->budgetSpentNs >= nav_budget_ns(nav);
+}
+
+// Start / stop timing one lazy build. Free when the budget is disabled.
+static inline uint64_t nav_budget_begin(const NavFrame *nav) {
+    return nav->budgetUs > 0 ? nav_clock_ns() : 0;
+}
+
+static inline void nav_budget_end(NavFrame *nav, uint64_t startNs) {
+    if (nav->budgetUs > 0) nav->budgetSpentNs += nav_clock_ns() - startNs;
+}
+
+// True when `field` would be a plain cache hit: no repair or build needed.
+static bool nav_field_is_current(const NavFrame *nav, const NavField *field,
+                                 const NavSeedInputs *seeds) {
+    return field->built &&
+           field->staticVersion == nav->staticVersion &&
+           field->densityVersion == nav->densityVersion &&
+           memcmp(&field->seedInputs, seeds, sizeof(*seeds)) == 0;
+}
+
+// Hand out `field` as an earlier frame left it, or NULL while it is still
+// pending its first build. Its frameStamp is kept, so the next build stage
+// sees it as stale and queues it ahead of fresh work.
+static NavField *nav_field_serve_stale(NavFrame *nav, NavField *field) {
+    NavFieldStats *stats = &nav->scratch[0].stats;
+    stats->deferred++;
+    field->useStamp = nav->frameCounter;
+    if (!field->built) return NULL;
+    uint32_t age = nav->frameCounter - field->frameStamp;
+    stats->staleServed++;
+    stats->staleAgeTotal += age;
+    if (age > stats->staleAgeMax) stats->staleAgeMax = age;
+    return field;
+}
+
+// ---------- Query-bounded builds ----------
+
+// Whether builds of `field` may stop around its requesters.
+static bool nav_field_query_bounded(const NavFrame *nav, const NavField *field) {
+    return nav->queryBounded && !field->requestersOverflow && field->requesterCount > 0;
+}
+
+// Record a lookup of `field` from (x, y). The first lookup of a frame
+// restarts the list, so the build stage sees the frame before's requesters;
+// a lookup without a position asks for the whole board.
+static void nav_field_note_requester(const NavFrame *nav, NavField *field,
+                                     bool hasRequester, float x, float y) {
+    if (!nav->queryBounded) return;
+    if (field->requesterFrame != nav->frameCounter) {
+        field->requesterFrame = nav->frameCounter;
+        field->requesterCount = 0;
+        field->requestersOverflow = false;
+    }
+    if (field->requestersOverflow) return;
+    if (!hasRequester || field->requesterCount == NAV_FIELD_MAX_REQUESTERS) {
+        field->requestersOverflow = true;
+        return;
+    }
+    int32_t cell = nav_cell_index_for_world(x, y);
+    for (int32_t i = 0; i < field->requesterCount; ++i) {
+        if (field->requesterCells[i] == cell) return;
+    }
+    field->requesterCells[field->requesterCount++] = cell;
+}
+
+// Integrate `field` from the seeds in `seedBox`, or resume it from its
+// frontier when seedBox is NULL. With `bounded`, the pass stops
+// NAV_QUERY_MARGIN_COST past the last requester cell it settles; a
+// requester it never reaches runs it over the whole board. Returns true
+// when it stopped early.
+static bool nav_integrate_query(const NavFrame *nav, NavScratch *s, NavField *field,
+                                const NavCellBox *seedBox, bool bounded) {
+    NavIntegrateRun run = {
+        .box = seedBox ? *seedBox : NAV_BOX_ALL,
+        .settled = seedBox ? -1 : field->settledLimit,
+        .pending = 0,
+        .stopAt = NAV_DIST_UNREACHABLE,
+        .stopped = false,
+    };
+    if (bounded) {
+        int32_t settledMax = -1;
+        for (int32_t i = 0; i < field->requesterCount; ++i) {
+            int32_t cell = field->requesterCells[i];
+            int32_t d = field->distance[cell];
+            if (d <= run.settled) {
+                if (d > settledMax) settledMax = d;
+            } else {
+                nav_bit_set(s->requesterMask, cell);
+                run.pending++;
+            }
+        }
+        if (run.pending == 0) run.stopAt = settledMax + NAV_QUERY_MARGIN_COST;
+    }
+    nav_integrate_run(nav, s, field, &run);
+    if (bounded) {
+        for (int32_t i = 0; i < field->requesterCount; ++i) {
+            nav_bit_clear(s->requesterMask, field->requesterCells[i]);
+        }
+    }
+    return run.stopped;
+}
+
+// True when every cell nav_sample_flow reads at (x, y) -- the four cell
+// centers around it -- is settled or hard-blocked (those never get a
+// distance).
+static bool nav_field_covers(const NavField *field, float x, float y) {
+    if (field->settledLimit == NAV_DIST_UNREACHABLE) return true;
+    int32_t c0 = (int32_t)floorf(x / (float)NAV_CELL_SIZE - 0.5f);
+    int32_t r0 = (int32_t)floorf(y / (float)NAV_CELL_SIZE - 0.5f);
+    for (int32_t row = r0; row <= r0 + 1; ++row) {
+        for (int32_t col = c0; col <= c0 + 1; ++col) {
+            if (!nav_in_bounds(col, row)) continue;
+            int32_t idx = nav_index(col, row);
+            if (nav_bit_test(field->hardBlocked, idx)) continue;
+            if (field->distance[idx] > field->settledLimit) return false;
+        }
+    }
+    return true;
+}
+
+// Finish a lookup of `field` from (x, y): resume a query-bounded
+// integration until the cells the caller samples are settled, or over the
+// whole board for a caller without a position. Settled cells keep their
+// distances and cached directions. Stale fields are served as they stand.
+static void nav_field_cover_requester(NavFrame *nav, NavField *field,
+                                      bool hasRequester, float x, float y) {
+    if (field->settledLimit == NAV_DIST_UNREACHABLE) return;
+    if (!field->built || field->frameStamp != nav->frameCounter) return;
+    if (hasRequester && nav_field_covers(field, x, y)) return;
+    NavScratch *s = &nav->scratch[0];
+    uint64_t startNs = nav_budget_begin(nav);
+    nav_integrate_query(nav, s, field, NULL,
+                        hasRequester && nav_field_query_bounded(nav, field));
+    // A sample cell the margin did not reach (across a blocker from the
+    // requester's own cell) needs the rest of the board.
+    if (hasRequester && !nav_field_covers(field, x, y)) {
+        nav_integrate_query(nav, s, field, NULL, false);
+    }
+    nav_budget_end(nav, startNs);
+    s->stats.extensions++;
+}
+
+// ---------- Field cache index ----------
+//
+// Target and free-goal fields are found through an open-addressed table
+// keyed on the cache key, probed linearly like the entity snapshot. The
+// table is at least twice the cache capacity, so probes stay short.
+// Removal uses backward-shift deletion, so no tombstones accumulate while
+// slots turn over across frames.
+
+// Cache key of a built field. Target fields key on the target id, not its
+// position, so their goal coordinates are left out.
+typedef struct {
+    int32_t kind;
+    int32_t side;
+    int32_t targetId;
+    int32_t rangeQ;
+    int32_t goalXQ;
+    int32_t goalYQ;
+} NavFieldKey;
+
+static NavFieldKey nav_field_key_of(const NavField *field) {
+    NavFieldKey key = {
+        .kind = (int32_t)field->kind,
+        .side = field->perspectiveSide,
+        .targetId = field->keyTargetId,
+        .rangeQ = field->keyRangeQ,
+    };
+    if (field->kind == NAV_GOAL_KIND_FREE_GOAL) {
+        key.goalXQ = field->keyGoalXQ;
+        key.goalYQ = field->keyGoalYQ;
+    }
+    return key;
+}
+
+static bool nav_field_key_equal(const NavFieldKey *a, const NavFieldKey *b) {
+    return a->kind == b->kind && a->side == b->side &&
+           a->targetId == b->targetId && a->rangeQ == b->rangeQ &&
+           a->goalXQ == b->goalXQ && a->goalYQ == b->goalYQ;
+}
+
+static int32_t nav_field_index_home(const NavFieldIndex *index, const NavFieldKey *key) {
+    uint32_t h = 2166136261u;
+    const int32_t words[6] = { key->kind, key->side, key->targetId,
+                               key->rangeQ, key->goalXQ, key->goalYQ };
+    for (int i = 0; i < 6; ++i) {
+        h = (h ^ (uint32_t)words[i]) * 16777619u;  // FNV-1a over words
+    }
+    h ^= h >> 15;
+    return (int32_t)(h & (uint32_t)(index->capacity - 1));
+}
+
+// Field in cache slot `slot` (< cache->size).
+static inline NavField *nav_field_cache_slot(const NavFieldCache *cache, int32_t slot) {
+    return &cache->chunks[slot / NAV_FIELD_CACHE_CHUNK][slot % NAV_FIELD_CACHE_CHUNK];
+}
+
+// Cache slot holding `key`, or NAV_FIELD_SLOT_NONE.
+static int32_t nav_field_index_find(const NavFieldCache *cache, const NavFieldKey *key) {
+    const NavFieldIndex *index = &cache->index;
+    int32_t mask = index->capacity - 1;
+    int32_t pos = nav_field_index_home(index, key);
+    for (int32_t probes = 0; probes < index->capacity; ++probes) {
+        int32_t slot = index->slots[pos];
+        if (slot == NAV_FIELD_SLOT_NONE) break;
+        NavFieldKey here = nav_field_key_of(nav_field_cache_slot(cache, slot));
+        if (nav_field_key_equal(&here, key)) return slot;
+        pos = (pos + 1) & mask;
+    }
+    return NAV_FIELD_SLOT_NONE;
+}
+
+static void nav_field_index_insert(NavFieldCache *cache, int32_t slot) {
+    NavFieldIndex *index = &cache->index;
+    NavFieldKey key = nav_field_key_of(nav_field_cache_slot(cache, slot));
+    int32_t mask = index->capacity - 1;
+    int32_t pos = nav_field_index_home(index, &key);
+    for (int32_t probes = 0; probes < index->capacity; ++probes) {
+        if (index->slots[pos] == NAV_FIELD_SLOT_NONE) {
+            index->slots[pos] = slot;
+            return;
+        }
+        pos = (pos + 1) & mask;
+    }
+}
+
+// Drop cache slot `slot` (still holding its key) from the index.
+static void nav_field_index_remove(NavFieldCache *cache, int32_t slot) {
+    NavFieldIndex *index = &cache->index;
+    NavFieldKey key = nav_field_key_of(nav_field_cache_slot(cache, slot));
+    int32_t mask = index->capacity - 1;
+    int32_t pos = nav_field_index_home(index, &key);
+    int32_t probes = 0;
+    while (index->slots[pos] != slot) {
+        if (index->slots[pos] == NAV_FIELD_SLOT_NONE || ++probes >= index->capacity) return;
+        pos = (pos + 1) & mask;
+    }
+
+    // Backward-shift: pull later entries of the probe run into the hole
+    // unless their home lies cyclically inside (hole, entry].
+    int32_t hole = pos;
+    for (;;) {
+        pos = (pos + 1) & mask;
+        int32_t moved = index->slots[pos];
+        if (moved == NAV_FIELD_SLOT_NONE) break;
+        NavFieldKey movedKey = nav_field_key_of(nav_field_cache_slot(cache, moved));
+        int32_t home = nav_field_index_home(index, &movedKey);
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            index->slots[hole] = moved;
+            hole = pos;
+        }
+    }
+    index->slots[hole] = NAV_FIELD_SLOT_NONE;
+}
+
+// ---------- Field cache pool ----------
+
+// Allocate the bookkeeping for up to `capacity` fields. Field storage
+// itself comes in NAV_FIELD_CACHE_CHUNK blocks from nav_field_cache_acquire.
+static bool nav_field_cache_init(NavFieldCache *cache, int32_t capacity,
+                                 int32_t indexCapacity) {
+    int32_t chunkSlots = (capacity + NAV_FIELD_CACHE_CHUNK - 1) / NAV_FIELD_CACHE_CHUNK;
+    cache->chunks = calloc((size_t)chunkSlots, sizeof(NavField *));
+    cache->freeSlots = malloc((size_t)capacity * sizeof(int32_t));
+    cache->index.slots = malloc((size_t)indexCapacity * sizeof(int32_t));
+    if (!cache->chunks || !cache->freeSlots || !cache->index.slots) return false;
+    for (int32_t i = 0; i < indexCapacity; ++i) {
+        cache->index.slots[i] = NAV_FIELD_SLOT_NONE;
+    }
+    cache->index.capacity = indexCapacity;
+    cache->capacity = capacity;
+    return true;
+}
+
+static void nav_field_cache_destroy(NavFieldCache *cache) {
+    for (int32_t i = 0; i < cache->chunkCount; ++i) free(cache->chunks[i]);
+    free(cache->chunks);
+    free(cache->freeSlots);
+    free(cache->index.slots);
+    memset(cache, 0, sizeof(*cache));
+}
+
+// Take a slot for a new cache entry: a released slot, then a fresh one
+// (allocating its chunk on first use), then any slot not looked up this
+// frame (dropped from the index). NULL when every slot is in use this
+// frame. The slot number is written to *outSlot.
+static NavField *nav_field_cache_acquire(const NavFrame *nav, NavFieldCache *cache,
+                                         int32_t *outSlot) {
+    if (cache->freeCount > 0) {
+        *outSlot = cache->freeSlots[--cache->freeCount];
+        return nav_field_cache_slot(cache, *outSlot);
+    }
+    if (cache->size < cache->capacity) {
+        int32_t chunk = cache->size / NAV_FIELD_CACHE_CHUNK;
+        if (chunk == cache->chunkCount) {
+            cache->chunks[chunk] = calloc(NAV_FIELD_CACHE_CHUNK, sizeof(NavField));
+            if (cache->chunks[chunk]) cache->chunkCount++;
+        }
+        if (chunk < cache->chunkCount) {
+            *outSlot = cache->size++;
+            return nav_field_cache_slot(cache, *outSlot);
+        }
+    }
+    for (int32_t i = 0; i < cache->size; ++i) {
+        NavField *field = nav_field_cache_slot(cache, i);
+        if (field->useStamp != nav->frameCounter) {
+            if (field->built || field->pending) nav_field_index_remove(cache, i);
+            field->built = false;
+            field->pending = false;
+            *outSlot = i;
+            return field;
+        }
+    }
+    return NULL;
+}
+
+// Index a new entry the frame budget could not afford. Its key is already
+// stamped; the next build stage builds it ahead of every stale field.
+static void nav_field_cache_park(NavFrame *nav, NavFieldCache *cache,
+                                 NavField *field, int32_t slot) {
+    field->pending = true;
+    field->frameStamp = 0;
+    field->useStamp = nav->frameCounter;
+    nav_field_index_insert(cache, slot);
+    nav->scratch[0].stats.deferred++;
+}
+
+// Release entries that were not looked up during frame `lastFrame`.
+static void nav_field_cache_expire(NavFieldCache *cache, uint32_t lastFrame) {
+    cache->freeCount = 0;
+    for (int32_t i = cache->size - 1; i >= 0; --i) {
+        NavField *field = nav_field_cache_slot(cache, i);
+        bool indexed = field->built || field->pending;
+        if (indexed && field->useStamp == lastFrame) continue;
+        if (indexed) nav_field_index_remove(cache, i);
+        field->built = false;
+        field->pending = false;
+        cache->freeSlots[cache->freeCount++] = i;
+    }
 }
 
 // ---------- Lane corridor masking ----------
@@ -355,19 +1456,22 @@ static bool nav_cell_in_home_half(int32_t cellIndex, int side) {
 //
 // Returns the number of seed cells written. Zero means no reachable cell
 // exists inside the ring, which is a build-time error and the field will
-// contain only NAV_DIST_UNREACHABLE.
-static int32_t nav_seed_field_at(NavField *field,
+// contain only NAV_DIST_UNREACHABLE. The rectangle searched is added to
+// `box` when given.
+static int32_t nav_seed_field_at(NavField *field, NavCellBox *box,
                                   int32_t anchorCol, int32_t anchorRow,
                                   int32_t maxRadius) {
     int32_t seeded = 0;
     if (nav_in_bounds(anchorCol, anchorRow)) {
         int32_t idx = nav_index(anchorCol, anchorRow);
-        if (!field->hardBlocked[idx]) {
+        if (!nav_bit_test(field->hardBlocked, idx)) {
             field->distance[idx] = 0;
+            nav_box_include(box, anchorCol, anchorRow, anchorCol, anchorRow);
             return 1;
         }
     }
     for (int32_t r = 1; r <= maxRadius && seeded == 0; ++r) {
+        nav_box_include(box, anchorCol - r, anchorRow - r, anchorCol + r, anchorRow + r);
         for (int32_t dc = -r; dc <= r; ++dc) {
             for (int32_t dr = -r; dr <= r; ++dr) {
                 // Only visit the outer ring of this radius; inner cells
@@ -377,7 +1481,7 @@ static int32_t nav_seed_field_at(NavField *field,
                 int32_t ro = anchorRow + dr;
                 if (!nav_in_bounds(c, ro)) continue;
                 int32_t idx = nav_index(c, ro);
-                if (field->hardBlocked[idx]) continue;
+                if (nav_bit_test(field->hardBlocked, idx)) continue;
                 field->distance[idx] = 0;
                 seeded++;
             }
@@ -388,11 +1492,43 @@ static int32_t nav_seed_field_at(NavField *field,
 
 // ---------- Lane field builder ----------
 
-// Build a lane-march flow field seeded from the final authored waypoint of
+static void nav_lane_rasterize_corridor(NavLaneStatic *ls, const Battlefield *bf,
+                                        int side, int lane) {
+    memset(ls->corridorBlocked, 0, sizeof(ls->corridorBlocked));
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        if (!nav_cell_in_home_half(i, side)) continue;
+        float cx, cy;
+        nav_cell_center(i, &cx, &cy);
+        float d = nav_distance_to_lane_polyline(bf, side, lane, cx, cy);
+        if (d > NAV_HOME_LANE_CORRIDOR_RADIUS) {
+            nav_bit_set(ls->corridorBlocked, i);
+        }
+    }
+    ls->corridorReady = true;
+}
+
+// Snapshot the static blocker mask over the seed search window centered on
+// `anchor`. Out-of-board window cells stay clear.
+static void nav_lane_seed_window_snapshot(const NavFrame *nav, NavCellCoord anchor,
+                                          uint64_t *outBits) {
+    memset(outBits, 0, NAV_LANE_SEED_WINDOW_WORDS * sizeof(uint64_t));
+    for (int32_t dr = 0; dr < NAV_LANE_SEED_WINDOW; ++dr) {
+        for (int32_t dc = 0; dc < NAV_LANE_SEED_WINDOW; ++dc) {
+            int32_t col = anchor.col - NAV_LANE_SEED_SEARCH_CELLS + dc;
+            int32_t row = anchor.row - NAV_LANE_SEED_SEARCH_CELLS + dr;
+            if (!nav_in_bounds(col, row)) continue;
+            if (nav_bit_test(nav->staticBlockers.blocked, nav_index(col, row))) {
+                nav_bit_set(outBits, dr * NAV_LANE_SEED_WINDOW + dc);
+            }
+        }
+    }
+}
+
+// Seed a lane-march flow field from the final authored waypoint of
 // [side][lane]. Home-half cells outside the corridor are hard-blocked for
 // this field only; the global staticBlockers mask is left untouched.
-static void nav_build_lane_field(NavFrame *nav, const Battlefield *bf,
-                                  int side, int lane, NavField *field) {
+static void nav_seed_lane(NavFrame *nav, const Battlefield *bf,
+                          int side, int lane, NavField *field) {
     float seedX = bf->laneWaypoints[side][lane][LANE_WAYPOINT_COUNT - 1].v.x;
     float seedY = bf->laneWaypoints[side][lane][LANE_WAYPOINT_COUNT - 1].v.y;
     field->kind = NAV_GOAL_KIND_LANE_MARCH;
@@ -411,19 +1547,17 @@ static void nav_build_lane_field(NavFrame *nav, const Battlefield *bf,
     field->keyGoalYQ = 0;
     field->keyRangeQ = 0;
 
+    NavLaneStatic *ls = &nav->laneStatic[side][lane];
+    if (!ls->corridorReady) {
+        nav_lane_rasterize_corridor(ls, bf, side, lane);
+    }
+
     // Seed distance grid + per-field hard-blocked mask.
     for (int32_t i = 0; i < NAV_CELLS; ++i) {
         field->distance[i] = NAV_DIST_UNREACHABLE;
-        uint8_t hard = nav->staticBlockers.blocked[i];
-        if (!hard && nav_cell_in_home_half(i, side)) {
-            float cx, cy;
-            nav_cell_center(i, &cx, &cy);
-            float d = nav_distance_to_lane_polyline(bf, side, lane, cx, cy);
-            if (d > NAV_HOME_LANE_CORRIDOR_RADIUS) {
-                hard = 1;
-            }
-        }
-        field->hardBlocked[i] = hard;
+    }
+    for (int32_t w = 0; w < NAV_CELL_WORDS; ++w) {
+        field->hardBlocked[w] = nav->staticBlockers.blocked[w] | ls->corridorBlocked[w];
     }
 
     // Seed the goal region at the final authored waypoint on this lane.
@@ -434,23 +1568,80 @@ static void nav_build_lane_field(NavFrame *nav, const Battlefield *bf,
     // entity into a cell that is authored as impassable.
     int32_t seedCell = nav_cell_index_for_world(seedX, seedY);
     NavCellCoord anchor = nav_cell_coord(seedCell);
-    int32_t seeded = nav_seed_field_at(field, anchor.col, anchor.row, 4);
-    assert(seeded > 0 && "lane field seed region is fully blocked");
-    (void)seeded;
+    uint64_t window[NAV_LANE_SEED_WINDOW_WORDS];
+    nav_lane_seed_window_snapshot(nav, anchor, window);
+    if (ls->seedsReady &&
+        memcmp(window, ls->seedWindowStatic, sizeof(window)) == 0) {
+        for (int32_t i = 0; i < ls->seedCount; ++i) {
+            field->distance[ls->seedCells[i]] = 0;
+        }
+    } else {
+        int32_t seeded = nav_seed_field_at(field, NULL, anchor.col, anchor.row,
+                                           NAV_LANE_SEED_SEARCH_CELLS);
+        assert(seeded > 0 && "lane field seed region is fully blocked");
+        (void)seeded;
+
+        ls->seedCount = 0;
+        for (int32_t dr = -NAV_LANE_SEED_SEARCH_CELLS; dr <= NAV_LANE_SEED_SEARCH_CELLS; ++dr) {
+            for (int32_t dc = -NAV_LANE_SEED_SEARCH_CELLS; dc <= NAV_LANE_SEED_SEARCH_CELLS; ++dc) {
+                if (!nav_in_bounds(anchor.col + dc, anchor.row + dr)) continue;
+                int32_t idx = nav_index(anchor.col + dc, anchor.row + dr);
+                if (field->distance[idx] == 0) ls->seedCells[ls->seedCount++] = idx;
+            }
+        }
+        memcpy(ls->seedWindowStatic, window, sizeof(window));
+        ls->seedsReady = true;
+    }
+}
 
-    nav_integrate_field(nav, field);
+static void nav_build_lane_field(NavFrame *nav, NavScratch *s, const Battlefield *bf,
+                                  int side, int lane, NavField *field) {
+    nav_seed_lane(nav, bf, side, lane, field);
+    nav_integrate_field(nav, s, field, NULL);
     field->built = true;
 }
 
-const NavField *nav_get_or_build_lane_field(NavFrame *nav, const Battlefield *bf,
+// The corridor and seed window are covered by the static version, so the
+// final waypoint is the only seed input of a lane field.
+static NavSeedInputs nav_lane_seed_inputs(const Battlefield *bf, int side, int lane) {
+    NavSeedInputs seeds = { 0 };
+    seeds.anchorX = bf->laneWaypoints[side][lane][LANE_WAYPOINT_COUNT - 1].v.x;
+    seeds.anchorY = bf->laneWaypoints[side][lane][LANE_WAYPOINT_COUNT - 1].v.y;
+    return seeds;
+}
+
+// Refresh or rebuild the lane field for this frame.
+static void nav_update_lane_field(NavFrame *nav, NavScratch *s, const Battlefield *bf,
+                                  int side, int lane, NavField *field) {
+    NavSeedInputs seeds = nav_lane_seed_inputs(bf, side, lane);
+    if (!nav_field_refresh(nav, s, field, &seeds)) {
+        nav_build_lane_field(nav, s, bf, side, lane, field);
+        nav_field_reset_flow(field);
+        nav_field_mark_current(nav, field, &seeds);
+        s->stats.rebuilds++;
+    }
+}
+
+NavField *nav_get_or_build_lane_field(NavFrame *nav, const Battlefield *bf,
                                              int side, int lane) {
     if (!nav || !nav->initialized || !bf) return NULL;
     if (side < 0 || side >= 2) return NULL;
     if (lane < 0 || lane >= 3) return NULL;
     NavField *field = &nav->laneFields[side][lane];
-    if (!field->built) {
-        nav_build_lane_field(nav, bf, side, lane, field);
+    if (field->built && field->useStamp == nav->frameCounter) return field;
+
+    nav_seal_inputs(nav);
+    // Over budget, a lane field is only built when it has never been.
+    if (field->built && nav_budget_exhausted(nav)) {
+        NavSeedInputs seeds = nav_lane_seed_inputs(bf, side, lane);
+        if (!nav_field_is_current(nav, field, &seeds)) {
+            return nav_field_serve_stale(nav, field);
+        }
     }
+    uint64_t startNs = nav_budget_begin(nav);
+    nav_update_lane_field(nav, &nav->scratch[0], bf, side, lane, field);
+    nav_budget_end(nav, startNs);
+    field->useStamp = nav->frameCounter;
     return field;
 }
 
@@ -459,7 +1650,7 @@ const NavField *nav_find_lane_field(const NavFrame *nav, int side, int lane) {
     if (side < 0 || side >= 2) return NULL;
     if (lane < 0 || lane >= 3) return NULL;
     const NavField *field = &nav->laneFields[side][lane];
-    return field->built ? field : NULL;
+    return (field->built && field->useStamp == nav->frameCounter) ? field : NULL;
 }
 
 // ---------- Target / free-goal field builders ----------
@@ -470,8 +1661,9 @@ const NavField *nav_find_lane_field(const NavFrame *nav, int side, int lane) {
 static void nav_field_reset_for_build(const NavFrame *nav, NavField *field) {
     for (int32_t i = 0; i < NAV_CELLS; ++i) {
         field->distance[i] = NAV_DIST_UNREACHABLE;
-        field->hardBlocked[i] = nav->staticBlockers.blocked[i];
     }
+    field->settledLimit = NAV_DIST_UNREACHABLE;
+    memcpy(field->hardBlocked, nav->staticBlockers.blocked, sizeof(field->hardBlocked));
     field->innerRadius = 0.0f;
     field->arcCenterDeg = 0.0f;
     field->arcHalfDeg = 0.0f;
@@ -493,7 +1685,8 @@ static float nav_wrap_deg(float deg) {
 // combat_in_range for the attacker; the inner edge is one ribbon
 // thickness closer to the target, giving a 2*half-thickness-wide band
 // entirely inside combat range.
-static int32_t nav_seed_static_arc(NavField *field, const NavTargetGoal *goal) {
+static int32_t nav_seed_static_arc(NavField *field, const NavTargetGoal *goal,
+                                   NavCellBox *box) {
     int32_t seeded = 0;
     float maxR = goal->outerRadius;
     int32_t c0 = (int32_t)floorf((goal->targetX - maxR) / (float)NAV_CELL_SIZE);
@@ -504,6 +1697,7 @@ static int32_t nav_seed_static_arc(NavField *field, const NavTargetGoal *goal) {
     if (r0 < 0) r0 = 0;
     if (c1 > NAV_COLS - 1) c1 = NAV_COLS - 1;
     if (r1 > NAV_ROWS - 1) r1 = NAV_ROWS - 1;
+    nav_box_include(box, c0, r0, c1, r1);
     float innerR = goal->outerRadius - 2.0f * NAV_GOAL_RIBBON_HALF_THICKNESS;
     if (innerR < goal->innerRadiusMin) innerR = goal->innerRadiusMin;
     if (innerR < 0.0f) innerR = 0.0f;
@@ -519,7 +1713,7 @@ static int32_t nav_seed_static_arc(NavField *field, const NavTargetGoal *goal) {
             float delta = nav_wrap_deg(bearingDeg - goal->arcCenterDeg);
             if (fabsf(delta) > goal->arcHalfDeg) continue;
             int32_t idx = nav_index(col, row);
-            if (field->hardBlocked[idx]) continue;
+            if (nav_bit_test(field->hardBlocked, idx)) continue;
             field->distance[idx] = 0;
             seeded++;
         }
@@ -530,7 +1724,8 @@ static int32_t nav_seed_static_arc(NavField *field, const NavTargetGoal *goal) {
 // Seed a one-cell-thick melee ring. outer edge is clamped to exactly
 // `outerRadius` (so every seeded cell satisfies combat_in_range); inner
 // edge is one cell closer.
-static int32_t nav_seed_melee_ring(NavField *field, const NavTargetGoal *goal) {
+static int32_t nav_seed_melee_ring(NavField *field, const NavTargetGoal *goal,
+                                   NavCellBox *box) {
     int32_t seeded = 0;
     float outerR = goal->outerRadius;
     int32_t c0 = (int32_t)floorf((goal->targetX - outerR) / (float)NAV_CELL_SIZE);
@@ -541,6 +1736,7 @@ static int32_t nav_seed_melee_ring(NavField *field, const NavTargetGoal *goal) {
     if (r0 < 0) r0 = 0;
     if (c1 > NAV_COLS - 1) c1 = NAV_COLS - 1;
     if (r1 > NAV_ROWS - 1) r1 = NAV_ROWS - 1;
+    nav_box_include(box, c0, r0, c1, r1);
     float innerR = goal->outerRadius - (float)NAV_CELL_SIZE;
     if (innerR < goal->innerRadiusMin) innerR = goal->innerRadiusMin;
     if (innerR < 0.0f) innerR = 0.0f;
@@ -553,7 +1749,7 @@ static int32_t nav_seed_melee_ring(NavField *field, const NavTargetGoal *goal) {
             float d = sqrtf(dx * dx + dy * dy);
             if (d < innerR || d > outerR) continue;
             int32_t idx = nav_index(col, row);
-            if (field->hardBlocked[idx]) continue;
+            if (nav_bit_test(field->hardBlocked, idx)) continue;
             field->distance[idx] = 0;
             seeded++;
         }
@@ -562,7 +1758,8 @@ static int32_t nav_seed_melee_ring(NavField *field, const NavTargetGoal *goal) {
 }
 
 // Seed a solid disk: every unblocked cell within outerRadius of the goal.
-static int32_t nav_seed_disk(NavField *field, const NavTargetGoal *goal) {
+static int32_t nav_seed_disk(NavField *field, const NavTargetGoal *goal,
+                             NavCellBox *box) {
     int32_t seeded = 0;
     float r = goal->outerRadius;
     if (r < (float)NAV_CELL_SIZE * 0.5f) r = (float)NAV_CELL_SIZE * 0.5f;
@@ -574,6 +1771,7 @@ static int32_t nav_seed_disk(NavField *field, const NavTargetGoal *goal) {
     if (r0 < 0) r0 = 0;
     if (c1 > NAV_COLS - 1) c1 = NAV_COLS - 1;
     if (r1 > NAV_ROWS - 1) r1 = NAV_ROWS - 1;
+    nav_box_include(box, c0, r0, c1, r1);
     float r2 = r * r;
     for (int32_t row = r0; row <= r1; ++row) {
         float cellY = (float)row * (float)NAV_CELL_SIZE + (float)NAV_CELL_SIZE * 0.5f;
@@ -583,7 +1781,7 @@ static int32_t nav_seed_disk(NavField *field, const NavTargetGoal *goal) {
             float dy = cellY - goal->targetY;
             if (dx * dx + dy * dy > r2) continue;
             int32_t idx = nav_index(col, row);
-            if (field->hardBlocked[idx]) continue;
+            if (nav_bit_test(field->hardBlocked, idx)) continue;
             field->distance[idx] = 0;
             seeded++;
         }
@@ -593,7 +1791,7 @@ static int32_t nav_seed_disk(NavField *field, const NavTargetGoal *goal) {
     if (seeded == 0) {
         int32_t anchorCell = nav_cell_index_for_world(goal->targetX, goal->targetY);
         NavCellCoord anchor = nav_cell_coord(anchorCell);
-        seeded = nav_seed_field_at(field, anchor.col, anchor.row, 4);
+        seeded = nav_seed_field_at(field, box, anchor.col, anchor.row, 4);
     }
     return seeded;
 }
@@ -619,25 +1817,24 @@ static float nav_free_goal_seed_radius(float stopRadius) {
 
 // ---------- Entity position snapshot (open-addressed hash table) ----------
 //
-// Entity ids grow monotonically and can exceed MAX_ENTITIES*2 in long
-// matches, so the snapshot cannot be a raw-indexed array. We use a small
-// open-addressed table of NAV_ENTITY_SNAP_CAPACITY slots (power of two,
-// guaranteed <=50% load factor at the MAX_ENTITIES*2 live cap) and linear
-// probe from a cheap multiplicative hash.
+// Entity ids are sparse (spawn serial above the pool slot), so the snapshot
+// cannot be a raw-indexed array. We use an open-addressed table of
+// entitySnapCapacity slots (power of two, guaranteed <=50% load factor at
+// the live entity cap) and linear probe from a cheap multiplicative hash.
 
-static inline int32_t nav_entity_probe_slot(int32_t entityId) {
+static inline int32_t nav_entity_probe_slot(const NavFrame *nav, int32_t entityId) {
     uint32_t h = (uint32_t)entityId * 2654435761u;  // Knuth multiplicative
-    return (int32_t)(h & (NAV_ENTITY_SNAP_CAPACITY - 1));
+    return (int32_t)(h & (uint32_t)(nav->entitySnapCapacity - 1));
 }
 
 static int32_t nav_entity_snap_find(const NavFrame *nav, int32_t entityId) {
     if (entityId < 0) return -1;
-    int32_t slot = nav_entity_probe_slot(entityId);
-    for (int32_t probes = 0; probes < NAV_ENTITY_SNAP_CAPACITY; ++probes) {
+    int32_t slot = nav_entity_probe_slot(nav, entityId);
+    for (int32_t probes = 0; probes < nav->entitySnapCapacity; ++probes) {
         int32_t idHere = nav->entityPosId[slot];
         if (idHere == entityId) return slot;
         if (idHere == NAV_ENTITY_ID_NONE) return -1;
-        slot = (slot + 1) & (NAV_ENTITY_SNAP_CAPACITY - 1);
+        slot = (slot + 1) & (nav->entitySnapCapacity - 1);
     }
     return -1;
 }
@@ -645,8 +1842,8 @@ static int32_t nav_entity_snap_find(const NavFrame *nav, int32_t entityId) {
 static void nav_entity_snap_insert(NavFrame *nav, int32_t entityId,
                                      float x, float y) {
     if (entityId < 0) return;
-    int32_t slot = nav_entity_probe_slot(entityId);
-    for (int32_t probes = 0; probes < NAV_ENTITY_SNAP_CAPACITY; ++probes) {
+    int32_t slot = nav_entity_probe_slot(nav, entityId);
+    for (int32_t probes = 0; probes < nav->entitySnapCapacity; ++probes) {
         int32_t idHere = nav->entityPosId[slot];
         if (idHere == NAV_ENTITY_ID_NONE || idHere == entityId) {
             nav->entityPosId[slot] = entityId;
@@ -654,7 +1851,7 @@ static void nav_entity_snap_insert(NavFrame *nav, int32_t entityId,
             nav->entityPosY[slot] = y;
             return;
         }
-        slot = (slot + 1) & (NAV_ENTITY_SNAP_CAPACITY - 1);
+        slot = (slot + 1) & (nav->entitySnapCapacity - 1);
     }
 }
 
@@ -685,6 +1882,34 @@ static void nav_resolve_target_position(const NavFrame *nav,
                                 outX, outY);
 }
 
+static NavSeedInputs nav_target_seed_inputs(const NavFrame *nav,
+                                            const NavTargetGoal *goal) {
+    NavSeedInputs seeds = { 0 };
+    nav_resolve_target_position(nav, goal, &seeds.anchorX, &seeds.anchorY);
+    seeds.outerRadius = goal->outerRadius;
+    seeds.arcCenterDeg = goal->arcCenterDeg;
+    seeds.arcHalfDeg = goal->arcHalfDeg;
+    seeds.targetBodyRadius = goal->targetBodyRadius;
+    seeds.innerRadiusMin = goal->innerRadiusMin;
+    return seeds;
+}
+
+static NavSeedInputs nav_free_goal_seed_inputs(const NavFrame *nav,
+                                               const NavFreeGoalRequest *request) {
+    NavSeedInputs seeds = { 0 };
+    seeds.anchorX = request->goalX;
+    seeds.anchorY = request->goalY;
+    seeds.outerRadius = request->stopRadius;
+    seeds.carveTargetId = request->carveTargetId;
+    if (request->carveTargetId >= 0) {
+        nav_resolve_entity_position(nav, request->carveTargetId,
+                                    request->carveCenterX, request->carveCenterY,
+                                    &seeds.carveX, &seeds.carveY);
+        seeds.carveInnerRadius = request->carveInnerRadius;
+    }
+    return seeds;
+}
+
 static void nav_target_field_stamp_key(NavField *field, const NavTargetGoal *goal,
                                          int32_t rangeQ) {
     field->kind = goal->kind;
@@ -724,6 +1949,33 @@ static void nav_free_goal_field_stamp_key(NavField *field,
     field->keyGoalYQ = (int32_t)(request->goalY * 4.0f + 0.5f);
 }
 
+// Lookup keys matching what the stamp_key helpers above record.
+static NavFieldKey nav_target_field_key(const NavTargetGoal *goal) {
+    NavFieldKey key = {
+        .kind = (int32_t)goal->kind,
+        .side = goal->perspectiveSide,
+        .targetId = goal->targetId,
+        .rangeQ = nav_range_q(goal->outerRadius),
+    };
+    return key;
+}
+
+static NavFieldKey nav_free_goal_field_key(const NavFreeGoalRequest *request) {
+    // Key on the exact goal coordinates at 0.25 px granularity, not on
+    // the containing cell. Two goals inside the same 32 px cell that are
+    // more than 0.25 px apart build distinct fields; closer than 0.25 px
+    // they alias, which is tighter than any gameplay-visible difference.
+    NavFieldKey key = {
+        .kind = NAV_GOAL_KIND_FREE_GOAL,
+        .side = request->perspectiveSide,
+        .targetId = request->carveTargetId,
+        .rangeQ = nav_range_q(request->stopRadius),
+        .goalXQ = (int32_t)(request->goalX * 4.0f + 0.5f),
+        .goalYQ = (int32_t)(request->goalY * 4.0f + 0.5f),
+    };
+    return key;
+}
+
 static void nav_field_carve_target_owned_blockers(const NavFrame *nav,
                                                   NavField *field,
                                                   int32_t targetId,
@@ -738,7 +1990,7 @@ static void nav_field_carve_target_owned_blockers(const NavFrame *nav,
 
     for (int32_t idx = 0; idx < NAV_CELLS; ++idx) {
         if (nav->staticBlockers.blockerSrc[idx] != targetId) continue;
-        if (!field->hardBlocked[idx]) continue;
+        if (!nav_bit_test(field->hardBlocked, idx)) continue;
 
         NavCellCoord c = nav_cell_coord(idx);
         float cellX = (float)c.col * (float)NAV_CELL_SIZE +
@@ -748,13 +2000,16 @@ static void nav_field_carve_target_owned_blockers(const NavFrame *nav,
         float dx = cellX - centerX;
         float dy = cellY - centerY;
         if (dx * dx + dy * dy >= innerSq) {
-            field->hardBlocked[idx] = 0;
+            nav_bit_clear(field->hardBlocked, idx);
         }
     }
 }
 
-static void nav_build_target_field(NavFrame *nav, NavField *field,
-                                     const NavTargetGoal *goalIn) {
+// Seed a target field for `goalIn`. Returns the number of seed cells; zero
+// leaves the field all-unreachable. The seeded area is added to `box` when
+// given.
+static int32_t nav_seed_target(const NavFrame *nav, NavField *field,
+                               const NavTargetGoal *goalIn, NavCellBox *box) {
     // Resolve the target position from the frame snapshot when possible,
     // so every attacker pursuing the same target in the same frame seeds
     // its field against the same frozen pivot regardless of update order.
@@ -792,14 +2047,14 @@ static void nav_build_target_field(NavFrame *nav, NavField *field,
     int32_t seeded = 0;
     switch (goal.kind) {
         case NAV_GOAL_KIND_STATIC_ATTACK:
-            seeded = nav_seed_static_arc(field, &goal);
+            seeded = nav_seed_static_arc(field, &goal, box);
             break;
         case NAV_GOAL_KIND_MELEE_RING:
-            seeded = nav_seed_melee_ring(field, &goal);
+            seeded = nav_seed_melee_ring(field, &goal, box);
             break;
         case NAV_GOAL_KIND_DIRECT_RANGE:
         case NAV_GOAL_KIND_FREE_GOAL:
-            seeded = nav_seed_disk(field, &goal);
+            seeded = nav_seed_disk(field, &goal, box);
             break;
         default:
             break;
@@ -813,19 +2068,50 @@ static void nav_build_target_field(NavFrame *nav, NavField *field,
     if (seeded == 0) {
         int32_t anchorCell = nav_cell_index_for_world(goal.targetX, goal.targetY);
         NavCellCoord anchor = nav_cell_coord(anchorCell);
-        seeded = nav_seed_field_at(field, anchor.col, anchor.row, 6);
+        seeded = nav_seed_field_at(field, box, anchor.col, anchor.row, 6);
     }
-    if (seeded == 0) {
-        // Still nothing: leave the field all-unreachable. Callers observe
-        // a zero flow and stand in place instead of crashing.
-        field->built = true;
-        return;
+    return seeded;
+}
+
+// Integrate a freshly seeded target / free-goal field, query-bounded when
+// its requester list allows.
+static void nav_integrate_goal_field(const NavFrame *nav, NavScratch *s, NavField *field,
+                                     const NavCellBox *seedBox) {
+    if (nav_integrate_query(nav, s, field, seedBox, nav_field_query_bounded(nav, field))) {
+        s->stats.boundedBuilds++;
+    }
+}
+
+static void nav_build_target_field(const NavFrame *nav, NavScratch *s, NavField *field,
+                                     const NavTargetGoal *goal) {
+    // With no seeds the field stays all-unreachable. Callers observe a
+    // zero flow and stand in place instead of crashing.
+    NavCellBox box = NAV_BOX_EMPTY;
+    if (nav_seed_target(nav, field, goal, &box) > 0) {
+        nav_integrate_goal_field(nav, s, field, &box);
     }
-    nav_integrate_field(nav, field);
     field->built = true;
 }
 
-const NavField *nav_get_or_build_target_field(NavFrame *nav, const Battlefield *bf,
+// Refresh or rebuild a target field for this frame. A field from an earlier
+// frame is reused while its target pivot, goal geometry, static mask and
+// density are unchanged, repaired when only density moved, and rebuilt in
+// place otherwise.
+static void nav_update_target_field(const NavFrame *nav, NavScratch *s, NavField *field,
+                                    const NavTargetGoal *goal) {
+    NavSeedInputs seeds = nav_target_seed_inputs(nav, goal);
+    if (nav_field_refresh(nav, s, field, &seeds)) {
+        // Goal metadata for debug draw follows the latest caller.
+        nav_target_field_stamp_key(field, goal, nav_range_q(goal->outerRadius));
+        return;
+    }
+    nav_build_target_field(nav, s, field, goal);
+    nav_field_reset_flow(field);
+    nav_field_mark_current(nav, field, &seeds);
+    s->stats.rebuilds++;
+}
+
+NavField *nav_get_or_build_target_field(NavFrame *nav, const Battlefield *bf,
                                                 const NavTargetGoal *goal) {
     if (!nav || !nav->initialized || !bf || !goal) return NULL;
     int perspective = goal->perspectiveSide;
@@ -833,25 +2119,55 @@ const NavField *nav_get_or_build_target_field(NavFrame *nav, const Battlefield *
     // Cache key: (targetId, kind, rangeQ (0.25 px), side). rangeQ is
     // derived from the exact caller radius so the seed set always
     // matches combat_in_range at query time.
-    int32_t rangeQ = nav_range_q(goal->outerRadius);
-    for (int32_t i = 0; i < nav->targetCacheSize; ++i) {
-        NavField *f = &nav->targetFields[i];
-        if (!f->built) continue;
-        if (f->kind != goal->kind) continue;
-        if (f->keyTargetId != goal->targetId) continue;
-        if (f->keyRangeQ != rangeQ) continue;
-        if (f->perspectiveSide != (int16_t)perspective) continue;
-        return f;
-    }
-    if (nav->targetCacheSize >= NAV_TARGET_CACHE_CAPACITY) {
-        // Overflow: Phase 3 will log once; Phase 2 fails hard in debug
-        // to catch any case where a test inadvertently creates > 128
-        // distinct (target, kind, rangeClass, side) keys per frame.
-        assert(0 && "NavFrame target field cache overflow");
-        return NULL;
+    NavFieldKey key = nav_target_field_key(goal);
+    NavField *field = NULL;
+    int32_t slot = nav_field_index_find(&nav->targetCache, &key);
+    bool isNew = slot == NAV_FIELD_SLOT_NONE;
+    if (!isNew) {
+        field = nav_field_cache_slot(&nav->targetCache, slot);
+        nav_field_note_requester(nav, field, goal->hasRequester,
+                                 goal->requesterX, goal->requesterY);
+        if (field->useStamp == nav->frameCounter) {
+            if (!field->built) return NULL;
+            nav_field_cover_requester(nav, field, goal->hasRequester,
+                                      goal->requesterX, goal->requesterY);
+            return field;
+        }
+    } else {
+        field = nav_field_cache_acquire(nav, &nav->targetCache, &slot);
+        if (!field) {
+            // Overflow: Phase 3 will log once; Phase 2 fails hard in debug
+            // to catch any case where a test inadvertently creates more
+            // distinct (target, kind, rangeClass, side) keys per frame than
+            // there are live entities.
+            assert(0 && "NavFrame target field cache overflow");
+            return NULL;
+        }
+        nav_field_note_requester(nav, field, goal->hasRequester,
+                                 goal->requesterX, goal->requesterY);
+        if (nav_budget_exhausted(nav)) {
+            nav_target_field_stamp_key(field, goal, nav_range_q(goal->outerRadius));
+            nav_field_cache_park(nav, &nav->targetCache, field, slot);
+            return NULL;
+        }
     }
-    NavField *field = &nav->targetFields[nav->targetCacheSize++];
-    nav_build_target_field(nav, field, goal);
+
+    nav_seal_inputs(nav);
+    if (!isNew && nav_budget_exhausted(nav)) {
+        NavSeedInputs seeds = nav_target_seed_inputs(nav, goal);
+        if (!nav_field_is_current(nav, field, &seeds)) {
+            return nav_field_serve_stale(nav, field);
+        }
+    }
+    uint64_t startNs = nav_budget_begin(nav);
+    nav_update_target_field(nav, &nav->scratch[0], field, goal);
+    nav_budget_end(nav, startNs);
+    if (isNew) {
+        nav_field_index_insert(&nav->targetCache, slot);
+    }
+    field->useStamp = nav->frameCounter;
+    nav_field_cover_requester(nav, field, goal->hasRequester,
+                              goal->requesterX, goal->requesterY);
     return field;
 }
 
@@ -860,32 +2176,41 @@ const NavField *nav_find_target_field(const NavFrame *nav,
     if (!nav || !nav->initialized || !goal) return NULL;
     int perspective = goal->perspectiveSide;
     if (perspective < 0 || perspective > 1) return NULL;
-    int32_t rangeQ = nav_range_q(goal->outerRadius);
-    for (int32_t i = 0; i < nav->targetCacheSize; ++i) {
-        const NavField *f = &nav->targetFields[i];
-        if (!f->built) continue;
-        if (f->kind != goal->kind) continue;
-        if (f->keyTargetId != goal->targetId) continue;
-        if (f->keyRangeQ != rangeQ) continue;
-        if (f->perspectiveSide != (int16_t)perspective) continue;
-        return f;
-    }
-    return NULL;
+    NavFieldKey key = nav_target_field_key(goal);
+    int32_t slot = nav_field_index_find(&nav->targetCache, &key);
+    if (slot == NAV_FIELD_SLOT_NONE) return NULL;
+    const NavField *f = nav_field_cache_slot(&nav->targetCache, slot);
+    return (f->built && f->useStamp == nav->frameCounter) ? f : NULL;
 }
 
-static void nav_build_free_goal_field(NavFrame *nav, NavField *field,
-                                      const NavFreeGoalRequest *request) {
-    float seedRadius = nav_free_goal_seed_radius(request->stopRadius);
+// Seed the goal disk of a free-goal field, widening to the nearest free
+// cells when the disk is fully blocked.
+static int32_t nav_seed_free_goal_disk(NavField *field, float goalX, float goalY,
+                                       float stopRadius, int16_t perspectiveSide,
+                                       NavCellBox *box) {
     NavTargetGoal goal = {
         .kind = NAV_GOAL_KIND_FREE_GOAL,
-        .targetX = request->goalX,
-        .targetY = request->goalY,
-        .outerRadius = seedRadius,
+        .targetX = goalX,
+        .targetY = goalY,
+        .outerRadius = nav_free_goal_seed_radius(stopRadius),
         .arcCenterDeg = 0.0f,
         .arcHalfDeg = 0.0f,
         .targetId = -1,
-        .perspectiveSide = request->perspectiveSide,
+        .perspectiveSide = perspectiveSide,
     };
+    int32_t seeded = nav_seed_disk(field, &goal, box);
+    if (seeded == 0) {
+        int32_t anchorCell = nav_cell_index_for_world(goal.targetX, goal.targetY);
+        NavCellCoord anchor = nav_cell_coord(anchorCell);
+        seeded = nav_seed_field_at(field, box, anchor.col, anchor.row, 6);
+    }
+    return seeded;
+}
+
+// Seed a free-goal field for `request`. Returns the number of seed cells and
+// adds the seeded area to `box` when given.
+static int32_t nav_seed_free_goal(const NavFrame *nav, NavField *field,
+                                  const NavFreeGoalRequest *request, NavCellBox *box) {
     int32_t rangeQ = nav_range_q(request->stopRadius);
 
     nav_field_reset_for_build(nav, field);
@@ -903,49 +2228,84 @@ static void nav_build_free_goal_field(NavFrame *nav, NavField *field,
                                               request->carveInnerRadius);
     }
 
-    int32_t seeded = nav_seed_disk(field, &goal);
-    if (seeded == 0) {
-        int32_t anchorCell = nav_cell_index_for_world(goal.targetX, goal.targetY);
-        NavCellCoord anchor = nav_cell_coord(anchorCell);
-        seeded = nav_seed_field_at(field, anchor.col, anchor.row, 6);
+    return nav_seed_free_goal_disk(field, request->goalX, request->goalY,
+                                   request->stopRadius, request->perspectiveSide, box);
+}
+
+static void nav_build_free_goal_field(const NavFrame *nav, NavScratch *s, NavField *field,
+                                      const NavFreeGoalRequest *request) {
+    NavCellBox box = NAV_BOX_EMPTY;
+    if (nav_seed_free_goal(nav, field, request, &box) > 0) {
+        nav_integrate_goal_field(nav, s, field, &box);
     }
-    if (seeded == 0) {
-        field->built = true;
+    field->built = true;
+}
+
+static void nav_update_free_goal_field(const NavFrame *nav, NavScratch *s,
+                                       NavField *field,
+                                       const NavFreeGoalRequest *request) {
+    NavSeedInputs seeds = nav_free_goal_seed_inputs(nav, request);
+    if (nav_field_refresh(nav, s, field, &seeds)) {
+        nav_free_goal_field_stamp_key(field, request, nav_range_q(request->stopRadius));
         return;
     }
-    nav_integrate_field(nav, field);
-    field->built = true;
+    nav_build_free_goal_field(nav, s, field, request);
+    nav_field_reset_flow(field);
+    nav_field_mark_current(nav, field, &seeds);
+    s->stats.rebuilds++;
 }
 
-const NavField *nav_get_or_build_free_goal_field(NavFrame *nav,
+NavField *nav_get_or_build_free_goal_field(NavFrame *nav,
                                                  const Battlefield *bf,
                                                  const NavFreeGoalRequest *request) {
     if (!nav || !nav->initialized || !bf || !request) return NULL;
     if (request->perspectiveSide < 0 || request->perspectiveSide > 1) return NULL;
-    // Key on the exact goal coordinates at 0.25 px granularity, not on
-    // the containing cell. Two goals inside the same 32 px cell that are
-    // more than 0.25 px apart build distinct fields; closer than 0.25 px
-    // they alias, which is tighter than any gameplay-visible difference.
-    int32_t goalXQ = (int32_t)(request->goalX * 4.0f + 0.5f);
-    int32_t goalYQ = (int32_t)(request->goalY * 4.0f + 0.5f);
-    int32_t rangeQ = nav_range_q(request->stopRadius);
-    for (int32_t i = 0; i < nav->freeGoalCacheSize; ++i) {
-        NavField *f = &nav->freeGoalFields[i];
-        if (!f->built) continue;
-        if (f->kind != NAV_GOAL_KIND_FREE_GOAL) continue;
-        if (f->keyGoalXQ != goalXQ) continue;
-        if (f->keyGoalYQ != goalYQ) continue;
-        if (f->keyRangeQ != rangeQ) continue;
-        if (f->perspectiveSide != request->perspectiveSide) continue;
-        if (f->keyTargetId != request->carveTargetId) continue;
-        return f;
-    }
-    if (nav->freeGoalCacheSize >= NAV_FREE_GOAL_CACHE_CAPACITY) {
-        assert(0 && "NavFrame free-goal field cache overflow");
-        return NULL;
+    NavFieldKey key = nav_free_goal_field_key(request);
+    NavField *field = NULL;
+    int32_t slot = nav_field_index_find(&nav->freeGoalCache, &key);
+    bool isNew = slot == NAV_FIELD_SLOT_NONE;
+    if (!isNew) {
+        field = nav_field_cache_slot(&nav->freeGoalCache, slot);
+        nav_field_note_requester(nav, field, request->hasRequester,
+                                 request->requesterX, request->requesterY);
+        if (field->useStamp == nav->frameCounter) {
+            if (!field->built) return NULL;
+            nav_field_cover_requester(nav, field, request->hasRequester,
+                                      request->requesterX, request->requesterY);
+            return field;
+        }
+    } else {
+        field = nav_field_cache_acquire(nav, &nav->freeGoalCache, &slot);
+        if (!field) {
+            assert(0 && "NavFrame free-goal field cache overflow");
+            return NULL;
+        }
+        nav_field_note_requester(nav, field, request->hasRequester,
+                                 request->requesterX, request->requesterY);
+        if (nav_budget_exhausted(nav)) {
+            nav_free_goal_field_stamp_key(field, request, nav_range_q(request->stopRadius));
+            field->seedInputs = nav_free_goal_seed_inputs(nav, request);
+            nav_field_cache_park(nav, &nav->freeGoalCache, field, slot);
+            return NULL;
+        }
+    }
+
+    nav_seal_inputs(nav);
+    if (!isNew && nav_budget_exhausted(nav)) {
+        NavSeedInputs seeds = nav_free_goal_seed_inputs(nav, request);
+        if (!nav_field_is_current(nav, field, &seeds)) {
+            return nav_field_serve_stale(nav, field);
+        }
     }
-    NavField *field = &nav->freeGoalFields[nav->freeGoalCacheSize++];
-    nav_build_free_goal_field(nav, field, request);
+    uint64_t startNs = nav_budget_begin(nav);
+    nav_update_free_goal_field(nav, &nav->scratch[0], field, request);
+    nav_budget_end(nav, startNs);
+    if (isNew) {
+        nav_field_index_insert(&nav->freeGoalCache, slot);
+    }
+    field->useStamp = nav->frameCounter;
+    nav_field_cover_requester(nav, field, request->hasRequester,
+                              request->requesterX, request->requesterY);
     return field;
 }
 
@@ -953,23 +2313,408 @@ const NavField *nav_find_free_goal_field(const NavFrame *nav,
                                          const NavFreeGoalRequest *request) {
     if (!nav || !nav->initialized || !request) return NULL;
     if (request->perspectiveSide < 0 || request->perspectiveSide > 1) return NULL;
-    int32_t goalXQ = (int32_t)(request->goalX * 4.0f + 0.5f);
-    int32_t goalYQ = (int32_t)(request->goalY * 4.0f + 0.5f);
-    int32_t rangeQ = nav_range_q(request->stopRadius);
-    for (int32_t i = 0; i < nav->freeGoalCacheSize; ++i) {
-        const NavField *f = &nav->freeGoalFields[i];
-        if (!f->built) continue;
-        if (f->kind != NAV_GOAL_KIND_FREE_GOAL) continue;
-        if (f->keyGoalXQ != goalXQ) continue;
-        if (f->keyGoalYQ != goalYQ) continue;
-        if (f->keyRangeQ != rangeQ) continue;
-        if (f->perspectiveSide != request->perspectiveSide) continue;
-        if (f->keyTargetId != request->carveTargetId) continue;
-        return f;
+    NavFieldKey key = nav_free_goal_field_key(request);
+    int32_t slot = nav_field_index_find(&nav->freeGoalCache, &key);
+    if (slot == NAV_FIELD_SLOT_NONE) return NULL;
+    const NavField *f = nav_field_cache_slot(&nav->freeGoalCache, slot);
+    return (f->built && f->useStamp == nav->frameCounter) ? f : NULL;
+}
+
+// ---------- Harvest fields ----------
+
+// Seed every source of `harvest` into its field and label the seed cells.
+// The seeders only write zeros, so the cells earlier sources claimed are
+// parked at distance 1 meanwhile: whatever reads 0 after seeding source k is
+// exactly source k's own free-goal seed set, overlaps with earlier sources
+// included.
+static void nav_seed_harvest(const NavFrame *nav, NavHarvestField *harvest,
+                             int side, NavCellBox *box) {
+    NavField *field = &harvest->field;
+    const NavHarvestRequest *request = &harvest->request;
+    nav_field_reset_for_build(nav, field);
+    memset(harvest->sourceMask, 0, sizeof(harvest->sourceMask));
+    for (int32_t k = 0; k < request->sourceCount; ++k) {
+        NavCellBox sourceBox = NAV_BOX_EMPTY;
+        nav_seed_free_goal_disk(field, request->sourceX[k], request->sourceY[k],
+                                request->stopRadius, (int16_t)side, &sourceBox);
+        for (int32_t row = sourceBox.r0; row <= sourceBox.r1; ++row) {
+            for (int32_t col = sourceBox.c0; col <= sourceBox.c1; ++col) {
+                int32_t idx = nav_index(col, row);
+                if (field->distance[idx] != 0) continue;
+                field->distance[idx] = 1;
+                harvest->sourceMask[idx] |= (uint8_t)(1u << k);
+            }
+        }
+        nav_box_include(box, sourceBox.c0, sourceBox.r0, sourceBox.c1, sourceBox.r1);
+    }
+    for (int32_t row = box->r0; row <= box->r1; ++row) {
+        for (int32_t col = box->c0; col <= box->c1; ++col) {
+            int32_t idx = nav_index(col, row);
+            if (harvest->sourceMask[idx] != 0) field->distance[idx] = 0;
+        }
+    }
+}
+
+// Cells in ascending distance order for nav_label_harvest: distance in the
+// high half of the key, cell index in the low half.
+_Static_assert(NAV_CELLS <= 0x10000, "harvest order keys pack the cell index in 16 bits");
+
+static int nav_harvest_order_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Label every reached cell with the sources whose own fields attain its
+// distance: the union of the labels of the neighbors it is cheapest to
+// enter from. Cells go in ascending distance, so those neighbors are
+// labelled first. A pass after integration keeps the kernel unchanged for
+// every other field.
+static void nav_label_harvest(const NavFrame *nav, NavHarvestField *harvest) {
+    const NavField *field = &harvest->field;
+    int allySide = field->perspectiveSide;
+    uint32_t order[NAV_CELLS];
+    int32_t count = 0;
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        uint32_t d = field->distance[i];
+        if (d == 0 || d == NAV_DIST_UNREACHABLE) continue;
+        order[count++] = (d << 16) | (uint32_t)i;
+    }
+    qsort(order, (size_t)count, sizeof(order[0]), nav_harvest_order_compare);
+
+    for (int32_t j = 0; j < count; ++j) {
+        int32_t cell = (int32_t)(order[j] & 0xFFFFu);
+        int32_t d = (int32_t)(order[j] >> 16);
+        NavCellCoord coord = nav_cell_coord(cell);
+        int32_t penalty = nav_density_penalty(nav, cell, allySide);
+        uint8_t mask = 0;
+        for (int n = 0; n < 8; ++n) {
+            int32_t ucol = coord.col + NAV_NEIGHBORS[n].dcol;
+            int32_t urow = coord.row + NAV_NEIGHBORS[n].drow;
+            if (!nav_in_bounds(ucol, urow)) continue;
+            int32_t u = nav_index(ucol, urow);
+            int32_t du = field->distance[u];
+            if (du >= d) continue;
+            int32_t target = -1;
+            int32_t base = nav_step_base_cost(field, nav_cell_coord(u),
+                                              nav_neighbor_opposite(n), &target);
+            if (base < 0) continue;
+            if (nav_dist_saturate(du + base + penalty) == d) mask |= harvest->sourceMask[u];
+        }
+        harvest->sourceMask[cell] = mask;
+    }
+}
+
+static void nav_build_harvest_field(const NavFrame *nav, NavScratch *s,
+                                    NavHarvestField *harvest, int side) {
+    NavField *field = &harvest->field;
+    NavCellBox box = NAV_BOX_EMPTY;
+    nav_seed_harvest(nav, harvest, side, &box);
+    field->kind = NAV_GOAL_KIND_FREE_GOAL;
+    field->perspectiveSide = (int16_t)side;
+    field->stopRadius = harvest->request.stopRadius;
+    field->anchorX = 0.0f;
+    field->anchorY = 0.0f;
+    if (harvest->request.sourceCount > 0) {
+        nav_integrate_field(nav, s, field, &box);
+        nav_label_harvest(nav, harvest);
+    }
+    nav_field_reset_flow(field);
+    nav_field_mark_current(nav, field, &field->seedInputs);
+}
+
+const NavHarvestField *nav_get_or_build_harvest_field(NavFrame *nav, int side,
+                                                      const NavHarvestRequest *request) {
+    if (!nav || !nav->initialized || !request) return NULL;
+    if (side < 0 || side > 1) return NULL;
+    if (request->sourceCount < 0 || request->sourceCount > NAV_HARVEST_MAX_SOURCES) {
+        return NULL;
+    }
+    NavHarvestField *harvest = &nav->harvestFields[side];
+    NavScratch *s = &nav->scratch[0];
+    nav_seal_inputs(nav);
+    harvest->field.useStamp = nav->frameCounter;
+    if (nav_field_is_current(nav, &harvest->field, &harvest->field.seedInputs) &&
+        memcmp(&harvest->request, request, sizeof(*request)) == 0) {
+        s->stats.hits++;
+        return harvest;
+    }
+    harvest->request = *request;
+    uint64_t startNs = nav_budget_begin(nav);
+    nav_build_harvest_field(nav, s, harvest, side);
+    nav_budget_end(nav, startNs);
+    s->stats.rebuilds++;
+    return harvest;
+}
+
+// ---------- Field build stage ----------
+//
+// Which fields an entity needs is only known once its own update has picked
+// a target, so the request list for a frame is the set of fields looked up
+// during the previous one. Builds read the frozen frame inputs and write
+// only their own field (plus their own lane's NavLaneStatic), so they run
+// concurrently with one NavScratch per thread. Jobs are claimed from a
+// shared counter; which thread builds a field never affects its contents.
+// Under a frame budget (NAV_FRAME_BUDGET_US) the job list is ordered
+// stalest first, so deferred fields catch up before fresh ones refresh.
+
+static void nav_run_field_job(NavFrame *nav, NavScratch *s, const Battlefield *bf,
+                              const NavFieldJob *job) {
+    NavField *field = job->field;
+    if (job->lane >= 0) {
+        nav_update_lane_field(nav, s, bf, job->side, job->lane, field);
+    } else if (field->kind == NAV_GOAL_KIND_FREE_GOAL) {
+        // The original carve center is only a fallback for a carve target
+        // missing from the snapshot; the last resolved one stands in.
+        NavFreeGoalRequest request = {
+            .goalX = field->anchorX,
+            .goalY = field->anchorY,
+            .stopRadius = field->stopRadius,
+            .perspectiveSide = field->perspectiveSide,
+            .carveTargetId = field->keyTargetId,
+            .carveCenterX = field->seedInputs.carveX,
+            .carveCenterY = field->seedInputs.carveY,
+            .carveInnerRadius = field->seedInputs.carveInnerRadius,
+        };
+        nav_update_free_goal_field(nav, s, field, &request);
+    } else {
+        NavTargetGoal goal = {
+            .kind = field->kind,
+            .targetX = field->anchorX,
+            .targetY = field->anchorY,
+            .outerRadius = field->stopRadius,
+            .arcCenterDeg = field->arcCenterDeg,
+            .arcHalfDeg = field->arcHalfDeg,
+            .targetBodyRadius = field->targetBodyRadius,
+            .innerRadiusMin = field->innerRadius,
+            .targetId = field->keyTargetId,
+            .perspectiveSide = field->perspectiveSide,
+        };
+        nav_update_target_field(nav, s, field, &goal);
+    }
+}
+
+// Whether the build stage has used up the frame budget. Jobs claimed after
+// that are skipped and left to lazy lookups, which serve them stale.
+static bool nav_stage_over_budget(const NavFrame *nav) {
+    return nav->budgetUs > 0 && nav_clock_ns() - nav->stageStartNs >= nav_budget_ns(nav);
+}
+
+// Stalest first; ties keep cache order (lanes, targets, free goals).
+static int nav_field_job_compare(const void *a, const void *b) {
+    const NavFieldJob *ja = a;
+    const NavFieldJob *jb = b;
+    if (ja->field->frameStamp != jb->field->frameStamp) {
+        return ja->field->frameStamp < jb->field->frameStamp ? -1 : 1;
+    }
+    return (ja->order > jb->order) - (ja->order < jb->order);
+}
+
+#if NAV_BUILD_WORKERS > 1
+
+typedef struct {
+    NavWorkerPool *pool;
+    int32_t scratchIndex;
+} NavWorkerArg;
+
+struct NavWorkerPool {
+    NavFrame *nav;
+    const Battlefield *bf;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // main -> workers: new generation or stop
+    pthread_cond_t idle;        // workers -> main: running dropped to 0
+    uint32_t generation;
+    int32_t nextJob;
+    int32_t running;
+    bool stop;
+    int32_t threadCount;
+    pthread_t threads[NAV_BUILD_WORKERS];
+    NavWorkerArg args[NAV_BUILD_WORKERS];
+};
+
+static void nav_pool_drain_jobs(NavWorkerPool *pool, int32_t scratchIndex) {
+    NavFrame *nav = pool->nav;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int32_t job = pool->nextJob < nav->jobCount ? pool->nextJob++ : -1;
+        pthread_mutex_unlock(&pool->lock);
+        if (job < 0) return;
+        if (nav_stage_over_budget(nav)) continue;
+        nav_run_field_job(nav, &nav->scratch[scratchIndex], pool->bf, &nav->jobs[job]);
+    }
+}
+
+static void *nav_pool_worker(void *arg) {
+    const NavWorkerArg *workerArg = arg;
+    NavWorkerPool *pool = workerArg->pool;
+    int32_t scratchIndex = workerArg->scratchIndex;
+    uint32_t seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stop && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        nav_pool_drain_jobs(pool, scratchIndex);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) pthread_cond_signal(&pool->idle);
     }
+    pthread_mutex_unlock(&pool->lock);
     return NULL;
 }
 
+static void nav_pool_start(NavFrame *nav) {
+    if (nav->workerCount <= 1) return;
+    NavWorkerPool *pool = calloc(1, sizeof(NavWorkerPool));
+    if (!pool) {
+        nav->workerCount = 1;
+        return;
+    }
+    pool->nav = nav;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    for (int32_t i = 1; i < nav->workerCount; ++i) {
+        pool->args[i].pool = pool;
+        pool->args[i].scratchIndex = i;
+        if (pthread_create(&pool->threads[pool->threadCount], NULL,
+                           nav_pool_worker, &pool->args[i]) != 0) {
+            break;
+        }
+        pool->threadCount++;
+    }
+    nav->pool = pool;
+    nav->workerCount = pool->threadCount + 1;
+    if (pool->threadCount == 0) nav_pool_stop(nav);
+}
+
+static void nav_pool_stop(NavFrame *nav) {
+    NavWorkerPool *pool = nav->pool;
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int32_t i = 0; i < pool->threadCount; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    nav->pool = NULL;
+    nav->workerCount = 1;
+}
+
+// Run nav->jobs on the calling thread and every worker; returns when all
+// jobs are done.
+static void nav_pool_run(NavFrame *nav, const Battlefield *bf) {
+    NavWorkerPool *pool = nav->pool;
+    pthread_mutex_lock(&pool->lock);
+    pool->bf = bf;
+    pool->nextJob = 0;
+    pool->running = pool->threadCount;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    nav_pool_drain_jobs(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) pthread_cond_wait(&pool->idle, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+#else
+
+static void nav_pool_start(NavFrame *nav) { (void)nav; }
+static void nav_pool_stop(NavFrame *nav) { (void)nav; }
+
+#endif
+
+void nav_build_requested_fields(NavFrame *nav, const Battlefield *bf) {
+    if (!nav || !nav->initialized || !bf || !nav->scratch) return;
+    nav_seal_inputs(nav);
+
+    uint32_t lastFrame = nav->frameCounter - 1;
+    int32_t count = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (int lane = 0; lane < 3; ++lane) {
+            NavField *field = &nav->laneFields[side][lane];
+            if (!field->built || field->useStamp != lastFrame) continue;
+            nav->jobs[count] = (NavFieldJob){ field, (int16_t)side, (int16_t)lane, count };
+            count++;
+        }
+    }
+    // nav_begin_frame already released every cache entry not looked up
+    // last frame, so the built and pending entries are exactly last frame's
+    // requests.
+    for (int32_t i = 0; i < nav->targetCache.size; ++i) {
+        NavField *field = nav_field_cache_slot(&nav->targetCache, i);
+        if (!field->built && !field->pending) continue;
+        if (field->keyTargetId >= 0 &&
+            nav_entity_snap_find(nav, field->keyTargetId) < 0) {
+            continue;
+        }
+        nav->jobs[count] = (NavFieldJob){ field, -1, -1, count };
+        count++;
+    }
+    for (int32_t i = 0; i < nav->freeGoalCache.size; ++i) {
+        NavField *field = nav_field_cache_slot(&nav->freeGoalCache, i);
+        if (!field->built && !field->pending) continue;
+        nav->jobs[count] = (NavFieldJob){ field, -1, -1, count };
+        count++;
+    }
+    nav->jobCount = count;
+    if (nav->budgetUs > 0) {
+        qsort(nav->jobs, (size_t)count, sizeof(NavFieldJob), nav_field_job_compare);
+        nav->stageStartNs = nav_clock_ns();
+    }
+
+    bool ranOnPool = false;
+#if NAV_BUILD_WORKERS > 1
+    if (nav->pool && count > 1) {
+        nav_pool_run(nav, bf);
+        ranOnPool = true;
+    }
+#endif
+    for (int32_t i = 0; !ranOnPool && i < count && !nav_stage_over_budget(nav); ++i) {
+        nav_run_field_job(nav, &nav->scratch[0], bf, &nav->jobs[i]);
+    }
+    if (nav->budgetUs > 0) nav->budgetSpentNs = nav_clock_ns() - nav->stageStartNs;
+}
+
+NavFieldStats nav_field_stats(const NavFrame *nav) {
+    NavFieldStats total = { 0 };
+    if (!nav) return total;
+    for (int32_t i = 0; i < nav->workerCount; ++i) {
+        total.hits += nav->scratch[i].stats.hits;
+        total.repairs += nav->scratch[i].stats.repairs;
+        total.rebuilds += nav->scratch[i].stats.rebuilds;
+        total.deferred += nav->scratch[i].stats.deferred;
+        total.staleServed += nav->scratch[i].stats.staleServed;
+        total.staleAgeTotal += nav->scratch[i].stats.staleAgeTotal;
+        total.boundedBuilds += nav->scratch[i].stats.boundedBuilds;
+        total.extensions += nav->scratch[i].stats.extensions;
+        if (nav->scratch[i].stats.staleAgeMax > total.staleAgeMax) {
+            total.staleAgeMax = nav->scratch[i].stats.staleAgeMax;
+        }
+    }
+    return total;
+}
+
+void nav_set_frame_budget_us(NavFrame *nav, int32_t budgetUs) {
+    if (!nav) return;
+    nav->budgetUs = budgetUs > 0 ? budgetUs : 0;
+}
+
+void nav_set_query_bounded(NavFrame *nav, bool enabled) {
+    if (!nav) return;
+    nav->queryBounded = enabled;
+}
+
 void nav_goal_region_anchor(const NavField *field, float *outX, float *outY) {
     float x = 0.0f, y = 0.0f;
     if (field) {
@@ -1007,6 +2752,40 @@ void nav_snapshot_entity_position(NavFrame *nav, int entityId,
     nav_entity_snap_insert(nav, entityId, x, y);
 }
 
+// ---------- Detached fields ----------
+
+bool nav_seed_lane_field(NavFrame *nav, const Battlefield *bf,
+                         int side, int lane, NavField *field) {
+    if (!nav || !nav->initialized || !bf || !field) return false;
+    if (side < 0 || side > 1 || lane < 0 || lane > 2) return false;
+    memset(field, 0, sizeof(*field));
+    nav_seed_lane(nav, bf, side, lane, field);
+    return true;
+}
+
+bool nav_seed_target_field(const NavFrame *nav, const NavTargetGoal *goal,
+                           NavField *field) {
+    if (!nav || !nav->initialized || !goal || !field) return false;
+    if (goal->perspectiveSide < 0 || goal->perspectiveSide > 1) return false;
+    memset(field, 0, sizeof(*field));
+    return nav_seed_target(nav, field, goal, NULL) > 0;
+}
+
+bool nav_seed_free_goal_field(const NavFrame *nav, const NavFreeGoalRequest *request,
+                              NavField *field) {
+    if (!nav || !nav->initialized || !request || !field) return false;
+    if (request->perspectiveSide < 0 || request->perspectiveSide > 1) return false;
+    memset(field, 0, sizeof(*field));
+    return nav_seed_free_goal(nav, field, request, NULL) > 0;
+}
+
+void nav_integrate_detached_field(const NavFrame *nav, NavField *field) {
+    if (!nav || !nav->scratch || !field) return;
+    nav_integrate_field(nav, &nav->scratch[0], field, NULL);
+    nav_field_reset_flow(field);
+    field->built = true;
+}
+
 // ---------- Raw mutators (Phase 2) ----------
 
 static void nav_stamp_blocker_disk_internal(NavFrame *nav,
@@ -1035,11 +2814,13 @@ static void nav_stamp_blocker_disk_internal(NavFrame *nav,
             float dx = cellX - centerX;
             if (dx * dx + dy * dy <= r2) {
                 int32_t idx = nav_index(col, row);
-                nav->staticBlockers.blocked[idx] = 1;
+                nav_bit_set(nav->staticBlockers.blocked, idx);
                 nav->staticBlockers.blockerSrc[idx] = entityId;
             }
         }
     }
+    nav->staticDirty = true;
+    nav->inputsSealed = false;
 }
 
 void nav_stamp_static_entity(NavFrame *nav, int32_t entityId,
@@ -1056,8 +2837,10 @@ void nav_stamp_static_entity_cell(NavFrame *nav, int32_t entityId,
     int32_t idx = nav_cell_index_for_world(worldX, worldY);
     if (idx < 0 || idx >= NAV_CELLS) return;
 
-    nav->staticBlockers.blocked[idx] = 1;
+    nav_bit_set(nav->staticBlockers.blocked, idx);
     nav->staticBlockers.blockerSrc[idx] = entityId;
+    nav->staticDirty = true;
+    nav->inputsSealed = false;
 }
 
 void nav_stamp_static_blocker_disk(NavFrame *nav, float centerX, float centerY,
@@ -1074,59 +2857,58 @@ void nav_stamp_density(NavFrame *nav, int side, float x, float y) {
     if (side < 0 || side >= 2) return;
     int32_t cell = nav_cell_index_for_world(x, y);
     // Saturate at INT16_MAX defensively; in practice density[] only counts
-    // live troops and MAX_ENTITIES * 2 = 128 fits comfortably.
+    // live troops, which ENTITY_CAPACITY_MAX keeps far below the limit.
     if (nav->density[side][cell] < INT16_MAX) {
         nav->density[side][cell]++;
     }
+    nav->inputsSealed = false;
 }
 
 // ---------- Flow sampling ----------
 
+bool nav_field_cell_settled(const NavField *field, int32_t cell) {
+    if (!field || cell < 0 || cell >= NAV_CELLS) return false;
+    return field->distance[cell] <= field->settledLimit;
+}
+
 void nav_cell_flow_direction(const NavField *field, int32_t cell,
                               int *outDcol, int *outDrow) {
     int dc = 0;
     int dr = 0;
-    if (field && cell >= 0 && cell < NAV_CELLS &&
-        field->distance[cell] != NAV_DIST_UNREACHABLE) {
+    if (field && cell >= 0 && cell < NAV_CELLS) {
         NavCellCoord coord = nav_cell_coord(cell);
-        int32_t bestDist = field->distance[cell];
-        for (int n = 0; n < 8; ++n) {
-            int32_t nc = coord.col + NAV_NEIGHBORS[n].dcol;
-            int32_t nr = coord.row + NAV_NEIGHBORS[n].drow;
-            if (!nav_in_bounds(nc, nr)) continue;
-            int32_t nidx = nav_index(nc, nr);
-            if (field->hardBlocked[nidx]) continue;
-            // Corner-cut prevention applies to flow sampling too, otherwise
-            // the per-cell direction could point through the shared corner
-            // of two blockers even though the Dijkstra integration refused
-            // to propagate that way.
-            if (nav_neighbor_is_diagonal(n)) {
-                int32_t orthoColIdx = nav_index(coord.col + NAV_NEIGHBORS[n].dcol,
-                                                coord.row);
-                int32_t orthoRowIdx = nav_index(coord.col,
-                                                coord.row + NAV_NEIGHBORS[n].drow);
-                if (field->hardBlocked[orthoColIdx]) continue;
-                if (field->hardBlocked[orthoRowIdx]) continue;
-            }
-            int32_t d = field->distance[nidx];
-            if (d < bestDist) {
-                bestDist = d;
-                dc = NAV_NEIGHBORS[n].dcol;
-                dr = NAV_NEIGHBORS[n].drow;
-            }
+        uint8_t dir = nav_field_peek_flow_dir(field, coord.col, coord.row);
+        if (dir != NAV_FLOW_DIR_NONE) {
+            dc = NAV_NEIGHBORS[dir].dcol;
+            dr = NAV_NEIGHBORS[dir].drow;
         }
     }
     if (outDcol) *outDcol = dc;
     if (outDrow) *outDrow = dr;
 }
 
+// Unit steering vector per NAV_NEIGHBORS index; diagonals are scaled by
+// 1 / sqrtf(2.0f).
+static const float NAV_FLOW_UNIT[8][2] = {
+    {  0.0f,         -1.0f        },
+    {  1.0f,          0.0f        },
+    {  0.0f,          1.0f        },
+    { -1.0f,          0.0f        },
+    {  0.70710677f,  -0.70710677f },
+    {  0.70710677f,   0.70710677f },
+    { -0.70710677f,   0.70710677f },
+    { -0.70710677f,  -0.70710677f },
+};
+
 // Bilinear-blended continuous flow sampling. Walks the four cell centers
 // nearest (x, y), fetches each cell's per-cell flow direction, and blends
 // the vectors by bilinear weights. Unreachable cells contribute a zero
 // vector, so the blend naturally degrades near walls and blockers without
-// pulling the sampling unit into an invalid cell.
-void nav_sample_flow(const NavField *field, float x, float y,
-                      float *outDx, float *outDy) {
+// pulling the sampling unit into an invalid cell. Directions are cached in
+// `memo` when it is given (the same field, writable) and only read
+// otherwise.
+static void nav_blend_flow(const NavField *field, NavField *memo, float x, float y,
+                           float *outDx, float *outDy) {
     float dx = 0.0f;
     float dy = 0.0f;
     if (!field) {
@@ -1143,8 +2925,9 @@ void nav_sample_flow(const NavField *field, float x, float y,
     int32_t r0 = (int32_t)floorf(gy);
     float tx = gx - (float)c0;
     float ty = gy - (float)r0;
-    // Fetch the four corner cells' flow vectors. Out-of-bounds corners
-    // contribute (0,0), which keeps the blend finite at the board edges.
+    // Fetch the four corner cells' flow vectors from the direction table.
+    // Out-of-bounds corners contribute (0,0), which keeps the blend finite
+    // at the board edges.
     struct { int32_t col; int32_t row; float w; } corners[4] = {
         { c0,     r0,     (1.0f - tx) * (1.0f - ty) },
         { c0 + 1, r0,     tx          * (1.0f - ty) },
@@ -1155,15 +2938,11 @@ void nav_sample_flow(const NavField *field, float x, float y,
         int32_t c = corners[i].col;
         int32_t r = corners[i].row;
         if (!nav_in_bounds(c, r)) continue;
-        int cellIdx = nav_index(c, r);
-        int fdc, fdr;
-        nav_cell_flow_direction(field, cellIdx, &fdc, &fdr);
-        if (fdc == 0 && fdr == 0) continue;
-        float len = sqrtf((float)(fdc * fdc + fdr * fdr));
-        if (len <= 0.0f) continue;
-        float invLen = 1.0f / len;
-        dx += corners[i].w * (float)fdc * invLen;
-        dy += corners[i].w * (float)fdr * invLen;
+        uint8_t dir = memo ? nav_field_flow_dir(memo, c, r)
+                           : nav_field_peek_flow_dir(field, c, r);
+        if (dir == NAV_FLOW_DIR_NONE) continue;
+        dx += corners[i].w * NAV_FLOW_UNIT[dir][0];
+        dy += corners[i].w * NAV_FLOW_UNIT[dir][1];
     }
     // Renormalize the blended vector so callers scaling by moveSpeed * dt
     // get uniform step length regardless of sample position or the number
@@ -1179,3 +2958,11 @@ void nav_sample_flow(const NavField *field, float x, float y,
     if (outDx) *outDx = dx;
     if (outDy) *outDy = dy;
 }
+
+void nav_sample_flow(NavField *field, float x, float y, float *outDx, float *outDy) {
+    nav_blend_flow(field, field, x, y, outDx, outDy);
+}
+
+void nav_peek_flow(const NavField *field, float x, float y, float *outDx, float *outDy) {
+    nav_blend_flow(field, NULL, x, y, outDx, outDy);
+}
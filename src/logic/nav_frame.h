@@ -1,11 +1,17 @@
 //
-// Per-frame flow-field navigation cache.
+// Flow-field navigation cache.
 //
-// NavFrame is the shared snapshot that every moving entity consults each tick.
-// `nav_begin_frame()` rebuilds the static obstacle mask, clears the per-frame
-// caches, and rasterizes ally/enemy density. Lane fields, target fields, and
-// free-goal fields are built lazily on first lookup within a frame and reused
-// across entities that share the same cache key.
+// NavFrame is the shared snapshot that every moving entity consults each
+// tick. `nav_begin_frame()` zeroes the ally/enemy density, which the caller
+// then rasterizes, and expires fields nobody looked up last frame; the
+// static obstacle layer persists and is restamped only when static entities
+// change (nav_static_layer_begin). Lane, target and free-goal fields persist
+// across frames in keyed caches and record the static and density versions
+// they were integrated against. nav_build_requested_fields() brings every
+// field looked up last frame up to date before the entity update loop --
+// reused as is, repaired where density moved, or rebuilt -- and a lookup
+// only builds a field itself when its key is new this frame or the stage
+// skipped it. Entities sharing a cache key share the field.
 //
 // Grid layout:
 //   NAV_CELL_SIZE = 32
@@ -13,14 +19,14 @@
 //   NAV_ROWS      = (BOARD_HEIGHT + 31) / 32  = 60
 //   NAV_CELLS     = NAV_COLS * NAV_ROWS       = 2040
 //
+// NAV_CELL_SIZE can be overridden at build time (the edge moat below scales
+// with it); finer grids are meant to be paired with the sector/portal layer
+// the --nav-bench tool prototypes (src/tools/nav_hier.h).
+//
 // All integration is reverse 8-neighbor Dijkstra with fixed movement costs
 // 10 (orthogonal) and 14 (diagonal), plus dynamic per-cell shaping penalties
-// from the ally/enemy density rasterization. A fixed-capacity binary min-heap
-// is reused across field builds (no per-tick allocation).
-//
-// Scope of this header is Phase 1: types, lifecycle, lane-field builder, and
-// the cache slot tables. Target-field and free-goal-field builders and
-// bilinear flow sampling land in Phase 2.
+// from the ally/enemy density rasterization. Each build thread reuses its own
+// fixed-capacity queues (NavScratch), so there is no per-tick allocation.
 //
 
 #ifndef NFC_CARDGAME_NAV_FRAME_H
@@ -39,10 +45,26 @@ typedef struct Battlefield Battlefield;
 
 // ---------- Grid geometry ----------
 
+#ifndef NAV_CELL_SIZE
 #define NAV_CELL_SIZE  32
+#endif
 #define NAV_COLS       ((BOARD_WIDTH  + NAV_CELL_SIZE - 1) / NAV_CELL_SIZE)
 #define NAV_ROWS       ((BOARD_HEIGHT + NAV_CELL_SIZE - 1) / NAV_CELL_SIZE)
 #define NAV_CELLS      (NAV_COLS * NAV_ROWS)
+#define NAV_CELL_WORDS ((NAV_CELLS + 63) / 64)   // uint64_t words in a per-cell bitset
+
+// Per-cell bitsets (blocker masks, occupancy) index bit i of word i / 64.
+static inline bool nav_bit_test(const uint64_t *bits, int32_t i) {
+    return (bits[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void nav_bit_set(uint64_t *bits, int32_t i) {
+    bits[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline void nav_bit_clear(uint64_t *bits, int32_t i) {
+    bits[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
 
 // ---------- Edge moat invariant ----------
 //
@@ -61,12 +83,15 @@ typedef struct Battlefield Battlefield;
 // radius-test behavior, so a single-cell moat is sufficient and matches
 // the old bounds check for every unit the game actually spawns.
 //
-// NAV_EDGE_MOAT_CELLS is the knob that encodes this decision. If any
-// future unit's body radius grows past NAV_CELL_SIZE - NAV_EDGE_MOAT_CELLS
-// * NAV_CELL_SIZE / 2, this constant must grow with it, and the static
-// assert in nav_frame.c fires at compile time.
-#define NAV_EDGE_MOAT_CELLS      1
+// NAV_EDGE_MOAT_CELLS encodes this decision. It is derived from the cell
+// size: the fewest cells (at least one) that put the nearest unblocked
+// center, NAV_EDGE_MOAT_CELLS * NAV_CELL_SIZE + NAV_CELL_SIZE / 2 from the
+// edge, at or past NAV_MAX_MOBILE_BODY_RADIUS. That is one cell at 16 and
+// 32 px and two at 8 px. The static assert in nav_frame.c re-checks it.
 #define NAV_MAX_MOBILE_BODY_RADIUS 18
+#define NAV_EDGE_MOAT_CELLS_MIN \
+    ((NAV_MAX_MOBILE_BODY_RADIUS - NAV_CELL_SIZE / 2 + NAV_CELL_SIZE - 1) / NAV_CELL_SIZE)
+#define NAV_EDGE_MOAT_CELLS (NAV_EDGE_MOAT_CELLS_MIN > 1 ? NAV_EDGE_MOAT_CELLS_MIN : 1)
 
 // ---------- Integration costs ----------
 
@@ -75,9 +100,18 @@ typedef struct Battlefield Battlefield;
 #define NAV_COST_ORTHO     10
 #define NAV_COST_DIAGONAL  14
 
-// "Unreachable" sentinel used by the distance grid. INT32_MAX leaves plenty
-// of headroom for the heap-relaxation arithmetic.
-#define NAV_DIST_UNREACHABLE  INT32_MAX
+// Distances are stored as uint16_t. "Unreachable" is the top value and
+// finite distances saturate at NAV_DIST_MAX. The longest path on the board
+// (about 60 rows at up to NAV_MAX_STEP_COST, and ~1100 measured in stress
+// runs) stays far below it, so saturation is a guard, not a mode. The
+// kernels do their arithmetic in int32_t.
+#define NAV_DIST_UNREACHABLE  UINT16_MAX
+#define NAV_DIST_MAX          (UINT16_MAX - 1)
+
+// NavField.flowDir values for cells with no downhill neighbor and cells not
+// yet sampled since the distances last changed.
+#define NAV_FLOW_DIR_NONE     0xFF
+#define NAV_FLOW_DIR_UNKNOWN  0xFE
 
 // ---------- Dynamic shaping penalties ----------
 
@@ -109,6 +143,54 @@ typedef struct Battlefield Battlefield;
 #define NAV_ABAB_PINGPONG_COST        64
 #endif
 
+// ---------- Integration kernel ----------
+
+// Largest single relaxation cost the kernel can produce: a diagonal step
+// into a cell occupied by both sides with both sides on all four
+// orthogonal neighbors.
+#define NAV_MAX_STEP_COST (NAV_COST_DIAGONAL + NAV_ALLY_OCCUPIED_COST + \
+                           NAV_ENEMY_OCCUPIED_COST +                   \
+                           4 * (NAV_ALLY_NEAR_COST + NAV_ENEMY_NEAR_COST))
+
+// Edge costs are small bounded integers, so integration runs Dial's
+// algorithm: a circular array of NAV_BUCKET_COUNT distance buckets (a power
+// of two strictly larger than NAV_MAX_STEP_COST) with O(1) push, pop and
+// decrease-key. Set to 0 to build with the binary-heap kernel only. Both
+// produce identical distance[] grids; the heap also remains the fallback
+// for seed sets whose distances span more than one ring.
+#ifndef NAV_INTEGRATE_BUCKET_QUEUE
+#define NAV_INTEGRATE_BUCKET_QUEUE 1
+#endif
+#define NAV_BUCKET_COUNT  128
+
+// ---------- Query-bounded builds ----------
+//
+// Most target and free-goal fields are sampled by a handful of units a few
+// cells from the goal, yet a full integration floods the whole board. With
+// query-bounded builds on (nav_set_query_bounded), each lookup registers
+// the caller's position with the field, and building stops once every
+// registered cell is settled and the search has gone NAV_QUERY_MARGIN_COST
+// further. Cells past that point are left unsettled; a lookup whose sample
+// cells are among them resumes the integration on the spot, so every
+// sampled cell still holds its full-board distance. A field with more than
+// NAV_FIELD_MAX_REQUESTERS requesters, or looked up without a requester
+// position, is integrated over the whole board. Lane fields always are.
+#ifndef NAV_QUERY_BOUNDED
+#define NAV_QUERY_BOUNDED 0
+#endif
+#ifndef NAV_QUERY_MARGIN_COST
+#define NAV_QUERY_MARGIN_COST (2 * NAV_MAX_STEP_COST)
+#endif
+#ifndef NAV_FIELD_MAX_REQUESTERS
+#define NAV_FIELD_MAX_REQUESTERS 8
+#endif
+
+// ---------- Harvest fields ----------
+
+// Sources one harvest field can tell apart: the bits of its per-cell
+// source masks.
+#define NAV_HARVEST_MAX_SOURCES 8
+
 // ---------- Lane corridor ----------
 
 // Half-width of the home-half lane corridor used by lane-march fields. Cells
@@ -130,30 +212,33 @@ typedef struct Battlefield Battlefield;
 
 // ---------- Cache capacities ----------
 //
-// Target-field cache sized for the worst case where every live entity on the
-// board (MAX_ENTITIES * 2 = 128) pursues a distinct (targetId, goalKind,
-// rangeQ) combination, where rangeQ is the 0.25 px integer quantization of
-// the exact caller outerRadius. Free-goal cache sized for the worst case
-// where every live mover has a distinct free-goal field in one frame.
-#define NAV_TARGET_CACHE_CAPACITY   (MAX_ENTITIES * 2)
-// Sized to the battlefield's live entity cap so every live mover can hold
-// a distinct free-goal field in one frame without overflow fallback. Was
-// previously 64; bumped to MAX_ENTITIES * 2 = 128 after the exact-position
-// cache key rewrite made collisions rare (two free-goal callers no longer
-// share a slot unless their goal points agree to within 0.25 px).
-#define NAV_FREE_GOAL_CACHE_CAPACITY (MAX_ENTITIES * 2)
+// The target-field, free-goal and snapshot capacities are runtime values
+// chosen by nav_frame_init() from the match's live entity cap
+// (ENTITY_CAPACITY_DEFAULT unless a horde mode raises it).
+//
+// The target-field cache is sized for the worst case where every live
+// entity pursues a distinct (targetId, goalKind, rangeQ) combination. Here
+// rangeQ is the 0.25 px integer quantization of the exact caller
+// outerRadius. The free-goal cache is sized for the worst case where every
+// live mover has a distinct free-goal field in one frame. The free-goal
+// cache was 64 before the exact-position cache key rewrite made
+// collisions rare; it now matches the entity cap.
 
 // Number of prebuilt lane fields: two sides x three lanes.
 #define NAV_LANE_FIELD_COUNT  (2 * 3)
 
-// Snapshot hash table capacity. Live entity count is capped at
-// MAX_ENTITIES * 2 = 128, so a 256-slot power-of-two table gives a
-// guaranteed <=50% load factor and keeps open-addressed linear probes
-// bounded. Entity ids are NOT used as indices -- they are stored in
-// entityPosId[] and probed modulo NAV_ENTITY_SNAP_CAPACITY.
-#define NAV_ENTITY_SNAP_CAPACITY 256
+// The snapshot hash table holds the smallest power of two at least twice
+// the live entity cap. That guarantees a load factor of at most 50% and
+// keeps open-addressed linear probes bounded. Entity ids are NOT used as
+// indices. They are stored in entityPosId[] and probed modulo
+// entitySnapCapacity.
 #define NAV_ENTITY_ID_NONE       (-1)
 
+// The target and free-goal caches are indexed the same way: an
+// open-addressed table of the same power-of-two size maps a field key to
+// its cache slot. NAV_FIELD_SLOT_NONE marks an empty entry.
+#define NAV_FIELD_SLOT_NONE      (-1)
+
 // ---------- Cell and field types ----------
 
 typedef struct {
@@ -172,8 +257,8 @@ typedef enum {
     NAV_GOAL_KIND_FREE_GOAL
 } NavGoalKind;
 
-// Hard-blocker mask: bit set means the cell is impassable (board edge, static
-// building footprint, or a lane field's corridor mask). This is a separate
+// Hard-blocker mask: bit set (nav_bit_test) means the cell is impassable
+// (board edge, static building footprint, or a lane field's corridor mask). This is a separate
 // layer from the soft density penalties so the integration kernel can skip
 // hard-blocked neighbors without consulting density costs.
 //
@@ -185,19 +270,74 @@ typedef enum {
 // entity itself owns, so other nearby blockers are preserved.
 #define NAV_BLOCKER_SRC_NONE (-1)
 typedef struct {
-    uint8_t blocked[NAV_CELLS];
-    int32_t blockerSrc[NAV_CELLS];
+    uint64_t blocked[NAV_CELL_WORDS];
+    int32_t  blockerSrc[NAV_CELLS];
 } NavBlockerMask;
 
+// Resolved seed-region inputs of a field: everything besides the static
+// mask and density that its distance grid depends on. Compared bytewise
+// when deciding whether a field from an earlier frame can be reused, so it
+// is all 4-byte members with no padding and must be zero-initialized.
+typedef struct {
+    float   anchorX;            // resolved target pivot / goal point / lane seed
+    float   anchorY;
+    float   outerRadius;
+    float   arcCenterDeg;
+    float   arcHalfDeg;
+    float   targetBodyRadius;
+    float   innerRadiusMin;
+    float   carveX;             // resolved carve center (free-goal fields)
+    float   carveY;
+    float   carveInnerRadius;
+    int32_t carveTargetId;
+} NavSeedInputs;
+
 // A completed flow field. `distance[i]` is the integrated cost from cell `i`
 // to the nearest seed cell along the cheapest 8-neighbor path, including
 // any dynamic density penalties contributed by NavFrame.density[] from the
 // perspective of `perspectiveSide` (allies cheap, enemies expensive).
 // Unreachable cells hold NAV_DIST_UNREACHABLE.
+//
+// Fields persist across frames. `built` means the grid holds a completed
+// integration; `frameStamp` says which frame last validated it (reused,
+// repaired or rebuilt) and `useStamp` which frame last looked it up. Only
+// built fields looked up this frame are returned by the find_* helpers.
+// The version stamps and occupancy bitsets record the inputs the grid was
+// integrated against. A `pending` field holds only its cache key: its
+// first build was postponed by the frame budget.
+//
+// `flowDir[i]` caches the steering direction of cell `i`: the NAV_NEIGHBORS
+// index of its steepest-descent neighbor, or NAV_FLOW_DIR_NONE. Every build
+// or repair resets it to NAV_FLOW_DIR_UNKNOWN and the first nav_sample_flow
+// of a cell fills it in, so all entities sampling a field share one table
+// and cells nobody samples are never scanned. Filling it writes the field:
+// nav_sample_flow takes it non-const, and read-only callers use
+// nav_peek_flow / nav_cell_flow_direction, which scan without caching.
+//
+// A query-bounded build leaves `settledLimit` at the distance it stopped
+// after: cells at or below it hold their final distance, the rest are
+// unreachable or carry a tentative upper bound and sample as having no
+// flow. It is NAV_DIST_UNREACHABLE once the whole board is integrated.
+// requesterCells lists the cells looked up from during frame
+// requesterFrame; requestersOverflow means the next build covers the whole
+// board.
 typedef struct {
-    int32_t  distance[NAV_CELLS];
-    uint8_t  hardBlocked[NAV_CELLS]; // local copy of the per-field blocker mask
+    uint16_t distance[NAV_CELLS];
+    uint8_t  flowDir[NAV_CELLS];
+    uint64_t hardBlocked[NAV_CELL_WORDS]; // per-field blocker bitset
     bool     built;
+    bool     pending;
+    bool     requestersOverflow;
+    int32_t  settledLimit;
+    int32_t  requesterCells[NAV_FIELD_MAX_REQUESTERS];
+    int32_t  requesterCount;
+    uint32_t requesterFrame;
+    uint32_t frameStamp;
+    uint32_t useStamp;
+    uint32_t staticVersion;
+    uint32_t densityVersion;
+    uint64_t occupancy[2][NAV_CELL_WORDS]; // density > 0 per side at integration
+    NavSeedInputs seedInputs;
     NavGoalKind kind;
     // perspectiveSide selects which side's density costs the integration
     // kernel treats as "ally" (cheap) vs "enemy" (expensive). Must be 0 or 1.
@@ -247,6 +387,113 @@ typedef struct {
     int32_t  keyRangeQ;
 } NavField;
 
+// Match-constant inputs of one lane field. Lane waypoints never change after
+// bf_init, so the home-half corridor mask is rasterized once per match (on
+// the first build after nav_frame_init) instead of once per frame.
+//
+// Seed placement also reads the per-frame static blocker mask, but only
+// inside the (2 * NAV_LANE_SEED_SEARCH_CELLS + 1)^2 window around the final
+// waypoint. The seed cells are cached with a bitset snapshot of the static
+// mask over that window and reused while the window is unchanged.
+#define NAV_LANE_SEED_SEARCH_CELLS  4
+#define NAV_LANE_SEED_WINDOW        (2 * NAV_LANE_SEED_SEARCH_CELLS + 1)
+#define NAV_LANE_SEED_WINDOW_CELLS  (NAV_LANE_SEED_WINDOW * NAV_LANE_SEED_WINDOW)
+#define NAV_LANE_SEED_WINDOW_WORDS  ((NAV_LANE_SEED_WINDOW_CELLS + 63) / 64)
+
+typedef struct {
+    uint64_t corridorBlocked[NAV_CELL_WORDS];  // home-half cells outside the corridor
+    int32_t  seedCells[NAV_LANE_SEED_WINDOW_CELLS];
+    int32_t  seedCount;
+    uint64_t seedWindowStatic[NAV_LANE_SEED_WINDOW_WORDS];
+    bool     corridorReady;
+    bool     seedsReady;
+} NavLaneStatic;
+
+// Cumulative field-cache outcomes since nav_frame_init.
+//   hits     -- lookups served by a field whose inputs were all unchanged
+//   repairs  -- fields brought up to date by an incremental density repair
+//   rebuilds -- full seed + integrate builds (first use, moved seeds,
+//               static mask changes, or density changes too large to repair)
+//   deferred -- lookups whose repair or build was postponed by the frame
+//               budget (served stale, or NULL for a key with no field yet)
+//   staleServed, staleAgeTotal, staleAgeMax -- the stale servings among
+//               those and how many frames behind their fields were
+//   boundedBuilds -- integrations stopped early around their requesters
+//   extensions    -- lookups that resumed one to settle their sample cells
+typedef struct {
+    uint64_t hits;
+    uint64_t repairs;
+    uint64_t rebuilds;
+    uint64_t deferred;
+    uint64_t staleServed;
+    uint64_t staleAgeTotal;
+    uint32_t staleAgeMax;
+    uint64_t boundedBuilds;
+    uint64_t extensions;
+} NavFieldStats;
+
+// Density repair gives up and rebuilds when more than this many cells
+// changed occupancy since the field was integrated, or when the
+// invalidated region exceeds NAV_FIELD_REPAIR_MAX_AFFECTED cells.
+#ifndef NAV_FIELD_REPAIR_MAX_DIRTY_CELLS
+#define NAV_FIELD_REPAIR_MAX_DIRTY_CELLS  64
+#endif
+#ifndef NAV_FIELD_REPAIR_MAX_AFFECTED
+#define NAV_FIELD_REPAIR_MAX_AFFECTED     (NAV_CELLS / 4)
+#endif
+
+// Key -> cache slot index for one field cache. slots[] has `capacity`
+// entries (a power of two); lookups hash the field key and probe linearly.
+typedef struct {
+    int32_t *slots;
+    int32_t  capacity;
+} NavFieldIndex;
+
+// Target and free-goal caches hold their fields in fixed-size chunks that
+// are allocated the first time the high-water mark reaches them, so a match
+// only pays for the fields it actually keeps live. Fields never move once
+// allocated: lookups hand out stable pointers.
+#ifndef NAV_FIELD_CACHE_CHUNK
+#define NAV_FIELD_CACHE_CHUNK 16
+#endif
+
+// Lazy field cache looked up by key through `index`. Slots live across
+// frames; a slot not looked up during the previous frame is released by
+// nav_begin_frame onto the free list and dropped from the index. `size` is
+// the high-water mark of slots ever used; `capacity` the slot limit.
+typedef struct {
+    NavField **chunks;          // [ceil(capacity / NAV_FIELD_CACHE_CHUNK)]
+    int32_t    chunkCount;      // chunks allocated so far
+    int32_t    size;
+    int32_t    capacity;
+    int32_t   *freeSlots;
+    int32_t    freeCount;
+    NavFieldIndex index;
+} NavFieldCache;
+
+// Goal disks of a harvest field, in the caller's order; source k is bit k of
+// the field's masks. Each source is seeded exactly like an uncarved
+// free-goal field with the same goal point and stopRadius. Compared
+// bytewise when deciding whether the last build can be reused, so it is
+// all 4-byte members and must be zero-initialized.
+typedef struct {
+    int32_t sourceCount;
+    float   stopRadius;
+    float   sourceX[NAV_HARVEST_MAX_SOURCES];
+    float   sourceY[NAV_HARVEST_MAX_SOURCES];
+} NavHarvestRequest;
+
+// Multi-source field of one side. field.distance[i] is the cheapest cost
+// from cell i to any source -- the minimum over the free-goal fields of the
+// individual sources -- and sourceMask[i] has bit k set for every source
+// whose own field attains that minimum, so callers can break cost ties
+// themselves. Cells no source reaches have an empty mask.
+typedef struct {
+    NavField field;
+    uint8_t  sourceMask[NAV_CELLS];
+    NavHarvestRequest request;       // sources the field was built from
+} NavHarvestField;
+
 // Binary min-heap node used by the Dijkstra kernel. `cell` is a flat index
 // into the NAV_CELLS arrays; `dist` is the current tentative distance.
 typedef struct {
@@ -254,12 +501,79 @@ typedef struct {
     int32_t cell;
 } NavHeapNode;
 
+// ---------- Field build stage ----------
+
+// Threads (including the caller) that nav_build_requested_fields() spreads
+// field builds across, clamped at nav_frame_init to the online CPU count.
+// 1 builds everything on the calling thread and starts no workers.
+#ifndef NAV_BUILD_WORKERS
+#define NAV_BUILD_WORKERS 4
+#endif
+
+// Wall-clock microseconds of field repairs and builds allowed per frame,
+// spent first by nav_build_requested_fields() and then by lazy lookups.
+// Past it, a lookup whose field is out of date gets the field as an earlier
+// frame left it, and a key with no field yet gets NULL (callers fall back
+// to local steering); both count as deferred. Lane fields are always built
+// the first time. 0 disables the budget, which keeps the simulation
+// independent of machine speed; override per frame with
+// nav_set_frame_budget_us().
+#ifndef NAV_FRAME_BUDGET_US
+#define NAV_FRAME_BUDGET_US 0
+#endif
+
+// Working memory of one field build. Builds only read the shared NavFrame
+// inputs, so each build stage worker owns one of these and builds fields
+// concurrently; scratch[0] serves the calling thread and lazy lookups.
+typedef struct {
+    // Reusable heap storage for the Dijkstra kernel. The heap is indexed:
+    // heapPos[cell] is 1 + the cell's position in heapStorage (0 when not
+    // queued), so a relaxation lowers the queued key in place and each cell
+    // occupies at most one entry.
+    NavHeapNode heapStorage[NAV_CELLS];
+    int32_t     heapPos[NAV_CELLS];
+    int32_t     heapSize;
+
+    // Bucket-queue storage for the Dial kernel. Each queued cell sits in
+    // exactly one bucket (distance % NAV_BUCKET_COUNT) on an intrusive
+    // doubly linked list, so a relaxation moves it instead of re-enqueuing.
+    int32_t bucketHead[NAV_BUCKET_COUNT];
+    int32_t bucketNext[NAV_CELLS];
+    int32_t bucketPrev[NAV_CELLS];
+
+    // Density repair.
+    uint8_t repairState[NAV_CELLS];
+    int32_t repairCells[NAV_CELLS];
+    int32_t repairQueue[NAV_CELLS];
+
+    // Requester cells of the query-bounded integration in progress.
+    uint64_t requesterMask[NAV_CELL_WORDS];
+
+    // Outcomes of the builds run on this scratch; see nav_field_stats().
+    NavFieldStats stats;
+} NavScratch;
+
+// One field queued for the build stage.
+typedef struct {
+    NavField *field;
+    int16_t   side;             // lane fields only
+    int16_t   lane;             // lane fields only, -1 for target / free-goal
+    int32_t   order;            // position before budget sorting
+} NavFieldJob;
+
+typedef struct NavWorkerPool NavWorkerPool;
+
 // ---------- NavFrame ----------
 
 typedef struct NavFrame {
-    // Static obstacle mask rebuilt at nav_begin_frame from board bounds and
-    // NAV_PROFILE_STATIC entities.
+    // Static obstacle mask: the board-edge moat plus NAV_PROFILE_STATIC
+    // entity footprints. Persists across frames; nav_static_layer_begin
+    // resets it when staticLayerVersion goes stale, and staticDirty records
+    // stamps the next seal has not compared yet.
     NavBlockerMask staticBlockers;
+    uint32_t staticLayerVersion;
+    bool     staticLayerStamped;
+    bool     staticDirty;
 
     // Per-side entity density. density[side][cell] counts the live troops
     // owned by `side` that occupy that cell, as stamped by
@@ -277,41 +591,67 @@ typedef struct NavFrame {
     // the same frozen position, which removes the id-sorted update order
     // dependence.
     //
-    // entityPosId[] is keyed on entity id, not indexed by it: ids grow
-    // monotonically across the match and routinely exceed any fixed
-    // MAX_ENTITIES cap, so raw indexing would silently alias or drop
-    // snapshots in long matches. The live entity count is bounded by
-    // MAX_ENTITIES * 2 = 128, so an open-addressed hash table of that
-    // many slots is always sufficient. Sentinel value for an empty slot
-    // is NAV_ENTITY_ID_NONE (-1); lookups linear-probe within
-    // NAV_ENTITY_SNAP_CAPACITY.
-    int32_t  entityPosId[NAV_ENTITY_SNAP_CAPACITY];
-    float    entityPosX[NAV_ENTITY_SNAP_CAPACITY];
-    float    entityPosY[NAV_ENTITY_SNAP_CAPACITY];
-
-    // Prebuilt lane fields. Indexed by [side][lane]. Built lazily on first
-    // lookup via nav_get_or_build_lane_field().
+    // entityPosId[] is keyed on entity id, not indexed by it, so the
+    // table stays small regardless of how the id space is laid out. It is
+    // an open-addressed hash table of entitySnapCapacity slots (see Cache
+    // capacities above). Sentinel value for an empty slot is
+    // NAV_ENTITY_ID_NONE (-1).
+    int32_t *entityPosId;
+    float   *entityPosX;
+    float   *entityPosY;
+    int32_t  entitySnapCapacity;
+
+    // Persistent lane fields. Indexed by [side][lane]. First built by
+    // nav_get_or_build_lane_field(), then kept current by the build stage.
     NavField laneFields[2][3];
-
-    // Lazy target-field cache with linear-probe lookup by key.
-    NavField targetFields[NAV_TARGET_CACHE_CAPACITY];
-    int32_t  targetCacheSize;
-
-    // Lazy free-goal field cache (farmers, free-mover helpers).
-    NavField freeGoalFields[NAV_FREE_GOAL_CACHE_CAPACITY];
-    int32_t  freeGoalCacheSize;
-
-    // Reusable heap storage for the Dijkstra kernel.
-    //
-    // This kernel uses lazy deletion (stale entries are discarded at pop
-    // time) rather than a decrease-key operation, so the same cell may be
-    // enqueued once per incoming relaxation. On the 8-neighbor grid that
-    // is bounded above by 8 * NAV_CELLS inserts plus up to NAV_CELLS seed
-    // inserts from nav_integrate_field's initial scan. Capacity is sized
-    // to 9 * NAV_CELLS to cover both with headroom; nav_heap_push asserts
-    // on overflow so a future regression cannot silently out-of-bounds.
-    NavHeapNode heapStorage[NAV_CELLS * 9];
-    int32_t     heapSize;
+    NavLaneStatic laneStatic[2][3];
+
+    // Persistent target-field and free-goal field (farmers, free-mover
+    // helpers) caches.
+    NavFieldCache targetCache;
+    NavFieldCache freeGoalCache;
+
+    // Per-side harvest fields, rebuilt on lookup when their sources or the
+    // frame's inputs changed.
+    NavHarvestField harvestFields[2];
+
+    // Input versions. The first field lookup after the stamping pass seals
+    // the frame's inputs: staticVersion bumps when the static blocker mask
+    // (cells or owners) differs from the last sealed mask, densityVersion
+    // when any cell's per-side occupancy (density > 0 -- the only thing the
+    // penalties read) differs.
+    NavBlockerMask sealedStatic;
+    uint64_t occupancy[2][NAV_CELL_WORDS];
+    // Density cost of stepping into each cell, by perspective side: the
+    // occupied and NEAR terms of the current occupancy, rebuilt whenever
+    // densityVersion bumps so the kernel adds one byte per relaxation.
+    uint8_t  penalty[2][NAV_CELLS];
+    uint32_t staticVersion;
+    uint32_t densityVersion;
+    bool     inputsSealed;
+
+    // Build scratch, one per build stage thread ([0] is the caller's), and
+    // the job list and worker pool of nav_build_requested_fields(). pool is
+    // NULL when workerCount is 1.
+    NavScratch  *scratch;
+    int32_t      workerCount;
+    NavFieldJob *jobs;
+    int32_t      jobCount;
+    NavWorkerPool *pool;
+
+    // Frame budget (NAV_FRAME_BUDGET_US): the limit, the nanoseconds spent
+    // on builds so far this frame, and when the build stage started.
+    int32_t  budgetUs;
+    uint64_t budgetSpentNs;
+    uint64_t stageStartNs;
+
+    // Query-bounded target / free-goal builds (NAV_QUERY_BOUNDED).
+    bool queryBounded;
+
+    // UnitNavProfile bits (1u << profile) that pathfinding steers by ORCA
+    // instead of the candidate fan (PATHFIND_ORCA_PROFILES,
+    // pathfind_set_orca_profiles). 0 keeps the fan for every profile.
+    uint32_t orcaProfiles;
 
     // Frame sequence number, incremented by nav_begin_frame(). Exposed so
     // debug overlays and assertions can detect stale field reads.
@@ -324,21 +664,29 @@ typedef struct NavFrame {
 
 // ---------- Lifecycle ----------
 
-// Zero-initialize the NavFrame. Safe to call on a fresh stack-local or on a
-// heap allocation that has not been memset.
-void nav_frame_init(NavFrame *nav);
+// Zero-initialize the NavFrame and allocate its snapshot table and field
+// caches for `entityCapacity` live entities. Safe to call on a fresh
+// stack-local or on a heap allocation that has not been memset; pair with
+// nav_frame_destroy().
+void nav_frame_init(NavFrame *nav, int entityCapacity);
 
-// No-op today; exists so production code can pair init/destroy symmetrically
-// and so a future heap-backed NavFrame can release resources here without
-// touching call sites.
+// Release the storage allocated by nav_frame_init().
 void nav_frame_destroy(NavFrame *nav);
 
-// Begin a new frame: clear all per-frame caches, rebuild the static obstacle
-// mask from `bf` (board bounds only in Phase 1; NAV_PROFILE_STATIC entity
-// footprints land in Phase 2 when NavFrame is wired into game_update).
-// Ally/enemy density is zeroed; Phase 2 fills it from live entities.
+// Begin a new frame: expire fields unused last frame and zero ally/enemy
+// density for the caller to refill from live entities. The static layer is
+// left as stamped. Fields used last frame are kept and revalidated on
+// lookup.
 void nav_begin_frame(NavFrame *nav, const Battlefield *bf);
 
+// Start this frame's static layer. `version` is the caller's count of
+// static entity changes (Battlefield.staticEntityVersion). When it differs
+// from the version the layer was last stamped for (or nothing was stamped
+// yet), the layer is reset to the board-edge moat and true is returned: the
+// caller must then stamp every static entity. Otherwise the persistent
+// layer is still current and false means skip the static stamps.
+bool nav_static_layer_begin(NavFrame *nav, uint32_t version);
+
 // ---------- Coordinate helpers ----------
 
 // Clamp a world position to the canonical board and convert to a flat cell
@@ -362,16 +710,42 @@ int32_t nav_index(int32_t col, int32_t row);
 // True if the cell is hard-blocked by the static obstacle mask on this frame.
 bool nav_cell_is_static_blocked(const NavFrame *nav, int32_t cellIndex);
 
+// ---------- Field build stage ----------
+
+// Bring every field looked up during the previous frame up to date for
+// this frame's inputs, spread across the build stage workers. Call after
+// the stamping pass and before any entity looks fields up. Fields whose
+// target left the snapshot are skipped. A later lookup reuses a prebuilt
+// field only if its resolved seed inputs match the caller's, so this stage
+// never changes which field a lookup returns -- it only moves the work.
+// Under a frame budget the stalest fields go first and the stage stops
+// claiming jobs once the budget is spent.
+void nav_build_requested_fields(NavFrame *nav, const Battlefield *bf);
+
+// Field-cache outcomes summed over every build scratch.
+NavFieldStats nav_field_stats(const NavFrame *nav);
+
+// Set the per-frame build budget in microseconds; 0 disables it. Takes
+// effect from the next nav_build_requested_fields().
+void nav_set_frame_budget_us(NavFrame *nav, int32_t budgetUs);
+
+// Turn query-bounded target / free-goal builds on or off. Fields already
+// built stay as they are; a bounded one is completed by the first lookup
+// that needs more of it.
+void nav_set_query_bounded(NavFrame *nav, bool enabled);
+
 // ---------- Lane field access ----------
 
-// Return the lane-march flow field for (side, lane), building it lazily on
-// first access within the current frame. Returns NULL if side/lane are out
-// of range or nav has not been initialized this frame.
-const NavField *nav_get_or_build_lane_field(NavFrame *nav, const Battlefield *bf,
-                                             int side, int lane);
+// Return the lane-march flow field for (side, lane), up to date for this
+// frame's inputs: usually already brought current by
+// nav_build_requested_fields(), otherwise repaired or rebuilt on the spot.
+// Returns NULL if side/lane are out of range or nav has not been
+// initialized.
+NavField *nav_get_or_build_lane_field(NavFrame *nav, const Battlefield *bf,
+                                       int side, int lane);
 
-// Return the already-built lane field for (side, lane), or NULL if that
-// field has not been built in the current frame.
+// Return the built lane field for (side, lane), or NULL if it has not been
+// looked up this frame.
 const NavField *nav_find_lane_field(const NavFrame *nav, int side, int lane);
 
 // ---------- Target / free-goal field access ----------
@@ -426,6 +800,12 @@ typedef struct {
     float  innerRadiusMin;
     int32_t targetId;      // cache key; -1 for free-goal fields
     int16_t perspectiveSide; // 0 or 1; determines ally/enemy density cost
+    // Position the caller samples the field at right after the lookup.
+    // Query-bounded builds settle the field around it; leave hasRequester
+    // false to get the whole board. Not part of the cache key.
+    bool   hasRequester;
+    float  requesterX;
+    float  requesterY;
 } NavTargetGoal;
 
 // Parameters describing a free-goal field for farmers / helpers. The field is
@@ -444,38 +824,59 @@ typedef struct {
     float   carveCenterX;
     float   carveCenterY;
     float   carveInnerRadius;
+    bool    hasRequester;    // as in NavTargetGoal
+    float   requesterX;
+    float   requesterY;
 } NavFreeGoalRequest;
 
-// Return the target flow field matching `goal`, building it lazily on the
-// first lookup within the current frame. Cache key is
+// Return the target flow field matching `goal` from the persistent cache,
+// reused, repaired or rebuilt as in nav_get_or_build_lane_field; a key new
+// this frame is built on the spot. Cache key is
 // (targetId, kind, rangeClass, perspectiveSide). Returns NULL if the cache
-// has no free slot (assertion in debug builds).
-const NavField *nav_get_or_build_target_field(NavFrame *nav, const Battlefield *bf,
-                                                const NavTargetGoal *goal);
-
-// Return the already-built target field matching `goal`, or NULL if the
-// cache does not contain it in the current frame.
+// has no free slot (assertion in debug builds) or the frame budget deferred
+// the field's first build.
+NavField *nav_get_or_build_target_field(NavFrame *nav, const Battlefield *bf,
+                                          const NavTargetGoal *goal);
+
+// Return the built target field matching `goal`, or NULL if it has not
+// been looked up this frame. A query-bounded field is
+// only settled around this frame's requesters (nav_field_cell_settled).
 const NavField *nav_find_target_field(const NavFrame *nav,
                                       const NavTargetGoal *goal);
 
-// Return the free-goal flow field described by `request`, building it lazily on
-// first lookup within the current frame. Cache key is
+// Return the free-goal flow field described by `request` from the
+// persistent cache, reused, repaired or rebuilt as in
+// nav_get_or_build_lane_field; a key new this frame is built on the spot.
+// Cache key is
 // (goalXQ, goalYQ, rangeQ, perspectiveSide, carveTargetId), where goalXQ /
 // goalYQ are the 0.25 px integer quantization of the exact caller coordinates
 // and rangeQ is the 0.25 px quantization of the exact caller stopRadius. Two
 // free-goal callers do not alias unless their goal points, radii, perspective,
-// and carve target all agree. Returns NULL only if the cache overflows
-// (capacity is MAX_ENTITIES * 2 = 128, which matches the battlefield's live
-// entity cap, so this is unreachable in practice).
-const NavField *nav_get_or_build_free_goal_field(NavFrame *nav,
-                                                 const Battlefield *bf,
-                                                 const NavFreeGoalRequest *request);
-
-// Return the already-built free-goal field matching `request`'s exact cache
-// key, or NULL if it has not been built in the current frame.
+// and carve target all agree. Returns NULL if the cache overflows
+// (capacity matches the battlefield's live entity cap, so this is
+// unreachable in practice) or the frame budget deferred the first build.
+NavField *nav_get_or_build_free_goal_field(NavFrame *nav,
+                                           const Battlefield *bf,
+                                           const NavFreeGoalRequest *request);
+
+// Return the built free-goal field matching `request`'s exact cache key, or
+// NULL if it has not been looked up this frame. Settled as
+// for nav_find_target_field.
 const NavField *nav_find_free_goal_field(const NavFrame *nav,
                                          const NavFreeGoalRequest *request);
 
+// ---------- Harvest field access ----------
+
+// Return `side`'s harvest field for `request`, rebuilding it unless the
+// last build had the same sources, static mask and density. One field
+// answers "which source is cheapest to reach from here" for every cell, in
+// place of one free-goal field per source. Harvest builds are never
+// deferred or query-bounded; their time still counts against the frame
+// budget. Returns NULL for a bad side or more than NAV_HARVEST_MAX_SOURCES
+// sources.
+const NavHarvestField *nav_get_or_build_harvest_field(NavFrame *nav, int side,
+                                                      const NavHarvestRequest *request);
+
 // Representative world-space anchor of the field's goal region. Lane fields
 // return the final authored lane waypoint; target fields return the target
 // pivot; free-goal fields return the goal point. Used by the Phase 3
@@ -508,7 +909,8 @@ float nav_goal_region_target_body_radius(const NavField *field);
 //
 // nav_frame.c is intentionally Entity-agnostic: game.c iterates the live
 // entity registry and calls these raw mutators with world coordinates, so
-// the nav module never needs to #include the heavy types.h chain.
+// the nav module never needs to #include the heavy types.h chain. Static
+// stamps land in the persistent layer and stay until its next reset.
 
 // Stamp a hard-blocked disk of the given radius into staticBlockers. Every
 // cell whose center lies within `radius` world units of (centerX, centerY)
@@ -541,12 +943,41 @@ void nav_stamp_density(NavFrame *nav, int side, float x, float y);
 void nav_snapshot_entity_position(NavFrame *nav, int entityId,
                                     float x, float y);
 
+// ---------- Detached fields ----------
+//
+// Fields owned by the caller instead of the frame caches, used by the
+// hierarchical prototype in src/tools/nav_hier.h (cardgame_sim --nav-bench)
+// to integrate part of the board only; the game itself never calls these. A
+// detached field is seeded exactly like its cached counterpart and samples
+// like one, but no frame ever revalidates it.
+
+// Reset `field` and seed it for a goal without integrating it. Returns
+// false when the goal is invalid or no seed cell exists; the field is then
+// all-unreachable.
+bool nav_seed_lane_field(NavFrame *nav, const Battlefield *bf,
+                         int side, int lane, NavField *field);
+bool nav_seed_target_field(const NavFrame *nav, const NavTargetGoal *goal,
+                           NavField *field);
+bool nav_seed_free_goal_field(const NavFrame *nav, const NavFreeGoalRequest *request,
+                              NavField *field);
+
+// Integrate a seeded detached field under the density penalties sealed
+// for this frame (by nav_build_requested_fields or the first cached
+// lookup), on the calling thread (scratch[0]). Cells hard-blocked in field->hardBlocked
+// are never entered, so callers can confine the search by blocking cells.
+void nav_integrate_detached_field(const NavFrame *nav, NavField *field);
+
 // ---------- Flow sampling ----------
 
-// Compute the integer per-cell flow direction for `cell` on `field`. Returns
-// the signed (dcol, drow) pair pointing to the 8-neighbor with the lowest
-// distance, or (0, 0) if the cell is unreachable or no neighbor improves on
-// it. The returned delta is in {-1, 0, 1} for each component.
+// True when `cell` of `field` holds its final distance: always, unless a
+// query-bounded build stopped before reaching it.
+bool nav_field_cell_settled(const NavField *field, int32_t cell);
+
+// Integer per-cell flow direction for `cell` on `field`, read from the
+// field's flowDir table or scanned without caching. Returns the signed (dcol, drow) pair pointing to
+// the 8-neighbor with the lowest distance, or (0, 0) if the cell is
+// unreachable or no neighbor improves on it. The returned delta is in
+// {-1, 0, 1} for each component.
 void nav_cell_flow_direction(const NavField *field, int32_t cell,
                               int *outDcol, int *outDrow);
 
@@ -554,7 +985,16 @@ void nav_cell_flow_direction(const NavField *field, int32_t cell,
 // output is the normalized direction a unit at (x, y) should step to follow
 // the flow field downhill toward the seed; if no nearby cells are reachable
 // the output is (0, 0). Writes through `outDx`/`outDy`.
-void nav_sample_flow(const NavField *field, float x, float y,
-                      float *outDx, float *outDy);
+//
+// Caches the directions it scans in field->flowDir, so the caller must own
+// the field: the simulation thread outside nav_build_requested_fields(),
+// never a build-stage worker or a concurrent reader.
+void nav_sample_flow(NavField *field, float x, float y,
+                     float *outDx, float *outDy);
+
+// nav_sample_flow without caching, for read-only callers (debug previews).
+// Returns the same vector.
+void nav_peek_flow(const NavField *field, float x, float y,
+                   float *outDx, float *outDy);
 
 #endif // NFC_CARDGAME_NAV_FRAME_H
@@ -2,9 +2,11 @@
 #include "combat.h"
 #include "base_geometry.h"
 #include "farmer.h"
+#include "orca.h"
 #include "../core/config.h"
 #include "../core/battlefield.h"
 #include "../entities/entities.h"
+#include "../entities/entity_pool.h"
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -143,89 +145,39 @@ static float pathfind_point_to_segment_dist(Vector2 p, Vector2 a, Vector2 b) {
     return sqrtf(dx * dx + dy * dy);
 }
 
-static float pathfind_segment_length(Vector2 a, Vector2 b) {
-    float dx = b.x - a.x;
-    float dy = b.y - a.y;
-    return sqrtf(dx * dx + dy * dy);
-}
-
+// Lane lengths, projections and waypoint lookups read the per-match tables
+// bf_init builds (lane_progress.h) instead of walking the polyline.
 static float pathfind_lane_total_length_for_side(const Battlefield *bf, BattleSide side, int lane) {
-    if (!bf) return 0.0f;
-    if (lane < 0 || lane >= 3) return 0.0f;
-
-    float total = 0.0f;
-    for (int wp = 0; wp < LANE_WAYPOINT_COUNT - 1; wp++) {
-        Vector2 a = bf_waypoint(bf, side, lane, wp).v;
-        Vector2 b = bf_waypoint(bf, side, lane, wp + 1).v;
-        total += pathfind_segment_length(a, b);
-    }
-    return total;
+    const LaneProgressTable *table = bf_lane_progress(bf, side, lane);
+    return table ? table->total : 0.0f;
 }
 
 static float pathfind_lane_progress_for_position_on_side(const Battlefield *bf,
                                                          BattleSide side, int lane,
                                                          Vector2 position,
                                                          Vector2 *outClosest) {
-    if (!bf) return 0.0f;
-    if (lane < 0 || lane >= 3) return 0.0f;
-
-    float bestDistSq = INFINITY;
-    float bestProgress = 0.0f;
-    Vector2 bestPoint = bf_waypoint(bf, side, lane, 0).v;
-    float accumulated = 0.0f;
-
-    for (int wp = 0; wp < LANE_WAYPOINT_COUNT - 1; wp++) {
-        Vector2 a = bf_waypoint(bf, side, lane, wp).v;
-        Vector2 b = bf_waypoint(bf, side, lane, wp + 1).v;
-        float abx = b.x - a.x;
-        float aby = b.y - a.y;
-        float abLenSq = abx * abx + aby * aby;
-        float t = 0.0f;
-        Vector2 closest = a;
-
-        if (abLenSq > 0.0001f) {
-            float apx = position.x - a.x;
-            float apy = position.y - a.y;
-            t = (apx * abx + apy * aby) / abLenSq;
-            if (t < 0.0f) t = 0.0f;
-            if (t > 1.0f) t = 1.0f;
-            closest.x = a.x + abx * t;
-            closest.y = a.y + aby * t;
-        }
-
-        float dx = position.x - closest.x;
-        float dy = position.y - closest.y;
-        float distSq = dx * dx + dy * dy;
-        float segmentLength = pathfind_segment_length(a, b);
-        if (distSq < bestDistSq) {
-            bestDistSq = distSq;
-            bestProgress = accumulated + segmentLength * t;
-            bestPoint = closest;
-        }
-
-        accumulated += segmentLength;
-    }
-
-    if (outClosest) *outClosest = bestPoint;
-    return bestProgress;
+    const LaneProgressTable *table = bf_lane_progress(bf, side, lane);
+    if (!table) return 0.0f;
+    return lane_progress_project(table, position, outClosest);
 }
 
 static Vector2 pathfind_lane_position_at_progress_on_side(const Battlefield *bf,
                                                           BattleSide side, int lane,
                                                           float progress) {
-    if (!bf || lane < 0 || lane >= 3) {
+    const LaneProgressTable *table = bf_lane_progress(bf, side, lane);
+    if (!table) {
         return (Vector2){ 0.0f, 0.0f };
     }
 
     if (progress <= 0.0f) {
-        return bf_waypoint(bf, side, lane, 0).v;
+        return table->points[0];
     }
 
     float remaining = progress;
     for (int wp = 0; wp < LANE_WAYPOINT_COUNT - 1; wp++) {
-        Vector2 a = bf_waypoint(bf, side, lane, wp).v;
-        Vector2 b = bf_waypoint(bf, side, lane, wp + 1).v;
-        float segmentLength = pathfind_segment_length(a, b);
+        Vector2 a = table->points[wp];
+        Vector2 b = table->points[wp + 1];
+        float segmentLength = table->segmentLength[wp];
 
         if (segmentLength <= 0.0001f) continue;
         if (remaining <= segmentLength) {
@@ -239,25 +191,15 @@ static Vector2 pathfind_lane_position_at_progress_on_side(const Battlefield *bf,
         remaining -= segmentLength;
     }
 
-    return bf_waypoint(bf, side, lane, LANE_WAYPOINT_COUNT - 1).v;
+    return table->points[LANE_WAYPOINT_COUNT - 1];
 }
 
 static int pathfind_waypoint_index_for_progress_on_side(const Battlefield *bf,
                                                         BattleSide side, int lane,
                                                         float progress) {
-    if (!bf || lane < 0 || lane >= 3) return -1;
-
-    float accumulated = 0.0f;
-    for (int wp = 1; wp < LANE_WAYPOINT_COUNT; wp++) {
-        Vector2 a = bf_waypoint(bf, side, lane, wp - 1).v;
-        Vector2 b = bf_waypoint(bf, side, lane, wp).v;
-        accumulated += pathfind_segment_length(a, b);
-        if (accumulated > progress + 0.001f) {
-            return wp;
-        }
-    }
-
-    return LANE_WAYPOINT_COUNT;
+    const LaneProgressTable *table = bf_lane_progress(bf, side, lane);
+    if (!table) return -1;
+    return lane_progress_waypoint_index(table, progress);
 }
 
 float pathfind_lane_progress_for_position(const Entity *e, const Battlefield *bf,
@@ -324,6 +266,94 @@ static float pathfind_nav_radius(const Entity *e) {
     return (e->navRadius > 0.0f) ? e->navRadius : e->bodyRadius;
 }
 
+// Per-mover blocker neighborhood. Candidate and rescue probes only react to
+// blockers whose footprint comes within a bounded reach of the mover, so each
+// step gathers that neighborhood once from the spatial grid instead of
+// walking the whole registry per probe. Mobile blockers come from a radius
+// query padded by the grid's largest mobile radius; anchored entities
+// (bases) are few and have offset footprints, so all of them are merged in.
+// The list is in ascending id order -- registry order -- so order-sensitive
+// sums (softOverlap) match a full scan exactly.
+//
+// The cache is keyed on (mover, position, reach) and dropped at every public
+// stepping entry point, since other movers may have moved in between.
+typedef struct {
+    Entity **items;
+    int capacity;
+    int count;
+    const Entity *owner;
+    Vector2 origin;
+    float reach;
+    bool valid;
+} PathfindNeighborCache;
+
+static PathfindNeighborCache s_pathfindNeighbors;
+
+static PathfindSteerStats s_pathfindSteerStats;
+
+static void pathfind_neighbors_invalidate(void) {
+    s_pathfindNeighbors.valid = false;
+}
+
+static bool pathfind_neighbor_is_mobile(const Entity *e, const void *ctx) {
+    (void)ctx;
+    return !spatial_grid_is_anchored(e);
+}
+
+// Blockers that can matter to `e` at any probe point within `reach` minus
+// the shell terms of its own position. Falls back to the full registry if
+// the cache buffer cannot be grown.
+static Entity *const *pathfind_neighbors_gather(const Entity *e, const Battlefield *bf,
+                                                float reach, int *outCount) {
+    PathfindNeighborCache *cache = &s_pathfindNeighbors;
+    if (cache->valid && cache->owner == e &&
+        cache->origin.x == e->position.x && cache->origin.y == e->position.y &&
+        cache->reach >= reach) {
+        *outCount = cache->count;
+        return cache->items;
+    }
+
+    const SpatialGrid *grid = &bf->spatial;
+    if (cache->capacity < grid->capacity) {
+        Entity **grown = realloc(cache->items, (size_t)grid->capacity * sizeof(Entity *));
+        if (!grown) {
+            cache->valid = false;
+            *outCount = bf->entityCount;
+            return bf->entities;
+        }
+        cache->items = grown;
+        cache->capacity = grid->capacity;
+    }
+
+    SpatialFilter filter = {
+        .owner = SPATIAL_OWNER_ANY,
+        .air = SPATIAL_AIR_ANY,
+        .accept = pathfind_neighbor_is_mobile,
+    };
+    int mobileCount = spatial_grid_query_radius(grid, e->position,
+                                                reach + grid->maxMobileRadius, &filter);
+
+    int m = 0;
+    int s = 0;
+    int count = 0;
+    while (m < mobileCount || s < grid->staticCount) {
+        if (s >= grid->staticCount ||
+            (m < mobileCount && grid->scratch[m]->id < grid->statics[s]->id)) {
+            cache->items[count++] = grid->scratch[m++];
+        } else {
+            cache->items[count++] = grid->statics[s++];
+        }
+    }
+
+    cache->count = count;
+    cache->owner = e;
+    cache->origin = e->position;
+    cache->reach = reach;
+    cache->valid = true;
+    *outCount = count;
+    return cache->items;
+}
+
 static float pathfind_static_traffic_radius(const Entity *target) {
     return pathfind_nav_radius(target);
 }
@@ -345,6 +375,11 @@ static Vector2 pathfind_static_blocker_center(const Entity *target) {
 }
 
 static float pathfind_farmer_home_base_cloud_radius(const Entity *e, const Entity *base);
+static bool pathfind_evaluate_candidate(const Entity *e, Vector2 goal,
+                                        Vector2 candidate, const Battlefield *bf,
+                                        Entity *const *neighbors, int neighborCount,
+                                        const PathfindStepParams *params,
+                                        PathfindCandidateEval *outEval);
 
 typedef enum {
     CONTACT_CLOUD_NONE = 0,
@@ -410,10 +445,12 @@ static const Entity *pathfind_farmer_home_base_target(const Entity *e, const Bat
         return movementTarget;
     }
 
+    // Bases are anchored, so the grid's id-ordered statics list holds every
+    // candidate in registry order.
     const Entity *best = NULL;
     float bestDistSq = INFINITY;
-    for (int i = 0; i < bf->entityCount; ++i) {
-        const Entity *other = bf->entities[i];
+    for (int i = 0; i < bf->spatial.staticCount; ++i) {
+        const Entity *other = bf->spatial.statics[i];
         if (!other || other == e) continue;
         if (!other->alive || other->markedForRemoval) continue;
         if (other->type != ENTITY_BUILDING) continue;
@@ -480,6 +517,9 @@ static void pathfind_build_free_goal_request(const Entity *e, const Battlefield
         .carveCenterX = 0.0f,
         .carveCenterY = 0.0f,
         .carveInnerRadius = 0.0f,
+        .hasRequester = true,
+        .requesterX = e->position.x,
+        .requesterY = e->position.y,
     };
 }
 
@@ -645,6 +685,9 @@ static bool pathfind_build_target_nav_goal(const Entity *e, const Entity *target
                           (float)PATHFIND_CONTACT_GAP;
     goal.targetId = target->id;
     goal.perspectiveSide = (int16_t)ownerSide;
+    goal.hasRequester = true;
+    goal.requesterX = e->position.x;
+    goal.requesterY = e->position.y;
 
     if (isStatic) {
         goal.kind = NAV_GOAL_KIND_STATIC_ATTACK;
@@ -683,9 +726,13 @@ static bool pathfind_candidate_within_lane_corridor(const Entity *e,
     float maxDist = laneWidth * PATHFIND_LANE_DRIFT_MAX_RATIO;
     float bestDist = INFINITY;
 
+    // The nearest segment is always among the cell's candidates.
+    const LaneProgressTable *table = bf_lane_progress(bf, ownerSide, e->lane);
+    uint8_t segments = lane_progress_candidates(table, candidate);
     for (int wp = 0; wp < LANE_WAYPOINT_COUNT - 1; wp++) {
-        Vector2 a = bf_waypoint(bf, ownerSide, e->lane, wp).v;
-        Vector2 b = bf_waypoint(bf, ownerSide, e->lane, wp + 1).v;
+        if (!(segments & (1u << wp))) continue;
+        Vector2 a = table->points[wp];
+        Vector2 b = table->points[wp + 1];
         float dist = pathfind_point_to_segment_dist(candidate, a, b);
         if (dist < bestDist) bestDist = dist;
     }
@@ -762,12 +809,12 @@ static int pathfind_candidate_lateral_sign(Vector2 forward, Vector2 stepDir) {
 }
 
 static bool pathfind_position_in_hardblocked_mask(Vector2 position,
-                                                  const uint8_t *hardBlockedMask) {
+                                                  const uint64_t *hardBlockedMask) {
     if (!hardBlockedMask) return false;
 
     int32_t cell = nav_cell_index_for_world(position.x, position.y);
     if (cell < 0 || cell >= NAV_CELLS) return false;
-    return hardBlockedMask[cell] != 0;
+    return nav_bit_test(hardBlockedMask, cell);
 }
 
 static bool pathfind_position_is_rescue_safe(const Entity *e, Vector2 candidate,
@@ -775,9 +822,16 @@ static bool pathfind_position_is_rescue_safe(const Entity *e, Vector2 candidate,
     if (!e || !bf) return false;
     if (!pathfind_candidate_in_bounds(e, bf, candidate)) return false;
 
+    // Rescue probes are nav cell centers at most RESCUE_MAX_RADIUS_CELLS
+    // rings out from the mover's cell.
     float selfRadius = pathfind_nav_radius(e);
-    for (int i = 0; i < bf->entityCount; ++i) {
-        const Entity *other = bf->entities[i];
+    float probeReach = (PATHFIND_BLOCKER_RESCUE_MAX_RADIUS_CELLS + 0.5f) *
+                       (float)NAV_CELL_SIZE * sqrtf(2.0f);
+    int neighborCount = 0;
+    Entity *const *neighbors = pathfind_neighbors_gather(
+        e, bf, probeReach + selfRadius + PATHFIND_CONTACT_GAP, &neighborCount);
+    for (int i = 0; i < neighborCount; ++i) {
+        const Entity *other = neighbors[i];
         if (!pathfind_is_blocker(e, other)) continue;
 
         Vector2 blockerCenter = other->position;
@@ -814,13 +868,13 @@ static bool pathfind_position_is_rescue_safe(const Entity *e, Vector2 candidate,
 
 static bool pathfind_try_blocker_rescue_teleport(Entity *e, Vector2 goal,
                                                  const Battlefield *bf,
-                                                 const uint8_t *hardBlockedMask) {
+                                                 const uint64_t *hardBlockedMask) {
     if (!e || !bf || !hardBlockedMask) return false;
     if (e->ticksSinceProgress < PATHFIND_BLOCKER_RESCUE_TICKS) return false;
 
     int32_t currentCell = nav_cell_index_for_world(e->position.x, e->position.y);
     if (currentCell < 0 || currentCell >= NAV_CELLS) return false;
-    if (!hardBlockedMask[currentCell]) return false;
+    if (!nav_bit_test(hardBlockedMask, currentCell)) return false;
 
     NavCellCoord origin = nav_cell_coord(currentCell);
     bool found = false;
@@ -839,7 +893,7 @@ static bool pathfind_try_blocker_rescue_teleport(Entity *e, Vector2 goal,
                 }
 
                 int32_t idx = nav_index(col, row);
-                if (hardBlockedMask[idx]) continue;
+                if (nav_bit_test(hardBlockedMask, idx)) continue;
 
                 float cx = 0.0f;
                 float cy = 0.0f;
@@ -874,11 +928,306 @@ static bool pathfind_try_blocker_rescue_teleport(Entity *e, Vector2 goal,
 
     e->position = bestCandidate;
     e->ticksSinceProgress = 0;
+    s_pathfindSteerStats.rescues++;
     pathfind_sync_presentation(e, bf);
     pathfind_face_goal(e, bf, goal);
     return true;
 }
 
+// ORCA crowd avoidance, opted into per UnitNavProfile by the NavFrame's
+// orcaProfiles mask (PATHFIND_ORCA_PROFILES, pathfind_set_orca_profiles), so
+// each match carries its own setting. Without a nav snapshot every mover
+// keeps the fan. Enabled movers keep their flow fields as the preferred
+// velocity but move along the ORCA velocity, and try one ORCA step before
+// the candidate fan and jam relief. Walking neighbors that also use ORCA
+// take half of each avoidance; statics, fan-steered and non-walking units
+// are avoided in full, and so are the nearby cells the stepper would
+// refuse to enter (moat, base cores, lane corridor edges). Contact-cloud
+// pairs stay exempt, as they are from the fan's legality check.
+_Static_assert(PATHFIND_ORCA_MAX_NEIGHBORS > 0 && PATHFIND_ORCA_MAX_BLOCKED_CELLS > 0 &&
+               PATHFIND_ORCA_MAX_NEIGHBORS + PATHFIND_ORCA_MAX_BLOCKED_CELLS <
+                   ORCA_MAX_NEIGHBORS,
+               "ORCA solves need room for at least one static neighbor");
+
+void pathfind_set_orca_profiles(NavFrame *nav, uint32_t profileMask) {
+    if (!nav) return;
+    nav->orcaProfiles = profileMask;
+}
+
+static bool pathfind_orca_enabled(const NavFrame *nav, const Entity *e) {
+    if (!nav || !e || e->navProfile == NAV_PROFILE_STATIC) return false;
+    return ((nav->orcaProfiles >> (unsigned)e->navProfile) & 1u) != 0;
+}
+
+// Up to PATHFIND_ORCA_MAX_BLOCKED_CELLS cells of `blockedMask` nearest to
+// `e`, as hard ORCA neighbors, nearest first. The steppers only test the
+// mover's center against blocked cells, so each cell is a disk
+// circumscribing its square around which the center (not the body) must
+// pass: the solver adds selfRadius back. The cell under the mover is
+// skipped -- the rescue teleport owns that case.
+static int pathfind_orca_gather_blocked_cells(const Entity *e, float selfRadius,
+                                              const uint64_t *blockedMask,
+                                              OrcaNeighbor *out) {
+    if (!blockedMask) return 0;
+
+    const float cellRadius = (float)NAV_CELL_SIZE * 0.70710678f;
+    const float reach = cellRadius + PATHFIND_ORCA_NEIGHBOR_GAP;
+    int32_t c0 = (int32_t)floorf((e->position.x - reach) / (float)NAV_CELL_SIZE);
+    int32_t c1 = (int32_t)floorf((e->position.x + reach) / (float)NAV_CELL_SIZE);
+    int32_t r0 = (int32_t)floorf((e->position.y - reach) / (float)NAV_CELL_SIZE);
+    int32_t r1 = (int32_t)floorf((e->position.y + reach) / (float)NAV_CELL_SIZE);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 > NAV_COLS - 1) c1 = NAV_COLS - 1;
+    if (r1 > NAV_ROWS - 1) r1 = NAV_ROWS - 1;
+    int32_t selfCell = nav_cell_index_for_world(e->position.x, e->position.y);
+
+    float cellGap[PATHFIND_ORCA_MAX_BLOCKED_CELLS];
+    int count = 0;
+    for (int32_t row = r0; row <= r1; ++row) {
+        float cy = ((float)row + 0.5f) * (float)NAV_CELL_SIZE;
+        for (int32_t col = c0; col <= c1; ++col) {
+            int32_t idx = nav_index(col, row);
+            if (idx == selfCell || !nav_bit_test(blockedMask, idx)) continue;
+
+            float cx = ((float)col + 0.5f) * (float)NAV_CELL_SIZE;
+            float dx = cx - e->position.x;
+            float dy = cy - e->position.y;
+            float gap = sqrtf(dx * dx + dy * dy) - cellRadius;
+            if (gap > PATHFIND_ORCA_NEIGHBOR_GAP) continue;
+            if (count == PATHFIND_ORCA_MAX_BLOCKED_CELLS && gap >= cellGap[count - 1]) {
+                continue;
+            }
+
+            int slot = (count < PATHFIND_ORCA_MAX_BLOCKED_CELLS) ? count++ : count - 1;
+            while (slot > 0 && cellGap[slot - 1] > gap) {
+                out[slot] = out[slot - 1];
+                cellGap[slot] = cellGap[slot - 1];
+                slot--;
+            }
+            out[slot] = (OrcaNeighbor){
+                .position = { cx, cy },
+                .radius = cellRadius - selfRadius,
+                .responsibility = 1.0f,
+            };
+            cellGap[slot] = gap;
+        }
+    }
+    return count;
+}
+
+// Collision-free velocity (px/s) for `e` closest to `preferred`. Cells set
+// in `blockedMask` (the stepper's hard-blocked mask, or NULL) are avoided
+// like statics.
+static Vector2 pathfind_orca_velocity(const Entity *e, const NavFrame *nav,
+                                      const Battlefield *bf,
+                                      const uint64_t *blockedMask,
+                                      Vector2 preferred, float deltaTime) {
+    float selfRadius = pathfind_nav_radius(e);
+    int neighborCount = 0;
+    Entity *const *neighbors = pathfind_neighbors_gather(
+        e, bf, selfRadius + PATHFIND_ORCA_NEIGHBOR_GAP, &neighborCount);
+
+    // Static entities and blocked cells first (the solver never relaxes
+    // them), then the nearest mobile neighbors by surface gap; equal gaps
+    // keep registry order.
+    OrcaNeighbor solve[ORCA_MAX_NEIGHBORS];
+    OrcaNeighbor cells[PATHFIND_ORCA_MAX_BLOCKED_CELLS];
+    OrcaNeighbor mobile[PATHFIND_ORCA_MAX_NEIGHBORS];
+    float mobileGap[PATHFIND_ORCA_MAX_NEIGHBORS];
+    int staticCount = 0;
+    int mobileCount = 0;
+    const int staticCap = ORCA_MAX_NEIGHBORS - PATHFIND_ORCA_MAX_NEIGHBORS -
+                          PATHFIND_ORCA_MAX_BLOCKED_CELLS;
+
+    for (int i = 0; i < neighborCount; i++) {
+        const Entity *other = neighbors[i];
+        if (!pathfind_is_blocker(e, other)) continue;
+        float cloudPenaltyScale = 0.0f;
+        if (pathfind_allows_contact_cloud_overlap(e, e->position, other, bf,
+                                                  &cloudPenaltyScale)) {
+            continue;
+        }
+
+        bool isStatic = other->type == ENTITY_BUILDING ||
+                        other->navProfile == NAV_PROFILE_STATIC;
+        Vector2 center = other->position;
+        if (pathfind_is_current_static_target(e, other)) {
+            center = pathfind_target_anchor(other);
+        } else if (isStatic) {
+            center = pathfind_static_blocker_center(other);
+        }
+        float radius = pathfind_blocker_radius_for_self(e, other) + PATHFIND_CONTACT_GAP;
+        if (pathfind_is_soft_blocker(e, other)) {
+            radius -= pathfind_soft_overlap_allowance(e, other);
+        }
+
+        float dx = center.x - e->position.x;
+        float dy = center.y - e->position.y;
+        float gap = sqrtf(dx * dx + dy * dy) - selfRadius - radius;
+        if (gap > PATHFIND_ORCA_NEIGHBOR_GAP) continue;
+
+        OrcaNeighbor n = {
+            .position = { center.x, center.y },
+            .radius = radius,
+            .responsibility = 1.0f,
+        };
+        if (isStatic) {
+            if (staticCount < staticCap) solve[staticCount++] = n;
+            continue;
+        }
+        if (other->state == ESTATE_WALKING) {
+            n.velocity = (OrcaVec2){ other->navVelocity.x, other->navVelocity.y };
+            if (pathfind_orca_enabled(nav, other)) n.responsibility = 0.5f;
+        }
+
+        if (mobileCount == PATHFIND_ORCA_MAX_NEIGHBORS &&
+            gap >= mobileGap[mobileCount - 1]) {
+            continue;
+        }
+        int slot = (mobileCount < PATHFIND_ORCA_MAX_NEIGHBORS) ? mobileCount++
+                                                               : mobileCount - 1;
+        while (slot > 0 && mobileGap[slot - 1] > gap) {
+            mobile[slot] = mobile[slot - 1];
+            mobileGap[slot] = mobileGap[slot - 1];
+            slot--;
+        }
+        mobile[slot] = n;
+        mobileGap[slot] = gap;
+    }
+
+    int cellCount = pathfind_orca_gather_blocked_cells(e, selfRadius, blockedMask, cells);
+    int hardCount = staticCount + cellCount;
+    for (int i = 0; i < cellCount; i++) {
+        solve[staticCount + i] = cells[i];
+    }
+    for (int i = 0; i < mobileCount; i++) {
+        solve[hardCount + i] = mobile[i];
+    }
+
+    OrcaAgent agent = {
+        .position = { e->position.x, e->position.y },
+        .velocity = { e->navVelocity.x, e->navVelocity.y },
+        .radius = selfRadius,
+        .maxSpeed = e->moveSpeed,
+        .preferredVelocity = { preferred.x, preferred.y },
+        .timeHorizon = PATHFIND_ORCA_TIME_HORIZON_S,
+        .timeStep = deltaTime,
+    };
+    OrcaVec2 v = orca_solve(&agent, solve, hardCount + mobileCount, hardCount);
+    s_pathfindSteerStats.orcaSolves++;
+    return (Vector2){ v.x, v.y };
+}
+
+// Flow steppers: turn the sampled unit flow (times moveSpeed) into the ORCA
+// velocity's direction and this tick's step length, avoiding the cells the
+// stepper will reject (`field->hardBlocked`). No-op for fan movers.
+static void pathfind_orca_filter_flow(const Entity *e, const NavFrame *nav,
+                                      const Battlefield *bf, const NavField *field,
+                                      float deltaTime, float *fx, float *fy,
+                                      float *totalStep) {
+    if (!pathfind_orca_enabled(nav, e) || deltaTime <= 0.0f) return;
+
+    Vector2 preferred = { *fx * e->moveSpeed, *fy * e->moveSpeed };
+    Vector2 v = pathfind_orca_velocity(e, nav, bf, field->hardBlocked,
+                                       preferred, deltaTime);
+    float speed = sqrtf(v.x * v.x + v.y * v.y);
+    if (speed <= 0.0001f) {
+        *totalStep = 0.0f;
+        return;
+    }
+    *fx = v.x / speed;
+    *fy = v.y / speed;
+    *totalStep = fminf(speed, e->moveSpeed) * deltaTime;
+}
+
+// One ORCA step toward `goal`, at most `step` long, in place of the
+// candidate fan. The result must pass the fan's own candidate check --
+// bounds, lane corridor and every blocker's hard shell -- since ORCA only
+// sees its nearest neighbors and relaxes soft constraints when crowded;
+// only the goal-distance limit is waived, so the mover may give way. It
+// must also stay out of static-blocked nav cells: the fan's check does not
+// test them, and without this crowded ORCA steps reach the board-edge moat
+// and wait there for the blocker rescue teleport.
+// Returns false (nothing moved) when the velocity is zero or the candidate
+// is illegal; the caller then falls back to the fan.
+static bool pathfind_try_orca_step(Entity *e, Vector2 goal, const NavFrame *nav,
+                                   const Battlefield *bf,
+                                   float step, float deltaTime,
+                                   const PathfindStepParams *params,
+                                   int *outLateralSign) {
+    float dx = goal.x - e->position.x;
+    float dy = goal.y - e->position.y;
+    float goalDist = sqrtf(dx * dx + dy * dy);
+    if (goalDist < 0.001f || deltaTime <= 0.0f) return false;
+
+    s_pathfindSteerStats.orcaSteps++;
+    Vector2 forward = { dx / goalDist, dy / goalDist };
+    float preferredSpeed = step / deltaTime;
+    Vector2 preferred = { forward.x * preferredSpeed, forward.y * preferredSpeed };
+    Vector2 v = pathfind_orca_velocity(e, nav, bf, nav->staticBlockers.blocked,
+                                       preferred, deltaTime);
+
+    Vector2 delta = { v.x * deltaTime, v.y * deltaTime };
+    float len = sqrtf(delta.x * delta.x + delta.y * delta.y);
+    if (len <= 0.0001f) return false;
+    if (len > step) {
+        delta.x *= step / len;
+        delta.y *= step / len;
+        len = step;
+    }
+
+    Vector2 candidate = { e->position.x + delta.x, e->position.y + delta.y };
+    PathfindStepParams orcaParams = *params;
+    orcaParams.maxGoalDist = INFINITY;
+    int neighborCount = 0;
+    Entity *const *neighbors = pathfind_neighbors_gather(
+        e, bf,
+        step + pathfind_nav_radius(e) + PATHFIND_CONTACT_GAP + PATHFIND_CLEARANCE_SCORE_CAP,
+        &neighborCount);
+    PathfindCandidateEval eval;
+    if (pathfind_position_in_hardblocked_mask(candidate, nav->staticBlockers.blocked) ||
+        !pathfind_evaluate_candidate(e, goal, candidate, bf, neighbors, neighborCount,
+                                     &orcaParams, &eval) ||
+        !eval.legal) {
+        s_pathfindSteerStats.orcaRejects++;
+        return false;
+    }
+
+    e->position = candidate;
+    if (outLateralSign) *outLateralSign = eval.lateralSign;
+    return true;
+}
+
+// Close out one stepping call: record the step velocity ORCA neighbors read
+// and count it. `walking` is false once the mover arrived or went idle.
+static void pathfind_finish_step(Entity *e, Vector2 start, float deltaTime, bool walking) {
+    float dx = e->position.x - start.x;
+    float dy = e->position.y - start.y;
+    bool moved = (dx != 0.0f || dy != 0.0f);
+
+    e->navVelocity = (Vector2){ 0.0f, 0.0f };
+    if (moved && deltaTime > 0.0f) {
+        float speed = sqrtf(dx * dx + dy * dy) / deltaTime;
+        // Rescue teleports are not motion other movers should extrapolate.
+        float scale = (speed > e->moveSpeed) ? e->moveSpeed / speed : 1.0f;
+        e->navVelocity = (Vector2){ dx / deltaTime * scale, dy / deltaTime * scale };
+    }
+
+    if (moved || walking) {
+        s_pathfindSteerStats.steps++;
+        if (!moved) s_pathfindSteerStats.stalls++;
+    }
+}
+
+PathfindSteerStats pathfind_steer_stats(void) {
+    return s_pathfindSteerStats;
+}
+
+void pathfind_reset_steer_stats(void) {
+    s_pathfindSteerStats = (PathfindSteerStats){ 0 };
+}
+
 static bool pathfind_static_target_flow_active(const Entity *e, const Battlefield *bf) {
     if (!e || !bf || e->navProfile != NAV_PROFILE_ASSAULT) return false;
 
@@ -953,8 +1302,12 @@ static float pathfind_static_target_flow_preference(const Entity *e, Vector2 can
     return fabsf(candidateCross) * fabsf(desiredCross) * candidateForward * ramp;
 }
 
+// `neighbors` must hold every blocker whose hard shell plus
+// PATHFIND_CLEARANCE_SCORE_CAP reaches `candidate`; blockers farther out can
+// neither make the candidate illegal nor change its capped clearance score.
 static bool pathfind_evaluate_candidate(const Entity *e, Vector2 goal,
                                         Vector2 candidate, const Battlefield *bf,
+                                        Entity *const *neighbors, int neighborCount,
                                         const PathfindStepParams *params,
                                         PathfindCandidateEval *outEval) {
     if (!e || !bf || !params || !outEval) return false;
@@ -987,8 +1340,8 @@ static bool pathfind_evaluate_candidate(const Entity *e, Vector2 goal,
     Vector2 stepDir = { stepVec.x / stepLen, stepVec.y / stepLen };
 
     float selfRadius = pathfind_nav_radius(e);
-    for (int i = 0; i < bf->entityCount; i++) {
-        const Entity *other = bf->entities[i];
+    for (int i = 0; i < neighborCount; i++) {
+        const Entity *other = neighbors[i];
         if (!pathfind_is_blocker(e, other)) continue;
 
         Vector2 blockerCenter = other->position;
@@ -1090,7 +1443,9 @@ static float pathfind_candidate_score(const Entity *e,
     }
 
     float cappedClearance = eval->minHardClearance;
-    if (cappedClearance > 32.0f) cappedClearance = 32.0f;
+    if (cappedClearance > PATHFIND_CLEARANCE_SCORE_CAP) {
+        cappedClearance = PATHFIND_CLEARANCE_SCORE_CAP;
+    }
 
     return eval->progress * progressWeight +
            cappedClearance * clearanceWeight -
@@ -1120,13 +1475,21 @@ static bool pathfind_select_best_candidate(const Entity *e, Vector2 goal,
     float bestGoalDist = INFINITY;
     int bestLateralSign = 0;
 
+    int neighborCount = 0;
+    Entity *const *neighbors = pathfind_neighbors_gather(
+        e, bf,
+        probeStep + pathfind_nav_radius(e) + PATHFIND_CONTACT_GAP +
+            PATHFIND_CLEARANCE_SCORE_CAP,
+        &neighborCount);
+
     for (int i = 0; i < directionCount; i++) {
         Vector2 candidate = {
             e->position.x + directions[i].x * probeStep,
             e->position.y + directions[i].y * probeStep
         };
         PathfindCandidateEval eval;
-        if (!pathfind_evaluate_candidate(e, goal, candidate, bf, params, &eval) ||
+        if (!pathfind_evaluate_candidate(e, goal, candidate, bf, neighbors, neighborCount,
+                                         params, &eval) ||
             !eval.legal) {
             continue;
         }
@@ -1161,7 +1524,7 @@ static bool pathfind_try_normal_march(Entity *e, Vector2 goal, const Battlefield
     Vector2 forward = { dx / goalDist, dy / goalDist };
     bool preferLeft = (e->lastSteerSideSign != 0)
         ? (e->lastSteerSideSign < 0)
-        : ((e->id & 1) == 0);
+        : ((entity_id_serial(e->id) & 1) == 0);
     float softSign = preferLeft ? -1.0f : 1.0f;
     float hardSign = preferLeft ? -1.0f : 1.0f;
     float sideSign = preferLeft ? -1.0f : 1.0f;
@@ -1207,7 +1570,7 @@ static bool pathfind_try_jam_relief(Entity *e, Vector2 goal, const Battlefield *
     Vector2 forward = { dx / goalDist, dy / goalDist };
     bool preferLeft = (e->lastSteerSideSign != 0)
         ? (e->lastSteerSideSign < 0)
-        : ((e->id & 1) == 0);
+        : ((entity_id_serial(e->id) & 1) == 0);
     float sideSign = preferLeft ? -1.0f : 1.0f;
     float escapeSign = preferLeft ? -1.0f : 1.0f;
 
@@ -1252,10 +1615,15 @@ static bool pathfind_try_jam_relief(Entity *e, Vector2 goal, const Battlefield *
 //                drift check (free movers aren't bound to a lane polyline).
 //  STATIC     -- no motion; returns false and keeps ticksSinceProgress ticking.
 //
+// Profiles in nav's ORCA mask (pathfind_set_orca_profiles) first try one
+// pathfind_try_orca_step and use the fan and jam relief only when it
+// yields no legal step; a NULL nav keeps the fan.
+//
 // The `allowJamRelief` and `enforceLaneCorridor` parameters only apply to
 // the LANE branch; FREE_GOAL overrides them with its own authoritative
 // values so farmer callers (which pass both as false) still get jam relief.
 static bool pathfind_try_step_toward(Entity *e, Vector2 goal, float stopRadius,
+                                     const NavFrame *nav,
                                      const Battlefield *bf, float deltaTime,
                                      bool allowJamRelief,
                                      bool enforceLaneCorridor) {
@@ -1298,27 +1666,23 @@ static bool pathfind_try_step_toward(Entity *e, Vector2 goal, float stopRadius,
                 params.enforceLaneCorridor = false;
                 params.allowJamRelief = true;
                 params.jamReliefTicks = PATHFIND_ASSAULT_JAM_RELIEF_TICKS;
-                moved = pathfind_try_normal_march(e, goal, bf, step, &params, &lateralSign);
-                if (!moved) {
-                    moved = pathfind_try_jam_relief(e, goal, bf, step, goalDist,
-                                                    &params, &lateralSign);
-                }
             } else if (e->navProfile == NAV_PROFILE_FREE_GOAL) {
                 float lateralSlack = step * PATHFIND_FREE_MOVER_LATERAL_TOLERANCE_RATIO;
                 params.maxGoalDist = goalDist + lateralSlack;
                 params.enforceLaneCorridor = false;
                 params.allowJamRelief = true;
+            }
+
+            if (pathfind_orca_enabled(nav, e)) {
+                moved = pathfind_try_orca_step(e, goal, nav, bf, step, deltaTime,
+                                               &params, &lateralSign);
+            }
+            if (!moved) {
                 moved = pathfind_try_normal_march(e, goal, bf, step, &params, &lateralSign);
-                if (!moved) {
-                    moved = pathfind_try_jam_relief(e, goal, bf, step, goalDist,
-                                                    &params, &lateralSign);
-                }
-            } else {
-                moved = pathfind_try_normal_march(e, goal, bf, step, &params, &lateralSign);
-                if (!moved && params.allowJamRelief) {
-                    moved = pathfind_try_jam_relief(e, goal, bf, step, goalDist,
-                                                    &params, &lateralSign);
-                }
+            }
+            if (!moved && params.allowJamRelief) {
+                moved = pathfind_try_jam_relief(e, goal, bf, step, goalDist,
+                                                &params, &lateralSign);
             }
         }
     }
@@ -1368,7 +1732,7 @@ static bool pathfind_step_free_goal_flow(Entity *e, Vector2 goal,
 
     NavFreeGoalRequest request;
     pathfind_build_free_goal_request(e, bf, goal, stopRadius, &request);
-    const NavField *field = nav_get_or_build_free_goal_field(nav, bf, &request);
+    NavField *field = nav_get_or_build_free_goal_field(nav, bf, &request);
     if (!field) return false;
 
     float fx = 0.0f, fy = 0.0f;
@@ -1384,6 +1748,7 @@ static bool pathfind_step_free_goal_flow(Entity *e, Vector2 goal,
 
     float totalStep = e->moveSpeed * deltaTime;
     if (totalStep < 0.0f) totalStep = 0.0f;
+    pathfind_orca_filter_flow(e, nav, bf, field, deltaTime, &fx, &fy, &totalStep);
     float maxSub = (float)NAV_CELL_SIZE * 0.5f;
     int32_t subCount = 1;
     if (totalStep > maxSub) {
@@ -1398,7 +1763,7 @@ static bool pathfind_step_free_goal_flow(Entity *e, Vector2 goal,
         float tryX = posX + fx * subLen;
         float tryY = posY + fy * subLen;
         int32_t tryCell = nav_cell_index_for_world(tryX, tryY);
-        if (field->hardBlocked[tryCell]) {
+        if (nav_bit_test(field->hardBlocked, tryCell)) {
             // If the first sampled move is blocked, let the outer caller
             // fall back to local steering for this tick instead of consuming
             // the update with a no-op stall against the blocker lip.
@@ -1450,11 +1815,10 @@ static bool pathfind_step_free_goal_flow(Entity *e, Vector2 goal,
     return true;
 }
 
-bool pathfind_move_toward_goal(Entity *e, Vector2 goal, float stopRadius,
-                               NavFrame *nav, const Battlefield *bf,
-                               float deltaTime) {
+static bool pathfind_step_toward_free_goal(Entity *e, Vector2 goal, float stopRadius,
+                                           NavFrame *nav, const Battlefield *bf,
+                                           float deltaTime) {
     const float arriveEpsilon = 0.01f;
-    if (!e || !bf) return true;
 
     float dx = goal.x - e->position.x;
     float dy = goal.y - e->position.y;
@@ -1479,9 +1843,9 @@ bool pathfind_move_toward_goal(Entity *e, Vector2 goal, float stopRadius,
     }
 
     int prevTicksSinceProgress = e->ticksSinceProgress;
-    bool moved = pathfind_try_step_toward(e, goal, stopRadius, bf, deltaTime, false, false);
+    bool moved = pathfind_try_step_toward(e, goal, stopRadius, nav, bf, deltaTime, false, false);
     if (nav) {
-        const uint8_t *hardBlockedMask = nav->staticBlockers.blocked;
+        const uint64_t *hardBlockedMask = nav->staticBlockers.blocked;
         NavFreeGoalRequest request;
         pathfind_build_free_goal_request(e, bf, goal, stopRadius, &request);
         const NavField *field = nav_find_free_goal_field(nav, &request);
@@ -1506,6 +1870,18 @@ bool pathfind_move_toward_goal(Entity *e, Vector2 goal, float stopRadius,
     return false;
 }
 
+bool pathfind_move_toward_goal(Entity *e, Vector2 goal, float stopRadius,
+                               NavFrame *nav, const Battlefield *bf,
+                               float deltaTime) {
+    if (!e || !bf) return true;
+    pathfind_neighbors_invalidate();
+
+    Vector2 start = e->position;
+    bool arrived = pathfind_step_toward_free_goal(e, goal, stopRadius, nav, bf, deltaTime);
+    pathfind_finish_step(e, start, deltaTime, !arrived);
+    return arrived;
+}
+
 static bool pathfind_debug_preview_step_for_field(const Entity *e,
                                                   const NavField *field,
                                                   Vector2 goal,
@@ -1520,7 +1896,7 @@ static bool pathfind_debug_preview_step_for_field(const Entity *e,
 
     float fx = 0.0f;
     float fy = 0.0f;
-    nav_sample_flow(field, e->position.x, e->position.y, &fx, &fy);
+    nav_peek_flow(field, e->position.x, e->position.y, &fx, &fy);
     if (outFlowX) *outFlowX = fx;
     if (outFlowY) *outFlowY = fy;
     if (fx == 0.0f && fy == 0.0f) return false;
@@ -1548,7 +1924,7 @@ static bool pathfind_debug_preview_step_for_field(const Entity *e,
         float tryX = posX + fx * subLen;
         float tryY = posY + fy * subLen;
         int32_t tryCell = nav_cell_index_for_world(tryX, tryY);
-        if (field->hardBlocked[tryCell]) break;
+        if (nav_bit_test(field->hardBlocked, tryCell)) break;
         if (target) {
             Vector2 targetAnchor = pathfind_target_anchor(target);
             float dxTarget = tryX - targetAnchor.x;
@@ -1704,7 +2080,7 @@ static void pathfind_step_lane_flow(Entity *e, NavFrame *nav,
                                       BattleSide ownerSide,
                                       Vector2 facingGoal,
                                       float deltaTime) {
-    const NavField *field = nav_get_or_build_lane_field(nav, bf, ownerSide, e->lane);
+    NavField *field = nav_get_or_build_lane_field(nav, bf, ownerSide, e->lane);
     if (!field) {
         if (pathfind_try_blocker_rescue_teleport(e, facingGoal, bf,
                                                  nav->staticBlockers.blocked)) {
@@ -1735,6 +2111,7 @@ static void pathfind_step_lane_flow(Entity *e, NavFrame *nav,
     // moveSpeeds this is indistinguishable from re-sampling per sub-step.
     float totalStep = e->moveSpeed * deltaTime;
     if (totalStep < 0.0f) totalStep = 0.0f;
+    pathfind_orca_filter_flow(e, nav, bf, field, deltaTime, &fx, &fy, &totalStep);
     float maxSub = (float)NAV_CELL_SIZE * 0.5f;
     int32_t subCount = 1;
     if (totalStep > maxSub) {
@@ -1757,7 +2134,7 @@ static void pathfind_step_lane_flow(Entity *e, NavFrame *nav,
         // (instead of nav->staticBlockers) is what actually enforces
         // the corridor at step time -- a bilinearly-blended flow
         // vector that points across a corridor edge no longer leaks.
-        if (field->hardBlocked[tryCell]) {
+        if (nav_bit_test(field->hardBlocked, tryCell)) {
             break;
         }
         posX = tryX;
@@ -1840,7 +2217,7 @@ static bool pathfind_step_target_flow(Entity *e, NavFrame *nav,
         return false;
     }
 
-    const NavField *field = nav_get_or_build_target_field(nav, bf, &goal);
+    NavField *field = nav_get_or_build_target_field(nav, bf, &goal);
     if (!field) return false;
 
     float fx = 0.0f, fy = 0.0f;
@@ -1860,6 +2237,7 @@ static bool pathfind_step_target_flow(Entity *e, NavFrame *nav,
 
     float totalStep = e->moveSpeed * deltaTime;
     if (totalStep < 0.0f) totalStep = 0.0f;
+    pathfind_orca_filter_flow(e, nav, bf, field, deltaTime, &fx, &fy, &totalStep);
     float maxSub = (float)NAV_CELL_SIZE * 0.5f;
     int32_t subCount = 1;
     if (totalStep > maxSub) {
@@ -1888,7 +2266,7 @@ static bool pathfind_step_target_flow(Entity *e, NavFrame *nav,
         // Target-field hardBlocked mirrors nav->staticBlockers plus any
         // per-field mask; checking it keeps the attacker out of base
         // footprints and the board-edge moat.
-        if (field->hardBlocked[tryCell]) break;
+        if (nav_bit_test(field->hardBlocked, tryCell)) break;
         // Target-body contact shell. Refuse sub-steps that would pull
         // the attacker center inside (attacker.body + target.body +
         // gap). For STATIC targets this is already enforced by the
@@ -1933,12 +2311,46 @@ static bool pathfind_step_target_flow(Entity *e, NavFrame *nav,
     return true;
 }
 
+// Local steering with no flow field: one pathfind_try_step_toward step,
+// then the static-blocker rescue if the mover is stuck inside a blocked cell.
+static void pathfind_step_local(Entity *e, Vector2 goal, float stopRadius,
+                                const NavFrame *nav, const Battlefield *bf,
+                                float deltaTime) {
+    int prevTicksSinceProgress = e->ticksSinceProgress;
+    bool moved = pathfind_try_step_toward(e, goal, stopRadius, nav, bf, deltaTime, true, true);
+    if (!nav) return;
+    if (moved &&
+        pathfind_position_in_hardblocked_mask(e->position, nav->staticBlockers.blocked)) {
+        e->ticksSinceProgress = prevTicksSinceProgress + 1;
+    }
+    (void)pathfind_try_blocker_rescue_teleport(e, goal, bf, nav->staticBlockers.blocked);
+}
+
+bool pathfind_step_local_toward(Entity *e, Vector2 goal, float stopRadius,
+                                NavFrame *nav, const Battlefield *bf,
+                                float deltaTime) {
+    if (!e || !bf) return true;
+    pathfind_neighbors_invalidate();
+
+    Vector2 start = e->position;
+    pathfind_step_local(e, goal, stopRadius, nav, bf, deltaTime);
+    float dx = goal.x - e->position.x;
+    float dy = goal.y - e->position.y;
+    // Same arrival slack as pathfind_try_step_toward.
+    bool arrived = sqrtf(dx * dx + dy * dy) <= stopRadius + 0.01f;
+    pathfind_finish_step(e, start, deltaTime, !arrived);
+    return arrived;
+}
+
 bool pathfind_step_entity(Entity *e, NavFrame *nav, const Battlefield *bf,
                            float deltaTime) {
     // Debug assertion: entity position must be within canonical board bounds
     CanonicalPos posCheck = { e->position };
     BF_ASSERT_IN_BOUNDS(posCheck, BOARD_WIDTH, BOARD_HEIGHT);
 
+    pathfind_neighbors_invalidate();
+    Vector2 start = e->position;
+
     // Validate lane bounds -- invalid lane means entity cannot path
     if (e->lane < 0 || e->lane >= 3) {
         entity_set_state(e, ESTATE_IDLE);
@@ -1981,17 +2393,7 @@ bool pathfind_step_entity(Entity *e, NavFrame *nav, const Battlefield *bf,
                                                   goal, stopRadius, deltaTime);
     }
     if (!handledByFlow) {
-        int prevTicksSinceProgress = e->ticksSinceProgress;
-        bool moved = pathfind_try_step_toward(e, goal, stopRadius, bf, deltaTime, true, true);
-        if (nav) {
-            if (moved &&
-                pathfind_position_in_hardblocked_mask(e->position,
-                                                      nav->staticBlockers.blocked)) {
-                e->ticksSinceProgress = prevTicksSinceProgress + 1;
-            }
-            (void)pathfind_try_blocker_rescue_teleport(e, goal, bf,
-                                                       nav->staticBlockers.blocked);
-        }
+        pathfind_step_local(e, goal, stopRadius, nav, bf, deltaTime);
     }
     pathfind_sync_lane_progress(e, bf);
 
@@ -2005,10 +2407,12 @@ bool pathfind_step_entity(Entity *e, NavFrame *nav, const Battlefield *bf,
             pathfind_commit_presentation(e, bf);
             pathfind_face_goal(e, bf, enemyBase.v);
             entity_set_state(e, ESTATE_IDLE);
+            pathfind_finish_step(e, start, deltaTime, false);
             return false;
         }
     }
 
+    pathfind_finish_step(e, start, deltaTime, true);
     return true;
 }
 
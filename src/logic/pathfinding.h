@@ -65,6 +65,36 @@ bool pathfind_move_toward_goal(Entity *e, Vector2 goal, float stopRadius,
                                NavFrame *nav, const Battlefield *bf,
                                float deltaTime);
 
+// One local-steering step toward `goal` with no flow field: the candidate
+// fan (or ORCA for profiles in nav's mask) plus the static-blocker rescue,
+// as pathfind_step_entity runs when no flow stepper takes the tick. Returns
+// true once within `stopRadius` of the goal. cardgame_sim --crowd-bench
+// drives its crossing scenario through this.
+bool pathfind_step_local_toward(Entity *e, Vector2 goal, float stopRadius,
+                                NavFrame *nav, const Battlefield *bf,
+                                float deltaTime);
+
+// ORCA crowd avoidance (orca.h): set which UnitNavProfile bits
+// (1u << profile) steer by reciprocal velocity obstacles instead of the
+// candidate fan for movers stepped with `nav`. Flow-field movers of those
+// profiles also give way to their neighbors. 0 restores the fan everywhere.
+// nav_frame_init starts from PATHFIND_ORCA_PROFILES.
+void pathfind_set_orca_profiles(NavFrame *nav, uint32_t profileMask);
+
+// Movement counters since the last reset. A step is one stepping call for a
+// mover that had not arrived; a stall is a step that left it in place.
+typedef struct {
+    uint64_t steps;
+    uint64_t stalls;
+    uint64_t rescues;     // blocker rescue teleports
+    uint64_t orcaSolves;
+    uint64_t orcaSteps;   // pathfind_try_orca_step calls (fan replacement)
+    uint64_t orcaRejects; // of those, illegal candidates handed to the fan
+} PathfindSteerStats;
+
+PathfindSteerStats pathfind_steer_stats(void);
+void pathfind_reset_steer_stats(void);
+
 typedef struct {
     const NavField *field;
     Vector2 goal;
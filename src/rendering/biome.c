@@ -610,6 +610,27 @@ void biome_init_all(BiomeDef biomeDefs[BIOME_COUNT]) {
     }
 }
 
+void biome_init_all_headless(BiomeDef biomeDefs[BIOME_COUNT]) {
+    memset(biomeDefs, 0, sizeof(BiomeDef) * BIOME_COUNT);
+
+    biome_define_grass(&biomeDefs[BIOME_GRASS]);
+    biome_define_undead(&biomeDefs[BIOME_UNDEAD]);
+    biome_define_snow(&biomeDefs[BIOME_SNOW]);
+    biome_define_swamp(&biomeDefs[BIOME_SWAMP]);
+
+    // Same compiled tables biome_init_all builds, minus every texture upload,
+    // so tilemap_create_biome consumes the seeded rand() stream identically.
+    for (int i = 0; i < BIOME_COUNT; i++) {
+        BiomeDef *b = &biomeDefs[i];
+        if (!b->texturePath) continue;
+
+        biome_compile_blocks(b);
+        if (b->detailTexturePath && b->detailBlockCount > 0) {
+            biome_compile_detail_blocks(b);
+        }
+    }
+}
+
 void biome_free_all(BiomeDef biomeDefs[BIOME_COUNT]) {
     for (int i = 0; i < BIOME_COUNT; i++) {
         if (biomeDefs[i].loaded) {
@@ -110,6 +110,10 @@ void biome_compile_detail_blocks(BiomeDef *b);
 // Initialize all biome definitions, load textures, build TileDef arrays.
 void biome_init_all(BiomeDef biomeDefs[BIOME_COUNT]);
 
+// Build the same TileDef tables as biome_init_all without loading any textures.
+// Used by the headless simulation, which has no GL context.
+void biome_init_all_headless(BiomeDef biomeDefs[BIOME_COUNT]);
+
 // Unload all biome textures.
 void biome_free_all(BiomeDef biomeDefs[BIOME_COUNT]);
 
@@ -286,7 +286,7 @@ static void draw_sustenance_nodes(const Battlefield *bf) {
 // --- Deposit slot overlay (F9) ---
 
 static void draw_deposit_slot_ring(const Entity *base) {
-    if (!base || !base->depositSlots.initialized) return;
+    if (!base || !base->cold->depositSlots.initialized) return;
 
     // Draw the base nav radius shell so farmers' stop distance is visible.
     float navR = (base->navRadius > 0.0f) ? base->navRadius : base->bodyRadius;
@@ -323,7 +323,7 @@ static void draw_deposit_slots(const Battlefield *bf) {
         const Entity *e = bf->entities[i];
         if (!e || e->markedForRemoval) continue;
         if (e->type != ENTITY_BUILDING) continue;
-        if (!e->depositSlots.initialized) continue;
+        if (!e->cold->depositSlots.initialized) continue;
         draw_deposit_slot_ring(e);
     }
 }
@@ -422,7 +422,7 @@ static void draw_nav_blocker_mask(const NavFrame *nav) {
     if (!nav || !nav->initialized) return;
 
     for (int32_t i = 0; i < NAV_CELLS; ++i) {
-        if (!nav->staticBlockers.blocked[i]) continue;
+        if (!nav_bit_test(nav->staticBlockers.blocked, i)) continue;
         NavCellCoord coord = nav_cell_coord(i);
         Rectangle cell = {
             (float)coord.col * (float)NAV_CELL_SIZE,
@@ -445,8 +445,9 @@ static void draw_nav_field_flow(const NavField *field) {
     if (!field) return;
 
     for (int32_t i = 0; i < NAV_CELLS; ++i) {
-        if (field->hardBlocked[i]) continue;
+        if (nav_bit_test(field->hardBlocked, i)) continue;
         if (field->distance[i] == NAV_DIST_UNREACHABLE) continue;
+        if (!nav_field_cell_settled(field, i)) continue;
 
         float cx = 0.0f, cy = 0.0f;
         nav_cell_center(i, &cx, &cy);
@@ -71,6 +71,7 @@ static void spawn_fx_write_blood(SpawnBloodFx *blood, Vector2 position, float sc
 
     *blood = (SpawnBloodFx){
         .position = position,
+        .prevPosition = position,
         .attachedOffset = attachedOffset,
         .scale = scale,
         .elapsed = 0.0f,
@@ -221,6 +222,7 @@ void spawn_fx_sync_blood_attachments(SpawnFxSystem *fx, Battlefield *bf) {
 
     for (int i = 0; i < SPAWN_FX_CAPACITY; i++) {
         SpawnBloodFx *blood = &fx->blood[i];
+        blood->prevPosition = blood->position;
         if (!blood->active || !blood->attached) continue;
 
         Entity *entity = bf_find_entity(bf, blood->attachedEntityId);
@@ -263,7 +265,7 @@ void spawn_fx_draw(const SpawnFxSystem *fx, float rotationDegrees) {
     }
 }
 
-void spawn_fx_draw_overlay(const SpawnFxSystem *fx, float rotationDegrees) {
+void spawn_fx_draw_overlay(const SpawnFxSystem *fx, float rotationDegrees, float alpha) {
     if (!fx) return;
 
     if (fx->bloodTexture.id > 0) {
@@ -283,8 +285,8 @@ void spawn_fx_draw_overlay(const SpawnFxSystem *fx, float rotationDegrees) {
             float drawWidth = (float)SPAWN_BLOOD_FRAME_WIDTH * blood->scale;
             float drawHeight = (float)SPAWN_BLOOD_FRAME_HEIGHT * blood->scale;
             Rectangle dst = {
-                blood->position.x,
-                blood->position.y,
+                blood->prevPosition.x + (blood->position.x - blood->prevPosition.x) * alpha,
+                blood->prevPosition.y + (blood->position.y - blood->prevPosition.y) * alpha,
                 drawWidth,
                 drawHeight,
             };
@@ -28,6 +28,7 @@ typedef struct {
 
 typedef struct {
     Vector2 position;
+    Vector2 prevPosition; // position before the last attachment sync (render interpolation)
     Vector2 attachedOffset;
     float scale;
     float elapsed;
@@ -58,6 +59,8 @@ void spawn_fx_emit_blood_attached(SpawnFxSystem *fx, Vector2 position, float sca
                                   int entityId, Vector2 offset);
 void spawn_fx_sync_blood_attachments(SpawnFxSystem *fx, Battlefield *bf);
 void spawn_fx_draw(const SpawnFxSystem *fx, float rotationDegrees);
-void spawn_fx_draw_overlay(const SpawnFxSystem *fx, float rotationDegrees);
+// Smoke and explosions are stationary; only attached blood moves between sim
+// ticks, so the overlay pass takes the render interpolation alpha.
+void spawn_fx_draw_overlay(const SpawnFxSystem *fx, float rotationDegrees, float alpha);
 
 #endif //NFC_CARDGAME_SPAWN_FX_H
@@ -171,11 +171,8 @@ static Rectangle *alloc_visible_bounds(int frameCount) {
     return calloc((size_t) (frameCount * DIR_COUNT), sizeof(Rectangle));
 }
 
-static void populate_visible_bounds_from_image(SpriteSheet *sheet, const char *path) {
-    if (!sheet->visibleBounds) return;
-
-    Image image = LoadImage(path);
-    if (!image.data) return;
+static void populate_visible_bounds_from_image(SpriteSheet *sheet, Image image) {
+    if (!sheet->visibleBounds || !image.data) return;
 
     Color *pixels = LoadImageColors(image);
     if (pixels) {
@@ -193,15 +190,18 @@ static void populate_visible_bounds_from_image(SpriteSheet *sheet, const char *p
         }
         UnloadImageColors(pixels);
     }
-
-    UnloadImage(image);
 }
 
-// Helper: load one animation sheet and compute frame dimensions
+// Helper: load one animation sheet and compute frame dimensions.
+// With uploadTexture=false the sheet is decoded on the CPU and never
+// uploaded: it keeps its frame metrics and visible bounds but texture.id
+// stays 0. The decoded image is reused by the visible-bounds pass when the
+// baked atlas has no entry, so each sheet is decoded at most once.
 static SpriteSheet load_sheet_with_rows(const char *path, int frameCount, int sourceRowCount,
                                         int framesPerRow,
-                                        bool required) {
+                                        bool required, bool uploadTexture) {
     SpriteSheet s = {0};
+    Image image = {0};
     const char *sheetKind = required ? "required" : "optional";
 
     if (!path || frameCount < 1 || sourceRowCount < 1 || framesPerRow < 1 ||
@@ -212,13 +212,23 @@ static SpriteSheet load_sheet_with_rows(const char *path, int frameCount, int so
         return s;
     }
 
-    s.texture = LoadTexture(path);
-    if (s.texture.id == 0) {
-        fprintf(stderr, "[sprite] Failed to load %s sheet: %s\n", sheetKind, path);
-        return s;
-    }
+    if (uploadTexture) {
+        s.texture = LoadTexture(path);
+        if (s.texture.id == 0) {
+            fprintf(stderr, "[sprite] Failed to load %s sheet: %s\n", sheetKind, path);
+            return s;
+        }
 
-    SetTextureFilter(s.texture, TEXTURE_FILTER_POINT);
+        SetTextureFilter(s.texture, TEXTURE_FILTER_POINT);
+    } else {
+        image = LoadImage(path);
+        if (!image.data) {
+            fprintf(stderr, "[sprite] Failed to load %s sheet: %s\n", sheetKind, path);
+            return s;
+        }
+        s.texture.width = image.width;
+        s.texture.height = image.height;
+    }
 
     s.frameCount = frameCount;
     s.sourceRowCount = sourceRowCount;
@@ -232,7 +242,8 @@ static SpriteSheet load_sheet_with_rows(const char *path, int frameCount, int so
                 "(got %dx%d, frames=%d, rows=%d, cols=%d)\n",
                 sheetKind, path, s.texture.width, s.texture.height,
                 frameCount, sourceRowCount, framesPerRow);
-        UnloadTexture(s.texture);
+        if (s.texture.id > 0) UnloadTexture(s.texture);
+        if (image.data) UnloadImage(image);
         return (SpriteSheet){0};
     }
 
@@ -246,20 +257,23 @@ static SpriteSheet load_sheet_with_rows(const char *path, int frameCount, int so
     if (s.visibleBounds && entry) {
         memcpy(s.visibleBounds, entry->visibleBounds,
                (size_t) (s.frameCount * DIR_COUNT) * sizeof(Rectangle));
-    } else {
-        populate_visible_bounds_from_image(&s, path);
+    } else if (s.visibleBounds) {
+        if (!image.data) image = LoadImage(path);
+        populate_visible_bounds_from_image(&s, image);
     }
 
+    if (image.data) UnloadImage(image);
     return s;
 }
 
-static SpriteSheet load_sheet_manifest(const SpriteSheetManifestEntry *entry) {
+static SpriteSheet load_sheet_manifest(const SpriteSheetManifestEntry *entry,
+                                       bool uploadTextures) {
     if (!entry) return (SpriteSheet){0};
     return load_sheet_with_rows(entry->path, entry->frameCount, entry->sourceRowCount,
-                                entry->framesPerRow, entry->required);
+                                entry->framesPerRow, entry->required, uploadTextures);
 }
 
-void sprite_atlas_init(SpriteAtlas *atlas) {
+static void sprite_atlas_load(SpriteAtlas *atlas, bool uploadTextures) {
     if (!atlas) return;
     memset(atlas, 0, sizeof(*atlas));
 
@@ -268,7 +282,7 @@ void sprite_atlas_init(SpriteAtlas *atlas) {
         CharacterSprite *target = entry->isBaseFallback
             ? &atlas->base
             : &atlas->types[entry->spriteType];
-        target->anims[entry->anim] = load_sheet_manifest(entry);
+        target->anims[entry->anim] = load_sheet_manifest(entry, uploadTextures);
 
         if (!entry->isBaseFallback &&
             entry->spriteType >= 0 &&
@@ -278,6 +292,14 @@ void sprite_atlas_init(SpriteAtlas *atlas) {
     }
 }
 
+void sprite_atlas_init(SpriteAtlas *atlas) {
+    sprite_atlas_load(atlas, true);
+}
+
+void sprite_atlas_init_headless(SpriteAtlas *atlas) {
+    sprite_atlas_load(atlas, false);
+}
+
 void sprite_atlas_free(SpriteAtlas *atlas) {
     // Free base sprites
     CharacterSprite *b = &atlas->base;
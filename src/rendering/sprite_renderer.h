@@ -98,6 +98,10 @@ typedef struct {
 
 void sprite_atlas_init(SpriteAtlas *atlas);
 
+// Frame metrics and visible bounds only (no GPU textures). Gameplay reads
+// sheet heights for seam and FX offsets, so the headless sim still needs them.
+void sprite_atlas_init_headless(SpriteAtlas *atlas);
+
 void sprite_atlas_free(SpriteAtlas *atlas);
 
 // Returns the authored sheet for anim, or a configured fallback sheet for
@@ -6,6 +6,7 @@
 #include "sprite_renderer.h"
 #include "../core/config.h"
 #include "../systems/progression.h"
+#include "../entities/entities.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -739,7 +740,7 @@ static bool resolve_base_bar_snapshot(const Player *owner, int *outHp,
     if (base && !base->markedForRemoval) {
         *outHp = base->hp;
         *outMaxHp = base->maxHP;
-        *outBaseLevel = base->baseLevel;
+        *outBaseLevel = base->cold->baseLevel;
         return true;
     }
 
@@ -1031,11 +1032,14 @@ void status_bars_draw_screen(const GameState *gs, const Player *hudPlayer,
         const Entity *e = bf->entities[i];
         if (!e || e->markedForRemoval || e->type != ENTITY_TROOP) continue;
         if (!e->alive || e->hp <= 0) continue;
+        // Anchor the bar to the same interpolated position the sprite draws at.
+        Entity troopView = *e;
+        troopView.position = entity_render_position(e, gs->renderAlpha);
         if (hasTroopTexture) {
-            draw_troop_health_bar(gs, e, camera, rotationDegrees,
+            draw_troop_health_bar(gs, &troopView, camera, rotationDegrees,
                                   reverseFillDirection);
         } else {
-            draw_troop_health_bar_fallback(e, camera, rotationDegrees,
+            draw_troop_health_bar_fallback(&troopView, camera, rotationDegrees,
                                            reverseFillDirection);
         }
     }
@@ -60,6 +60,6 @@ void progression_sync_player(GameState *gs, int playerIndex) {
 
     Entity *base = player->base;
     if (base && base->alive && !base->markedForRemoval) {
-        base->baseLevel = level;
+        base->cold->baseLevel = level;
     }
 }
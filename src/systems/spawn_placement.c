@@ -8,8 +8,12 @@
 #include "../core/config.h"
 #include "../logic/base_geometry.h"
 
+// Farthest candidate offset from the anchor, in body radii: the widest
+// lateral multiplier (5) combined with the deepest row (3) is ~5.83.
+#define SPAWN_PLACEMENT_SEARCH_REACH_RADII 6.0f
+
 // Check if placing a circle of `bodyRadius` at `pos` would overlap any
-// living, unmarked entity in the registry. Mirrors pathfinding's blocker
+// living, unmarked entity in `blockers`. Mirrors pathfinding's blocker
 // overlap check so spawned troops land in the same non-overlapping
 // geometry that local steering enforces per tick.
 static Vector2 spawn_blocker_center(const Entity *other) {
@@ -28,10 +32,10 @@ static float spawn_blocker_radius(const Entity *other) {
     return other->bodyRadius;
 }
 
-static bool spawn_pos_overlaps(const Battlefield *bf, Vector2 pos,
-                               float bodyRadius) {
-    for (int i = 0; i < bf->entityCount; i++) {
-        const Entity *other = bf->entities[i];
+static bool spawn_pos_overlaps(Entity *const *blockers, int blockerCount,
+                               Vector2 pos, float bodyRadius) {
+    for (int i = 0; i < blockerCount; i++) {
+        const Entity *other = blockers[i];
         if (!other || !other->alive || other->markedForRemoval) continue;
         if (other->type == ENTITY_PROJECTILE) continue;
         Vector2 blockerCenter = spawn_blocker_center(other);
@@ -44,6 +48,11 @@ static bool spawn_pos_overlaps(const Battlefield *bf, Vector2 pos,
     return false;
 }
 
+static bool spawn_is_mobile_blocker(const Entity *e, const void *ctx) {
+    (void)ctx;
+    return !spatial_grid_is_anchored(e);
+}
+
 static bool spawn_pos_in_bounds(const Battlefield *bf, Vector2 pos,
                                 float bodyRadius) {
     if (pos.x - bodyRadius < 0.0f || pos.x + bodyRadius > bf->boardWidth)
@@ -72,6 +81,20 @@ bool spawn_find_free_anchor(GameState *gs, BattleSide side, int slotIndex,
     // SIDE_BOTTOM home is +y, SIDE_TOP home is -y.
     float behindSign = (side == SIDE_BOTTOM) ? 1.0f : -1.0f;
 
+    // Gather every blocker that can reach any candidate once, instead of
+    // scanning the registry per candidate. Mobile blockers come from a grid
+    // query padded by the largest mobile radius; anchored ones (bases) have
+    // offset footprints and are all checked from the statics list.
+    const SpatialGrid *grid = &bf->spatial;
+    SpatialFilter filter = {
+        .owner = SPATIAL_OWNER_ANY,
+        .air = SPATIAL_AIR_ANY,
+        .accept = spawn_is_mobile_blocker,
+    };
+    float reach = SPAWN_PLACEMENT_SEARCH_REACH_RADII * bodyRadius + bodyRadius +
+                  PATHFIND_CONTACT_GAP + grid->maxMobileRadius;
+    int mobileCount = spatial_grid_query_radius(grid, anchor, reach, &filter);
+
     for (int row = 0; row < 4; row++) {
         float yOffset = behindSign * bodyRadius * (float)row;
         for (int j = 0; j < lateralCount; j++) {
@@ -80,7 +103,10 @@ bool spawn_find_free_anchor(GameState *gs, BattleSide side, int slotIndex,
                 anchor.y + yOffset
             };
             if (!spawn_pos_in_bounds(bf, candidate, bodyRadius)) continue;
-            if (spawn_pos_overlaps(bf, candidate, bodyRadius)) continue;
+            if (spawn_pos_overlaps(grid->scratch, mobileCount, candidate, bodyRadius) ||
+                spawn_pos_overlaps(grid->statics, grid->staticCount, candidate, bodyRadius)) {
+                continue;
+            }
             *outPos = candidate;
             return true;
         }
@@ -0,0 +1,884 @@
+//
+// Headless match runner: drives game_sim_step at a fixed timestep with no
+// window, audio, or GPU textures, and reports wall-clock throughput.
+//
+// Usage: cardgame_sim [--matches N] [--seed S] [--tick-rate HZ]
+//                     [--max-seconds T] [--entity-cap N] [--nav-budget-us US]
+//                     [--nav-bounded] [--orca PROFILES] [--quiet]
+//        cardgame_sim --stress 256,512,1024 [--stress-ticks N] [...]
+//        cardgame_sim --nav-bench N [--seed S]
+//        cardgame_sim --crowd-bench N [--stress-ticks N] [--orca PROFILES]
+//
+// --stress skips scripted matches and instead spawns each listed number of
+// combat units (split evenly across both sides) in formation, then reports
+// per-tick wall time while the horde marches and fights.
+//
+// --nav-budget-us caps nav field building per tick (see NAV_FRAME_BUDGET_US);
+// results then depend on machine speed, so leave it off for replay checks.
+//
+// --nav-bounded turns on query-bounded target / free-goal builds
+// (NAV_QUERY_BOUNDED). Match results are the same as without it.
+//
+// --nav-bench builds N lane, target and free-goal fields on a warmed-up
+// board both over the whole grid and through the sector/portal hierarchy
+// (nav_hier.h), and reports build time, corridor size and path cost.
+//
+// --orca steers the listed unit profiles (comma-separated: lane, assault,
+// free, or all) with ORCA crowd avoidance instead of the candidate fan.
+//
+// --crowd-bench runs two crowd scenarios of N units, each twice from the
+// same seed: once with the candidate fan and once with ORCA (the --orca
+// profiles, default all). "march" is the --stress formation under full game
+// ticks, where most movers ride flow fields; "cross" sends both formations
+// across the seam through local steering only, so it measures ORCA as the
+// fan's replacement. Each run reports tick time, stalled steps, rescue
+// teleports, ORCA steps handed back to the fan and unit overlap. Nearly all
+// "march" rescues are formation units spawned outside their lane corridor,
+// freed once after PATHFIND_BLOCKER_RESCUE_TICKS under either steering.
+//
+
+#include "../core/game_sim.h"
+#include "../core/config.h"
+#include "../core/battlefield.h"
+#include "../entities/entities.h"
+#include "../entities/troop.h"
+#include "../logic/pathfinding.h"
+#include "../logic/nav_frame.h"
+#include "nav_hier.h"
+#include "../rendering/biome.h"
+#include "../rendering/sprite_renderer.h"
+#include "../logic/card_effects.h"
+#include "../systems/player.h"
+#include "../systems/spawn.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Scripted opponents try one card play per this many sim seconds.
+#define SIM_PLAY_INTERVAL_SECONDS 1.5f
+
+#define SIM_STRESS_MAX_RUNS 8
+// Formation spacing for stress spawns: one unit per nav cell.
+#define SIM_STRESS_SPACING  32.0f
+// Extra entity capacity over the unit count (bases plus slack).
+#define SIM_STRESS_CAPACITY_HEADROOM 16
+
+typedef struct {
+    int matches;
+    unsigned int seed;
+    float tickRate;
+    float maxSeconds;
+    int entityCapacity;
+    bool quiet;
+    int stressUnits[SIM_STRESS_MAX_RUNS];
+    int stressRunCount;
+    long stressTicks;
+    int navBenchQueries;
+    int navBudgetUs;
+    bool navQueryBounded;
+    uint32_t orcaProfiles;
+    int crowdBenchUnits;
+} SimOptions;
+
+// Mixed combat roster cycled through by stress spawns (no farmers: they
+// leave the lane fight to harvest).
+static const char *const SIM_STRESS_CARD_IDS[] = {
+    "KNIGHT_01", "BRUTE_01", "ASSASSIN_01", "HEALER_01", "BIRD_01", "FISHFING_01",
+};
+#define SIM_STRESS_CARD_COUNT ((int)(sizeof(SIM_STRESS_CARD_IDS) / sizeof(SIM_STRESS_CARD_IDS[0])))
+
+static double sim_now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sim_print_usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [--matches N] [--seed S] [--tick-rate HZ] [--max-seconds T]\n"
+            "          [--entity-cap N] [--stress N[,N...]] [--stress-ticks N] [--quiet]\n"
+            "          [--nav-bench N] [--nav-budget-us US] [--nav-bounded]\n"
+            "          [--orca lane,assault,free|all] [--crowd-bench N]\n",
+            argv0);
+}
+
+// Parse a comma-separated profile list for --orca into a UnitNavProfile mask.
+static bool sim_parse_orca_profiles(const char *value, uint32_t *outMask) {
+    static const struct {
+        const char *name;
+        uint32_t mask;
+    } names[] = {
+        { "lane",    1u << NAV_PROFILE_LANE },
+        { "assault", 1u << NAV_PROFILE_ASSAULT },
+        { "free",    1u << NAV_PROFILE_FREE_GOAL },
+        { "all",     (1u << NAV_PROFILE_LANE) | (1u << NAV_PROFILE_ASSAULT) |
+                     (1u << NAV_PROFILE_FREE_GOAL) },
+    };
+
+    uint32_t mask = 0;
+    const char *cursor = value;
+    while (*cursor) {
+        const char *end = strchr(cursor, ',');
+        size_t len = end ? (size_t)(end - cursor) : strlen(cursor);
+        bool known = false;
+        for (size_t n = 0; n < sizeof(names) / sizeof(names[0]); n++) {
+            if (strlen(names[n].name) == len && strncmp(cursor, names[n].name, len) == 0) {
+                mask |= names[n].mask;
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+        cursor = end ? end + 1 : cursor + len;
+    }
+    *outMask = mask;
+    return mask != 0;
+}
+
+static bool sim_parse_options(int argc, char **argv, SimOptions *opts) {
+    *opts = (SimOptions){
+        .matches = 10,
+        .seed = 1,
+        .tickRate = SIM_TICK_RATE_HZ,
+        .maxSeconds = 600.0f,
+        .entityCapacity = ENTITY_CAPACITY_DEFAULT,
+        .quiet = false,
+        .stressRunCount = 0,
+        .stressTicks = 600,
+        .navBenchQueries = 0,
+        .navBudgetUs = 0,
+        .navQueryBounded = false,
+        .orcaProfiles = 0,
+        .crowdBenchUnits = 0,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--quiet") == 0) {
+            opts->quiet = true;
+        } else if (strcmp(arg, "--nav-bounded") == 0) {
+            opts->navQueryBounded = true;
+        } else if (strcmp(arg, "--matches") == 0 && value) {
+            opts->matches = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--seed") == 0 && value) {
+            opts->seed = (unsigned int)strtoul(value, NULL, 10);
+            i++;
+        } else if (strcmp(arg, "--tick-rate") == 0 && value) {
+            opts->tickRate = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--max-seconds") == 0 && value) {
+            opts->maxSeconds = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--entity-cap") == 0 && value) {
+            opts->entityCapacity = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--stress") == 0 && value) {
+            const char *cursor = value;
+            while (*cursor && opts->stressRunCount < SIM_STRESS_MAX_RUNS) {
+                char *end = NULL;
+                long units = strtol(cursor, &end, 10);
+                if (end == cursor || units <= 0) return false;
+                opts->stressUnits[opts->stressRunCount++] = (int)units;
+                cursor = (*end == ',') ? end + 1 : end;
+            }
+            i++;
+        } else if (strcmp(arg, "--stress-ticks") == 0 && value) {
+            opts->stressTicks = atol(value);
+            i++;
+        } else if (strcmp(arg, "--nav-budget-us") == 0 && value) {
+            opts->navBudgetUs = atoi(value);
+            if (opts->navBudgetUs <= 0) return false;
+            i++;
+        } else if (strcmp(arg, "--orca") == 0 && value) {
+            if (!sim_parse_orca_profiles(value, &opts->orcaProfiles)) return false;
+            i++;
+        } else if (strcmp(arg, "--crowd-bench") == 0 && value) {
+            opts->crowdBenchUnits = atoi(value);
+            if (opts->crowdBenchUnits <= 0) return false;
+            i++;
+        } else if (strcmp(arg, "--nav-bench") == 0 && value) {
+            opts->navBenchQueries = atoi(value);
+            if (opts->navBenchQueries <= 0) return false;
+            i++;
+        } else {
+            return false;
+        }
+    }
+
+    return opts->matches > 0 && opts->tickRate > 0.0f && opts->maxSeconds > 0.0f &&
+           opts->stressTicks > 0;
+}
+
+// Pick a random hand card and slot for one player and play it through the
+// production card path. Pre-checks mirror spawn_troop_from_card so the sim
+// does not spam "not enough energy" logs on every attempt.
+static void sim_try_play_card(GameState *g, int playerIndex) {
+    Player *player = &g->players[playerIndex];
+    int handCount = player_hand_occupied_count(player);
+    if (handCount <= 0) return;
+
+    const Card *card = player->handCards[rand() % handCount];
+    int slotIndex = rand() % NUM_CARD_SLOTS;
+    if (!card || !player_slot_is_available(player, slotIndex)) return;
+    if (!player_can_afford_cost(player, card->cost, card->costResource)) return;
+
+    card_action_play(card, g, playerIndex, slotIndex);
+}
+
+// Run one match to completion (or the time limit). Returns ticks simulated.
+static long sim_run_match(GameState *g, unsigned int seed, const SimOptions *opts) {
+    // Same seed derivation as game_init, but from a fixed seed so a match
+    // is reproducible from its index.
+    srand(seed);
+    uint32_t sustenanceSeed = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    if (sustenanceSeed == 0) sustenanceSeed = 1;
+
+    game_sim_set_tick_rate(g, opts->tickRate);
+    game_sim_set_entity_capacity(g, opts->entityCapacity);
+    game_sim_init_world(g, sustenanceSeed);
+    // bf_init reseeds the global rand(); reseed so the scripted card plays
+    // still vary per match.
+    srand(seed ^ 0x9E3779B9u);
+
+    const float dt = g->simTickSeconds;
+    const float tickRate = 1.0f / dt;
+    const long maxTicks = lroundf(opts->maxSeconds * tickRate);
+    const long playIntervalTicks = lroundf(SIM_PLAY_INTERVAL_SECONDS * tickRate) + 1;
+
+    long tick = 0;
+    while (!g->gameOver && tick < maxTicks) {
+        if (tick % playIntervalTicks == 0) {
+            sim_try_play_card(g, 0);
+            sim_try_play_card(g, 1);
+        }
+        game_sim_step(g, dt);
+        tick++;
+    }
+
+    game_sim_cleanup_world(g);
+    return tick;
+}
+
+static int sim_nearest_lane(const Battlefield *bf, BattleSide side, float x) {
+    int best = 0;
+    float bestDx = INFINITY;
+    for (int lane = 0; lane < 3; lane++) {
+        float dx = fabsf(bf->laneWaypoints[side][lane][0].v.x - x);
+        if (dx < bestDx) {
+            bestDx = dx;
+            best = lane;
+        }
+    }
+    return best;
+}
+
+// Spawn `count` combat units for one player in a grid that fills the home
+// half from the seam backwards, skipping the home base footprint. Returns
+// the number actually spawned.
+static int sim_stress_spawn_side(GameState *g, int playerIndex, int count) {
+    Battlefield *bf = &g->battlefield;
+    Player *player = &g->players[playerIndex];
+    BattleSide side = bf_side_for_player(playerIndex);
+    float towardHome = (side == SIDE_BOTTOM) ? 1.0f : -1.0f;
+
+    Vector2 baseCenter = bf_base_anchor(bf, side).v;
+    float baseClearance = 96.0f;
+    if (player->base) {
+        float r = (player->base->navRadius > 0.0f) ? player->base->navRadius
+                                                   : player->base->bodyRadius;
+        baseClearance = r + 2.0f * SIM_STRESS_SPACING;
+    }
+
+    const float margin = 2.0f * SIM_STRESS_SPACING;
+    int spawned = 0;
+    for (int row = 0; spawned < count; row++) {
+        float y = bf->seamY + towardHome * (margin + (float)row * SIM_STRESS_SPACING);
+        if (y < margin || y > bf->boardHeight - margin) break;
+
+        for (float x = margin; x <= bf->boardWidth - margin && spawned < count;
+             x += SIM_STRESS_SPACING) {
+            float bx = x - baseCenter.x;
+            float by = y - baseCenter.y;
+            if (bx * bx + by * by < baseClearance * baseClearance) continue;
+
+            const char *cardId = SIM_STRESS_CARD_IDS[spawned % SIM_STRESS_CARD_COUNT];
+            const Card *card = cards_find(&g->deck, cardId);
+            if (!card) continue;
+
+            TroopData data = troop_create_data_from_card(card);
+            Entity *e = troop_spawn(player, &data, (Vector2){ x, y }, &g->spriteAtlas);
+            if (!e) {
+                free((char *)data.targetType);
+                return spawned;
+            }
+            e->lane = sim_nearest_lane(bf, side, x);
+            e->waypointIndex = 1;
+            e->laneProgress = 0.0f;
+            pathfind_sync_lane_progress(e, bf);
+            spawn_register_entity(g, e, SPAWN_FX_NONE);
+            spawned++;
+        }
+    }
+    return spawned;
+}
+
+static int sim_compare_doubles(const void *a, const void *b) {
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+// Spawn `units` combat troops and time `opts->stressTicks` sim ticks (or
+// until a base falls). Reports mean / p95 / max milliseconds per tick.
+static void sim_run_stress(GameState *g, int units, const SimOptions *opts) {
+    srand(opts->seed);
+    uint32_t sustenanceSeed = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    if (sustenanceSeed == 0) sustenanceSeed = 1;
+
+    game_sim_set_tick_rate(g, opts->tickRate);
+    game_sim_set_entity_capacity(g, units + SIM_STRESS_CAPACITY_HEADROOM);
+    game_sim_init_world(g, sustenanceSeed);
+
+    int spawned = sim_stress_spawn_side(g, 0, units / 2);
+    spawned += sim_stress_spawn_side(g, 1, units - units / 2);
+
+    double *tickMs = malloc((size_t)opts->stressTicks * sizeof(double));
+    if (!tickMs) {
+        fprintf(stderr, "[SIM] Out of memory for stress timings\n");
+        game_sim_cleanup_world(g);
+        return;
+    }
+
+    const float dt = g->simTickSeconds;
+    long ticks = 0;
+    double totalMs = 0.0;
+    while (!g->gameOver && ticks < opts->stressTicks) {
+        double start = sim_now_seconds();
+        game_sim_step(g, dt);
+        tickMs[ticks] = (sim_now_seconds() - start) * 1000.0;
+        totalMs += tickMs[ticks];
+        ticks++;
+    }
+    int liveAtEnd = g->battlefield.entityCount;
+    NavFieldStats fieldStats = nav_field_stats(&g->nav);
+
+    double meanMs = 0.0, p95Ms = 0.0, maxMs = 0.0;
+    if (ticks > 0) {
+        qsort(tickMs, (size_t)ticks, sizeof(double), sim_compare_doubles);
+        meanMs = totalMs / (double)ticks;
+        p95Ms = tickMs[(long)((double)(ticks - 1) * 0.95)];
+        maxMs = tickMs[ticks - 1];
+    }
+    free(tickMs);
+
+    fprintf(stderr,
+            "[SIM] stress units=%d spawned=%d cap=%d ticks=%ld%s: mean=%.3fms p95=%.3fms "
+            "max=%.3fms (budget %.3fms) live=%d fields hit=%llu repair=%llu rebuild=%llu\n",
+            units, spawned, g->entityCapacity, ticks, g->gameOver ? " (base fell)" : "",
+            meanMs, p95Ms, maxMs, (double)dt * 1000.0, liveAtEnd,
+            (unsigned long long)fieldStats.hits,
+            (unsigned long long)fieldStats.repairs,
+            (unsigned long long)fieldStats.rebuilds);
+    if (opts->navBudgetUs > 0) {
+        fprintf(stderr,
+                "[SIM] nav budget %dus: deferred=%llu stale=%llu age mean=%.2f max=%u frames\n",
+                opts->navBudgetUs, (unsigned long long)fieldStats.deferred,
+                (unsigned long long)fieldStats.staleServed,
+                fieldStats.staleServed > 0
+                    ? (double)fieldStats.staleAgeTotal / (double)fieldStats.staleServed
+                    : 0.0,
+                fieldStats.staleAgeMax);
+    }
+    if (opts->navQueryBounded) {
+        fprintf(stderr, "[SIM] nav bounded: bounded=%llu extensions=%llu\n",
+                (unsigned long long)fieldStats.boundedBuilds,
+                (unsigned long long)fieldStats.extensions);
+    }
+
+    game_sim_cleanup_world(g);
+}
+
+// ---------- Crowd avoidance benchmark ----------
+
+typedef struct {
+    long ticks;
+    double meanMs;
+    double p95Ms;
+    PathfindSteerStats steer;
+    double overlapTotal;     // summed penetration depth over all overlapping pairs
+    long overlapPairs;       // overlapping pair-ticks
+    float overlapMax;
+    int liveAtEnd;
+    int arrived;             // crossing scenario: movers within stop radius at the end
+} SimCrowdResult;
+
+typedef enum {
+    SIM_CROWD_MARCH,  // the --stress formation under game_sim_step
+    SIM_CROWD_CROSS   // both formations swap across the seam by local steering
+} SimCrowdScenario;
+
+// Crossing movers count as arrived within this of their mirrored start.
+#define SIM_CROWD_CROSS_STOP_RADIUS (SIM_STRESS_SPACING * 0.5f)
+
+static bool sim_crowd_is_mover(const Entity *e) {
+    return e->alive && !e->markedForRemoval && e->type == ENTITY_TROOP &&
+           e->navProfile != NAV_PROFILE_STATIC;
+}
+
+static float sim_crowd_nav_radius(const Entity *e) {
+    return (e->navRadius > 0.0f) ? e->navRadius : e->bodyRadius;
+}
+
+// Add how deeply live movers overlap each other's nav footprint this tick.
+static void sim_crowd_tally_overlap(const Battlefield *bf, SimCrowdResult *result) {
+    for (int i = 0; i < bf->entityCount; i++) {
+        const Entity *a = bf->entities[i];
+        if (!sim_crowd_is_mover(a)) continue;
+        float ra = sim_crowd_nav_radius(a);
+        for (int j = i + 1; j < bf->entityCount; j++) {
+            const Entity *b = bf->entities[j];
+            if (!sim_crowd_is_mover(b)) continue;
+            float shell = ra + sim_crowd_nav_radius(b);
+            float dx = b->position.x - a->position.x;
+            float dy = b->position.y - a->position.y;
+            float distSq = dx * dx + dy * dy;
+            if (distSq >= shell * shell) continue;
+            float depth = shell - sqrtf(distSq);
+            result->overlapTotal += depth;
+            result->overlapPairs++;
+            if (depth > result->overlapMax) result->overlapMax = depth;
+        }
+    }
+}
+
+// Step every crossing mover once toward its goal by local steering alone,
+// in registry order like game_sim_step, and count the arrivals.
+static int sim_crowd_cross_tick(GameState *g, Entity **movers, const Vector2 *goals,
+                                int count, float dt) {
+    Battlefield *bf = &g->battlefield;
+    bf_spatial_rebuild(bf);
+    int arrived = 0;
+    for (int i = 0; i < count; i++) {
+        if (pathfind_step_local_toward(movers[i], goals[i], SIM_CROWD_CROSS_STOP_RADIUS,
+                                       &g->nav, bf, dt)) {
+            arrived++;
+        }
+        bf_spatial_update(bf, movers[i]);
+    }
+    return arrived;
+}
+
+// One crowd run with `orcaProfiles` steered by ORCA (0 = candidate fan).
+//
+// SIM_CROWD_MARCH runs full game ticks, so most movers ride the flow
+// steppers (ORCA then only filters the flow direction). SIM_CROWD_CROSS
+// stamps the bases with one empty tick, turns every unit into a FREE_GOAL
+// mover headed for its start mirrored across the seam, and steps only
+// those movers through pathfind_step_local_toward -- the candidate fan or
+// its per-profile ORCA replacement, with no flow field and no combat.
+static void sim_run_crowd_mode(GameState *g, int units, uint32_t orcaProfiles,
+                               SimCrowdScenario scenario, const SimOptions *opts,
+                               SimCrowdResult *result) {
+    *result = (SimCrowdResult){ 0 };
+    srand(opts->seed);
+    uint32_t sustenanceSeed = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    if (sustenanceSeed == 0) sustenanceSeed = 1;
+
+    game_sim_set_tick_rate(g, opts->tickRate);
+    game_sim_set_entity_capacity(g, units + SIM_STRESS_CAPACITY_HEADROOM);
+    game_sim_init_world(g, sustenanceSeed);
+    // This match only; g's own setting applies again at the next init.
+    pathfind_set_orca_profiles(&g->nav, orcaProfiles);
+    const float dt = g->simTickSeconds;
+    if (scenario == SIM_CROWD_CROSS) game_sim_step(g, dt);
+    sim_stress_spawn_side(g, 0, units / 2);
+    sim_stress_spawn_side(g, 1, units - units / 2);
+    pathfind_reset_steer_stats();
+
+    Battlefield *bf = &g->battlefield;
+    double *tickMs = malloc((size_t)opts->stressTicks * sizeof(double));
+    Entity **movers = NULL;
+    Vector2 *goals = NULL;
+    int moverCount = 0;
+    if (scenario == SIM_CROWD_CROSS) {
+        movers = malloc((size_t)bf->entityCount * sizeof(Entity *));
+        goals = malloc((size_t)bf->entityCount * sizeof(Vector2));
+    }
+    if (!tickMs || (scenario == SIM_CROWD_CROSS && (!movers || !goals))) {
+        fprintf(stderr, "[SIM] Out of memory for crowd timings\n");
+        free(tickMs);
+        free(movers);
+        free(goals);
+        game_sim_cleanup_world(g);
+        return;
+    }
+    if (scenario == SIM_CROWD_CROSS) {
+        for (int i = 0; i < bf->entityCount; i++) {
+            Entity *e = bf->entities[i];
+            if (!sim_crowd_is_mover(e)) continue;
+            e->navProfile = NAV_PROFILE_FREE_GOAL;
+            movers[moverCount] = e;
+            goals[moverCount] = (Vector2){ e->position.x, 2.0f * bf->seamY - e->position.y };
+            moverCount++;
+        }
+    }
+
+    double totalMs = 0.0;
+    while (!g->gameOver && result->ticks < opts->stressTicks) {
+        double start = sim_now_seconds();
+        if (scenario == SIM_CROWD_CROSS) {
+            result->arrived = sim_crowd_cross_tick(g, movers, goals, moverCount, dt);
+        } else {
+            game_sim_step(g, dt);
+        }
+        tickMs[result->ticks] = (sim_now_seconds() - start) * 1000.0;
+        totalMs += tickMs[result->ticks];
+        result->ticks++;
+        sim_crowd_tally_overlap(bf, result);
+    }
+    result->steer = pathfind_steer_stats();
+    result->liveAtEnd = bf->entityCount;
+
+    if (result->ticks > 0) {
+        qsort(tickMs, (size_t)result->ticks, sizeof(double), sim_compare_doubles);
+        result->meanMs = totalMs / (double)result->ticks;
+        result->p95Ms = tickMs[(long)((double)(result->ticks - 1) * 0.95)];
+    }
+    free(tickMs);
+    free(movers);
+    free(goals);
+    game_sim_cleanup_world(g);
+}
+
+// Run both crowd scenarios with the candidate fan and with ORCA and compare.
+static void sim_run_crowd_bench(GameState *g, const SimOptions *opts) {
+    uint32_t orcaProfiles = opts->orcaProfiles;
+    if (orcaProfiles == 0) {
+        orcaProfiles = (1u << NAV_PROFILE_LANE) | (1u << NAV_PROFILE_ASSAULT) |
+                       (1u << NAV_PROFILE_FREE_GOAL);
+    }
+
+    static const char *const scenarioNames[2] = { "march", "cross" };
+    static const char *const modeNames[2] = { "fan", "orca" };
+    const uint32_t modeMasks[2] = { 0u, orcaProfiles };
+    for (int scenario = 0; scenario < 2; scenario++) {
+        for (int mode = 0; mode < 2; mode++) {
+            SimCrowdResult r;
+            sim_run_crowd_mode(g, opts->crowdBenchUnits, modeMasks[mode],
+                               (SimCrowdScenario)scenario, opts, &r);
+            fprintf(stderr,
+                    "[SIM] crowd %-5s %-4s units=%d ticks=%ld: mean=%.3fms p95=%.3fms "
+                    "steps=%llu stalls=%llu (%.1f%%) rescues=%llu solves=%llu "
+                    "orca steps=%llu rejected=%llu overlap pairs/tick=%.1f "
+                    "depth mean=%.2fpx max=%.2fpx ",
+                    scenarioNames[scenario], modeNames[mode], opts->crowdBenchUnits,
+                    r.ticks, r.meanMs, r.p95Ms,
+                    (unsigned long long)r.steer.steps, (unsigned long long)r.steer.stalls,
+                    r.steer.steps > 0 ? 100.0 * (double)r.steer.stalls / (double)r.steer.steps
+                                      : 0.0,
+                    (unsigned long long)r.steer.rescues, (unsigned long long)r.steer.orcaSolves,
+                    (unsigned long long)r.steer.orcaSteps,
+                    (unsigned long long)r.steer.orcaRejects,
+                    r.ticks > 0 ? (double)r.overlapPairs / (double)r.ticks : 0.0,
+                    r.overlapPairs > 0 ? r.overlapTotal / (double)r.overlapPairs : 0.0,
+                    (double)r.overlapMax);
+            if (scenario == SIM_CROWD_CROSS) {
+                fprintf(stderr, "arrived=%d\n", r.arrived);
+            } else {
+                fprintf(stderr, "live=%d\n", r.liveAtEnd);
+            }
+        }
+    }
+}
+
+// ---------- Nav hierarchy benchmark ----------
+
+// Random start cells per benchmark query.
+#define SIM_NAV_BENCH_STARTS 4
+// Warm-up ticks so the nav frame has live density and blockers.
+#define SIM_NAV_BENCH_WARMUP_TICKS 60
+
+typedef struct {
+    const char *name;
+    int queries;
+    int fallbacks;
+    double flatMs;
+    double hierMs;
+    double flatCost;
+    double hierCost;
+    double corridorCells;
+} SimNavBenchTally;
+
+// Seed one benchmark goal of kind `kind` (0 lane, 1 target, 2 free goal)
+// into `field`. Lane goals also report which lane hierarchy to use.
+static bool sim_nav_bench_seed(GameState *g, int kind, int q, NavField *field, int *outLane) {
+    Battlefield *bf = &g->battlefield;
+    int side = q % 2;
+    *outLane = -1;
+
+    if (kind == 0) {
+        int lane = (q / 2) % 3;
+        *outLane = side * 3 + lane;
+        return nav_seed_lane_field(&g->nav, bf, side, lane, field);
+    }
+
+    if (kind == 1) {
+        int playerIndex = q % 2;
+        const Entity *enemyBase = g->players[1 - playerIndex].base;
+        if (!enemyBase) return false;
+        bool ranged = ((q / 2) % 2) != 0;
+        NavTargetGoal goal = {
+            .kind = ranged ? NAV_GOAL_KIND_DIRECT_RANGE : NAV_GOAL_KIND_MELEE_RING,
+            .targetX = enemyBase->position.x,
+            .targetY = enemyBase->position.y,
+            .outerRadius = enemyBase->bodyRadius + (ranged ? 160.0f : 24.0f),
+            .targetBodyRadius = enemyBase->bodyRadius,
+            .targetId = enemyBase->id,
+            .perspectiveSide = (int16_t)bf_side_for_player(playerIndex),
+        };
+        return nav_seed_target_field(&g->nav, &goal, field);
+    }
+
+    NavFreeGoalRequest request = {
+        .goalX = (float)(rand() % (int)bf->boardWidth),
+        .goalY = (float)(rand() % (int)bf->boardHeight),
+        .stopRadius = 40.0f,
+        .perspectiveSide = (int16_t)side,
+        .carveTargetId = -1,
+    };
+    return nav_seed_free_goal_field(&g->nav, &request, field);
+}
+
+// Compare full-board integration against sector-corridor integration for
+// `opts->navBenchQueries` goals of each kind on a warmed-up board.
+static void sim_run_nav_bench(GameState *g, const SimOptions *opts) {
+    srand(opts->seed);
+    uint32_t sustenanceSeed = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    if (sustenanceSeed == 0) sustenanceSeed = 1;
+
+    const int units = 256;
+    game_sim_set_tick_rate(g, opts->tickRate);
+    game_sim_set_entity_capacity(g, units + SIM_STRESS_CAPACITY_HEADROOM);
+    game_sim_init_world(g, sustenanceSeed);
+    sim_stress_spawn_side(g, 0, units / 2);
+    sim_stress_spawn_side(g, 1, units - units / 2);
+    for (int t = 0; t < SIM_NAV_BENCH_WARMUP_TICKS && !g->gameOver; t++) {
+        game_sim_step(g, g->simTickSeconds);
+    }
+
+    // Lane fields carry their own corridor mask, so each lane gets its own
+    // portal graph; targets and free goals share the static blocker graph.
+    NavHier *hiers = calloc(7, sizeof(NavHier));
+    NavField *seeded = malloc(sizeof(NavField));
+    NavField *flat = malloc(sizeof(NavField));
+    NavField *corridor = malloc(sizeof(NavField));
+    if (!hiers || !seeded || !flat || !corridor) {
+        fprintf(stderr, "[SIM] Out of memory for nav benchmark\n");
+        goto cleanup;
+    }
+    for (int h = 0; h < 7; h++) nav_hier_init(&hiers[h]);
+
+    double graphStart = sim_now_seconds();
+    bool graphsReady = nav_hier_update(&hiers[6], g->nav.staticBlockers.blocked);
+    for (int h = 0; h < 6 && graphsReady; h++) {
+        int unused;
+        sim_nav_bench_seed(g, 0, (h % 3) * 2 + h / 3, seeded, &unused);
+        graphsReady = nav_hier_update(&hiers[h], seeded->hardBlocked);
+    }
+    double graphMs = (sim_now_seconds() - graphStart) * 1000.0;
+    if (!graphsReady) {
+        fprintf(stderr, "[SIM] Out of memory building portal graphs\n");
+        goto cleanup;
+    }
+
+    fprintf(stderr,
+            "[SIM] nav-bench grid=%dx%d cell=%dpx sectors=%dx%d of %d cells portals=%d "
+            "edges=%d graphs=7 in %.3fms\n",
+            NAV_COLS, NAV_ROWS, NAV_CELL_SIZE, NAV_SECTOR_COLS, NAV_SECTOR_ROWS,
+            NAV_SECTOR_CELLS, hiers[6].portalCount, hiers[6].edgeCount, graphMs);
+
+    SimNavBenchTally tallies[3] = {
+        { .name = "lane" }, { .name = "target" }, { .name = "free-goal" },
+    };
+    for (int kind = 0; kind < 3; kind++) {
+        SimNavBenchTally *tally = &tallies[kind];
+        for (int q = 0; q < opts->navBenchQueries; q++) {
+            int laneHier;
+            if (!sim_nav_bench_seed(g, kind, q, seeded, &laneHier)) continue;
+            NavHier *hier = &hiers[laneHier >= 0 ? laneHier : 6];
+
+            memcpy(flat, seeded, sizeof(NavField));
+            double start = sim_now_seconds();
+            nav_integrate_detached_field(&g->nav, flat);
+            double flatMs = (sim_now_seconds() - start) * 1000.0;
+
+            int32_t starts[SIM_NAV_BENCH_STARTS];
+            int startCount = 0;
+            for (int attempt = 0; attempt < 256 && startCount < SIM_NAV_BENCH_STARTS; attempt++) {
+                int32_t cell = rand() % NAV_CELLS;
+                if (flat->distance[cell] != NAV_DIST_UNREACHABLE && flat->distance[cell] > 0) {
+                    starts[startCount++] = cell;
+                }
+            }
+            if (startCount == 0) continue;
+
+            memcpy(corridor, seeded, sizeof(NavField));
+            uint64_t fallbacksBefore = hier->stats.fallbacks;
+            uint64_t cellsBefore = hier->stats.corridorCells;
+            start = sim_now_seconds();
+            nav_hier_build_field(hier, &g->nav, corridor, starts, startCount);
+            double hierMs = (sim_now_seconds() - start) * 1000.0;
+
+            tally->queries++;
+            tally->flatMs += flatMs;
+            tally->hierMs += hierMs;
+            tally->fallbacks += (int)(hier->stats.fallbacks - fallbacksBefore);
+            tally->corridorCells += (double)(hier->stats.corridorCells - cellsBefore);
+            for (int s = 0; s < startCount; s++) {
+                tally->flatCost += flat->distance[starts[s]];
+                tally->hierCost += corridor->distance[starts[s]];
+            }
+        }
+
+        if (tally->queries == 0) continue;
+        int corridorQueries = tally->queries - tally->fallbacks;
+        fprintf(stderr,
+                "[SIM] nav-bench %-9s queries=%d flat=%.1fus hier=%.1fus (x%.2f) "
+                "corridor=%.0f%% of cells cost=+%.2f%% fallbacks=%d\n",
+                tally->name, tally->queries,
+                tally->flatMs * 1000.0 / tally->queries,
+                tally->hierMs * 1000.0 / tally->queries,
+                tally->hierMs > 0.0 ? tally->flatMs / tally->hierMs : 0.0,
+                corridorQueries > 0
+                    ? 100.0 * tally->corridorCells / ((double)corridorQueries * NAV_CELLS)
+                    : 100.0,
+                tally->flatCost > 0.0
+                    ? 100.0 * (tally->hierCost - tally->flatCost) / tally->flatCost
+                    : 0.0,
+                tally->fallbacks);
+    }
+
+cleanup:
+    if (hiers) {
+        for (int h = 0; h < 7; h++) nav_hier_destroy(&hiers[h]);
+    }
+    free(hiers);
+    free(seeded);
+    free(flat);
+    free(corridor);
+    game_sim_cleanup_world(g);
+}
+
+int main(int argc, char **argv) {
+    SimOptions opts;
+    if (!sim_parse_options(argc, argv, &opts)) {
+        sim_print_usage(argv[0]);
+        return 2;
+    }
+
+    // Gameplay code logs to stdout; --quiet drops it so only the [SIM]
+    // report on stderr remains.
+    if (opts.quiet && !freopen("/dev/null", "w", stdout)) {
+        fprintf(stderr, "[SIM] Warning: could not silence stdout\n");
+    }
+
+    // GameState embeds the NavFrame lane fields and heap -- keep it off the stack.
+    GameState *g = calloc(1, sizeof(GameState));
+    if (!g) {
+        fprintf(stderr, "[SIM] Out of memory allocating GameState\n");
+        return 1;
+    }
+
+    if (!game_sim_load_data(g)) {
+        free(g);
+        return 1;
+    }
+    biome_init_all_headless(g->biomeDefs);
+    sprite_atlas_init_headless(&g->spriteAtlas);
+    if (opts.navBudgetUs > 0) game_sim_set_nav_budget_us(g, opts.navBudgetUs);
+    if (opts.navQueryBounded) game_sim_set_nav_query_bounded(g, true);
+    if (opts.orcaProfiles) game_sim_set_orca_profiles(g, opts.orcaProfiles);
+
+    if (opts.crowdBenchUnits > 0) {
+        sim_run_crowd_bench(g, &opts);
+        sprite_atlas_free(&g->spriteAtlas);
+        game_sim_unload_data(g);
+        free(g);
+        return 0;
+    }
+
+    if (opts.navBenchQueries > 0) {
+        sim_run_nav_bench(g, &opts);
+        sprite_atlas_free(&g->spriteAtlas);
+        game_sim_unload_data(g);
+        free(g);
+        return 0;
+    }
+
+    if (opts.stressRunCount > 0) {
+        for (int r = 0; r < opts.stressRunCount; r++) {
+            sim_run_stress(g, opts.stressUnits[r], &opts);
+        }
+        sprite_atlas_free(&g->spriteAtlas);
+        game_sim_unload_data(g);
+        free(g);
+        return 0;
+    }
+
+    int wins[2] = { 0, 0 };
+    int draws = 0;
+    int timeouts = 0;
+    long totalTicks = 0;
+    double simStart = sim_now_seconds();
+    pathfind_reset_steer_stats();
+
+    for (int m = 0; m < opts.matches; m++) {
+        double matchStart = sim_now_seconds();
+        long ticks = sim_run_match(g, opts.seed + (unsigned int)m, &opts);
+        double matchWall = sim_now_seconds() - matchStart;
+        totalTicks += ticks;
+
+        const char *result = "timeout";
+        if (!g->gameOver) {
+            timeouts++;
+        } else if (g->winnerID < 0) {
+            draws++;
+            result = "draw";
+        } else {
+            wins[g->winnerID == 0 ? 0 : 1]++;
+            result = (g->winnerID == 0) ? "p1" : "p2";
+        }
+
+        fprintf(stderr, "[SIM] match %d seed=%u result=%s ticks=%ld sim=%.1fs wall=%.3fs (%.0f ticks/s)\n",
+                m, opts.seed + (unsigned int)m, result, ticks,
+                (double)ticks * (double)g->simTickSeconds, matchWall,
+                matchWall > 0.0 ? (double)ticks / matchWall : 0.0);
+    }
+
+    double wall = sim_now_seconds() - simStart;
+    fprintf(stderr,
+            "[SIM] %d matches, %ld ticks @ %.0f Hz in %.3fs: %.0f ticks/s, %.1f matches/min "
+            "(p1 %d, p2 %d, draw %d, timeout %d)\n",
+            opts.matches, totalTicks, 1.0 / (double)g->simTickSeconds, wall,
+            wall > 0.0 ? (double)totalTicks / wall : 0.0,
+            wall > 0.0 ? (double)opts.matches * 60.0 / wall : 0.0,
+            wins[0], wins[1], draws, timeouts);
+    if (opts.orcaProfiles) {
+        PathfindSteerStats steer = pathfind_steer_stats();
+        fprintf(stderr,
+                "[SIM] steer: steps=%llu stalls=%llu rescues=%llu orca solves=%llu "
+                "fan-replacement steps=%llu rejected=%llu\n",
+                (unsigned long long)steer.steps, (unsigned long long)steer.stalls,
+                (unsigned long long)steer.rescues, (unsigned long long)steer.orcaSolves,
+                (unsigned long long)steer.orcaSteps, (unsigned long long)steer.orcaRejects);
+    }
+
+    sprite_atlas_free(&g->spriteAtlas);
+    game_sim_unload_data(g);
+    free(g);
+    return 0;
+}
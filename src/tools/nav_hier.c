@@ -0,0 +1,536 @@
+//
+// Hierarchical sector / portal navigation. See nav_hier.h.
+//
+
+#include "nav_hier.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NAV_SECTOR_AREA (NAV_SECTOR_CELLS * NAV_SECTOR_CELLS)
+#define NAV_HIER_INF    INT32_MAX
+
+// ---------- Geometry ----------
+
+typedef struct {
+    int32_t col0, row0;   // inclusive
+    int32_t col1, row1;   // exclusive, clipped to the board
+} NavSectorBounds;
+
+int32_t nav_hier_sector_of_cell(int32_t cellIndex) {
+    NavCellCoord c = nav_cell_coord(cellIndex);
+    return (c.row / NAV_SECTOR_CELLS) * NAV_SECTOR_COLS + c.col / NAV_SECTOR_CELLS;
+}
+
+static NavSectorBounds nav_sector_bounds(int32_t sector) {
+    NavSectorBounds b;
+    b.col0 = (sector % NAV_SECTOR_COLS) * NAV_SECTOR_CELLS;
+    b.row0 = (sector / NAV_SECTOR_COLS) * NAV_SECTOR_CELLS;
+    b.col1 = b.col0 + NAV_SECTOR_CELLS;
+    b.row1 = b.row0 + NAV_SECTOR_CELLS;
+    if (b.col1 > NAV_COLS) b.col1 = NAV_COLS;
+    if (b.row1 > NAV_ROWS) b.row1 = NAV_ROWS;
+    return b;
+}
+
+static inline int32_t nav_sector_local(const NavSectorBounds *b, int32_t col, int32_t row) {
+    return (row - b->row0) * NAV_SECTOR_CELLS + (col - b->col0);
+}
+
+// ---------- Min-heap of packed (dist << 32 | id) keys ----------
+
+static void nav_hier_heap_push(int64_t *heap, int32_t *size, int32_t dist, int32_t id) {
+    int64_t key = ((int64_t)dist << 32) | (uint32_t)id;
+    int32_t i = (*size)++;
+    while (i > 0) {
+        int32_t parent = (i - 1) / 2;
+        if (heap[parent] <= key) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = key;
+}
+
+static int64_t nav_hier_heap_pop(int64_t *heap, int32_t *size) {
+    int64_t top = heap[0];
+    int64_t last = heap[--(*size)];
+    int32_t i = 0;
+    for (;;) {
+        int32_t child = 2 * i + 1;
+        if (child >= *size) break;
+        if (child + 1 < *size && heap[child + 1] < heap[child]) child++;
+        if (heap[child] >= last) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) heap[i] = last;
+    return top;
+}
+
+// ---------- In-sector search ----------
+
+static const struct { int8_t dcol, drow; int8_t cost; } NAV_HIER_STEPS[8] = {
+    { 0, -1, NAV_COST_ORTHO }, { 1, 0, NAV_COST_ORTHO },
+    { 0,  1, NAV_COST_ORTHO }, {-1, 0, NAV_COST_ORTHO },
+    { 1, -1, NAV_COST_DIAGONAL }, { 1, 1, NAV_COST_DIAGONAL },
+    {-1,  1, NAV_COST_DIAGONAL }, {-1, -1, NAV_COST_DIAGONAL },
+};
+
+// Dijkstra from srcCells (all at distance 0) over the unblocked cells of
+// `sector`, with the flat grid's step costs and corner-cut rule. Writes
+// NAV_HIER_INF or the distance of every sector cell to dist[], indexed by
+// nav_sector_local.
+static void nav_hier_sector_search(const uint64_t *blocked, int32_t sector,
+                                   const int32_t *srcCells, int32_t srcCount,
+                                   int32_t *dist) {
+    int64_t heap[NAV_SECTOR_AREA * 9];
+    int32_t heapSize = 0;
+    NavSectorBounds b = nav_sector_bounds(sector);
+    for (int32_t i = 0; i < NAV_SECTOR_AREA; ++i) dist[i] = NAV_HIER_INF;
+    for (int32_t i = 0; i < srcCount; ++i) {
+        NavCellCoord c = nav_cell_coord(srcCells[i]);
+        int32_t local = nav_sector_local(&b, c.col, c.row);
+        if (dist[local] == 0) continue;
+        dist[local] = 0;
+        nav_hier_heap_push(heap, &heapSize, 0, local);
+    }
+    while (heapSize > 0) {
+        int64_t key = nav_hier_heap_pop(heap, &heapSize);
+        int32_t d = (int32_t)(key >> 32);
+        int32_t local = (int32_t)(key & 0xFFFFFFFF);
+        if (d != dist[local]) continue;
+        int32_t col = b.col0 + local % NAV_SECTOR_CELLS;
+        int32_t row = b.row0 + local / NAV_SECTOR_CELLS;
+        for (int n = 0; n < 8; ++n) {
+            int32_t nc = col + NAV_HIER_STEPS[n].dcol;
+            int32_t nr = row + NAV_HIER_STEPS[n].drow;
+            if (nc < b.col0 || nc >= b.col1 || nr < b.row0 || nr >= b.row1) continue;
+            if (nav_bit_test(blocked, nav_index(nc, nr))) continue;
+            if (n >= 4 && (nav_bit_test(blocked, nav_index(nc, row)) ||
+                           nav_bit_test(blocked, nav_index(col, nr)))) {
+                continue;
+            }
+            int32_t nlocal = nav_sector_local(&b, nc, nr);
+            int32_t nd = d + NAV_HIER_STEPS[n].cost;
+            if (nd < dist[nlocal]) {
+                dist[nlocal] = nd;
+                nav_hier_heap_push(heap, &heapSize, nd, nlocal);
+            }
+        }
+    }
+}
+
+// ---------- Lifecycle ----------
+
+void nav_hier_init(NavHier *hier) {
+    if (!hier) return;
+    memset(hier, 0, sizeof(*hier));
+}
+
+static void nav_hier_release(NavHier *hier) {
+    free(hier->portals);
+    free(hier->edgeStart);
+    free(hier->edges);
+    free(hier->abstractDist);
+    free(hier->abstractNext);
+    free(hier->heap);
+    hier->portals = NULL;
+    hier->edgeStart = NULL;
+    hier->edges = NULL;
+    hier->abstractDist = NULL;
+    hier->abstractNext = NULL;
+    hier->heap = NULL;
+    hier->portalCount = 0;
+    hier->edgeCount = 0;
+    hier->heapCapacity = 0;
+    hier->ready = false;
+}
+
+void nav_hier_destroy(NavHier *hier) {
+    if (!hier) return;
+    nav_hier_release(hier);
+}
+
+// ---------- Graph build ----------
+
+typedef struct {
+    int32_t from;
+    int32_t to;
+    int32_t cost;
+} NavHierEdgeTmp;
+
+typedef struct {
+    NavHierEdgeTmp *items;
+    int32_t count;
+    int32_t capacity;
+} NavHierEdgeList;
+
+static bool nav_hier_edge_add(NavHierEdgeList *list, int32_t from, int32_t to, int32_t cost) {
+    if (list->count == list->capacity) {
+        int32_t cap = list->capacity ? list->capacity * 2 : 256;
+        NavHierEdgeTmp *items = realloc(list->items, (size_t)cap * sizeof(*items));
+        if (!items) return false;
+        list->items = items;
+        list->capacity = cap;
+    }
+    list->items[list->count++] = (NavHierEdgeTmp){ from, to, cost };
+    return true;
+}
+
+// Mark the portal pairs of the entrance run [start, end] along one sector
+// border. Run position i is cell firstA + i * along on side A and that cell
+// plus `across` on side B.
+static bool nav_hier_add_entrance(NavHier *hier, NavHierEdgeList *pairs,
+                                  int32_t firstA, int32_t along, int32_t across,
+                                  int32_t start, int32_t end) {
+    int32_t picks[3];
+    int32_t pickCount = 0;
+    picks[pickCount++] = (start + end) / 2;
+    if (end - start + 1 > NAV_HIER_WIDE_ENTRANCE) {
+        picks[pickCount++] = start;
+        picks[pickCount++] = end;
+    }
+    for (int32_t i = 0; i < pickCount; ++i) {
+        int32_t a = firstA + picks[i] * along;
+        int32_t b = a + across;
+        hier->portalOfCell[a] = 0;
+        hier->portalOfCell[b] = 0;
+        if (!nav_hier_edge_add(pairs, a, b, NAV_COST_ORTHO)) return false;
+    }
+    return true;
+}
+
+// Scan one sector border segment of `length` cell pairs for runs of
+// passable pairs.
+static bool nav_hier_scan_border(NavHier *hier, NavHierEdgeList *pairs,
+                                 int32_t firstA, int32_t along, int32_t across,
+                                 int32_t length) {
+    int32_t runStart = -1;
+    for (int32_t i = 0; i <= length; ++i) {
+        bool open = false;
+        if (i < length) {
+            int32_t a = firstA + i * along;
+            open = !nav_bit_test(hier->blocked, a) &&
+                   !nav_bit_test(hier->blocked, a + across);
+        }
+        if (open && runStart < 0) runStart = i;
+        if (!open && runStart >= 0) {
+            if (!nav_hier_add_entrance(hier, pairs, firstA, along, across,
+                                       runStart, i - 1)) {
+                return false;
+            }
+            runStart = -1;
+        }
+    }
+    return true;
+}
+
+static bool nav_hier_collect_entrances(NavHier *hier, NavHierEdgeList *pairs) {
+    // Vertical borders between sector columns.
+    for (int32_t sx = 1; sx < NAV_SECTOR_COLS; ++sx) {
+        int32_t colA = sx * NAV_SECTOR_CELLS - 1;
+        for (int32_t sy = 0; sy < NAV_SECTOR_ROWS; ++sy) {
+            int32_t row0 = sy * NAV_SECTOR_CELLS;
+            int32_t row1 = row0 + NAV_SECTOR_CELLS;
+            if (row1 > NAV_ROWS) row1 = NAV_ROWS;
+            if (!nav_hier_scan_border(hier, pairs, nav_index(colA, row0),
+                                      NAV_COLS, 1, row1 - row0)) {
+                return false;
+            }
+        }
+    }
+    // Horizontal borders between sector rows.
+    for (int32_t sy = 1; sy < NAV_SECTOR_ROWS; ++sy) {
+        int32_t rowA = sy * NAV_SECTOR_CELLS - 1;
+        for (int32_t sx = 0; sx < NAV_SECTOR_COLS; ++sx) {
+            int32_t col0 = sx * NAV_SECTOR_CELLS;
+            int32_t col1 = col0 + NAV_SECTOR_CELLS;
+            if (col1 > NAV_COLS) col1 = NAV_COLS;
+            if (!nav_hier_scan_border(hier, pairs, nav_index(col0, rowA),
+                                      1, NAV_COLS, col1 - col0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Number portals sector by sector. Expects portalOfCell to hold 0 for
+// portal cells and -1 elsewhere.
+static bool nav_hier_number_portals(NavHier *hier) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        if (hier->portalOfCell[i] == 0) count++;
+    }
+    hier->portals = malloc((size_t)(count > 0 ? count : 1) * sizeof(NavPortal));
+    if (!hier->portals) return false;
+    int32_t id = 0;
+    for (int32_t s = 0; s < NAV_SECTORS; ++s) {
+        hier->sectorStart[s] = id;
+        NavSectorBounds b = nav_sector_bounds(s);
+        for (int32_t row = b.row0; row < b.row1; ++row) {
+            for (int32_t col = b.col0; col < b.col1; ++col) {
+                int32_t cell = nav_index(col, row);
+                if (hier->portalOfCell[cell] != 0) continue;
+                hier->portals[id] = (NavPortal){ cell, s };
+                hier->portalOfCell[cell] = id++;
+            }
+        }
+    }
+    hier->sectorStart[NAV_SECTORS] = id;
+    hier->portalCount = id;
+    return true;
+}
+
+// Join every pair of portals that share a sector by their in-sector cost.
+static bool nav_hier_link_sectors(NavHier *hier, NavHierEdgeList *edges) {
+    int32_t dist[NAV_SECTOR_AREA];
+    for (int32_t s = 0; s < NAV_SECTORS; ++s) {
+        NavSectorBounds b = nav_sector_bounds(s);
+        for (int32_t p = hier->sectorStart[s]; p < hier->sectorStart[s + 1]; ++p) {
+            int32_t src = hier->portals[p].cell;
+            nav_hier_sector_search(hier->blocked, s, &src, 1, dist);
+            for (int32_t q = hier->sectorStart[s]; q < hier->sectorStart[s + 1]; ++q) {
+                if (q == p) continue;
+                NavCellCoord c = nav_cell_coord(hier->portals[q].cell);
+                int32_t d = dist[nav_sector_local(&b, c.col, c.row)];
+                if (d == NAV_HIER_INF) continue;
+                if (!nav_hier_edge_add(edges, p, q, d)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static int nav_hier_edge_compare(const void *a, const void *b) {
+    const NavHierEdgeTmp *ea = a;
+    const NavHierEdgeTmp *eb = b;
+    if (ea->from != eb->from) return (ea->from > eb->from) - (ea->from < eb->from);
+    return (ea->to > eb->to) - (ea->to < eb->to);
+}
+
+bool nav_hier_update(NavHier *hier, const uint64_t *blocked) {
+    if (!hier || !blocked) return false;
+    if (hier->ready && memcmp(hier->blocked, blocked, sizeof(hier->blocked)) == 0) {
+        return true;
+    }
+    nav_hier_release(hier);
+    memcpy(hier->blocked, blocked, sizeof(hier->blocked));
+    for (int32_t i = 0; i < NAV_CELLS; ++i) hier->portalOfCell[i] = -1;
+
+    NavHierEdgeList pairs = { 0 };
+    NavHierEdgeList edges = { 0 };
+    bool ok = nav_hier_collect_entrances(hier, &pairs) &&
+              nav_hier_number_portals(hier);
+    // Entrance pairs become edges in both directions.
+    for (int32_t i = 0; ok && i < pairs.count; ++i) {
+        int32_t a = hier->portalOfCell[pairs.items[i].from];
+        int32_t b = hier->portalOfCell[pairs.items[i].to];
+        ok = nav_hier_edge_add(&edges, a, b, pairs.items[i].cost) &&
+             nav_hier_edge_add(&edges, b, a, pairs.items[i].cost);
+    }
+    ok = ok && nav_hier_link_sectors(hier, &edges);
+    free(pairs.items);
+
+    if (ok) {
+        int32_t n = hier->portalCount;
+        hier->edgeStart = calloc((size_t)n + 1, sizeof(int32_t));
+        hier->edges = malloc((size_t)(edges.count > 0 ? edges.count : 1) * sizeof(NavPortalEdge));
+        hier->abstractDist = malloc((size_t)(n > 0 ? n : 1) * sizeof(int32_t));
+        hier->abstractNext = malloc((size_t)(n > 0 ? n : 1) * sizeof(int32_t));
+        hier->heapCapacity = edges.count + n + 1;
+        hier->heap = malloc((size_t)hier->heapCapacity * sizeof(int64_t));
+        ok = hier->edgeStart && hier->edges && hier->abstractDist &&
+             hier->abstractNext && hier->heap;
+    }
+    if (ok) {
+        qsort(edges.items, (size_t)edges.count, sizeof(NavHierEdgeTmp), nav_hier_edge_compare);
+        for (int32_t i = 0; i < edges.count; ++i) {
+            hier->edgeStart[edges.items[i].from + 1]++;
+            hier->edges[i] = (NavPortalEdge){ edges.items[i].to, edges.items[i].cost };
+        }
+        for (int32_t p = 0; p < hier->portalCount; ++p) {
+            hier->edgeStart[p + 1] += hier->edgeStart[p];
+        }
+        hier->edgeCount = edges.count;
+    }
+    free(edges.items);
+    if (!ok) {
+        nav_hier_release(hier);
+        return false;
+    }
+    hier->ready = true;
+    return true;
+}
+
+// ---------- Queries ----------
+
+// Sector cells of `sector` that are seeds (distance 0) of `field`.
+static int32_t nav_hier_sector_seeds(const NavField *field, int32_t sector, int32_t *out) {
+    NavSectorBounds b = nav_sector_bounds(sector);
+    int32_t count = 0;
+    for (int32_t row = b.row0; row < b.row1; ++row) {
+        for (int32_t col = b.col0; col < b.col1; ++col) {
+            int32_t cell = nav_index(col, row);
+            if (field->distance[cell] == 0) out[count++] = cell;
+        }
+    }
+    return count;
+}
+
+// Abstract Dijkstra from the seeds of `field`. Goal sectors are written to
+// goalSectors. Returns false when the field has no seeds.
+static bool nav_hier_search_from_goal(NavHier *hier, const NavField *field,
+                                      uint64_t *goalSectors) {
+    for (int32_t p = 0; p < hier->portalCount; ++p) {
+        hier->abstractDist[p] = NAV_HIER_INF;
+        hier->abstractNext[p] = -1;
+    }
+    memset(goalSectors, 0, NAV_SECTOR_WORDS * sizeof(uint64_t));
+    bool anySeed = false;
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        if (field->distance[i] != 0) continue;
+        nav_bit_set(goalSectors, nav_hier_sector_of_cell(i));
+        anySeed = true;
+    }
+    if (!anySeed) return false;
+
+    int32_t heapSize = 0;
+    int32_t seeds[NAV_SECTOR_AREA];
+    int32_t dist[NAV_SECTOR_AREA];
+    for (int32_t s = 0; s < NAV_SECTORS; ++s) {
+        if (!nav_bit_test(goalSectors, s)) continue;
+        int32_t seedCount = nav_hier_sector_seeds(field, s, seeds);
+        nav_hier_sector_search(field->hardBlocked, s, seeds, seedCount, dist);
+        NavSectorBounds b = nav_sector_bounds(s);
+        for (int32_t p = hier->sectorStart[s]; p < hier->sectorStart[s + 1]; ++p) {
+            NavCellCoord c = nav_cell_coord(hier->portals[p].cell);
+            int32_t d = dist[nav_sector_local(&b, c.col, c.row)];
+            if (d == NAV_HIER_INF) continue;
+            hier->abstractDist[p] = d;
+            nav_hier_heap_push(hier->heap, &heapSize, d, p);
+        }
+    }
+
+    while (heapSize > 0) {
+        int64_t key = nav_hier_heap_pop(hier->heap, &heapSize);
+        int32_t d = (int32_t)(key >> 32);
+        int32_t p = (int32_t)(key & 0xFFFFFFFF);
+        if (d != hier->abstractDist[p]) continue;
+        for (int32_t e = hier->edgeStart[p]; e < hier->edgeStart[p + 1]; ++e) {
+            int32_t q = hier->edges[e].to;
+            int32_t nd = d + hier->edges[e].cost;
+            if (nd < hier->abstractDist[q]) {
+                // Each push follows a seed or an improving relaxation, so
+                // heapCapacity (portals + edges) cannot be exceeded.
+                hier->abstractDist[q] = nd;
+                hier->abstractNext[q] = p;
+                nav_hier_heap_push(hier->heap, &heapSize, nd, q);
+            }
+        }
+    }
+    return true;
+}
+
+// Add the sectors of the cheapest abstract path from `start` to the
+// corridor. Returns false when the start has none.
+static bool nav_hier_trace_start(NavHier *hier, const NavField *field,
+                                 const uint64_t *goalSectors, int32_t start) {
+    if (start < 0 || start >= NAV_CELLS) return false;
+    if (nav_bit_test(field->hardBlocked, start)) return false;
+    int32_t sector = nav_hier_sector_of_cell(start);
+    NavSectorBounds b = nav_sector_bounds(sector);
+    int32_t dist[NAV_SECTOR_AREA];
+    nav_hier_sector_search(field->hardBlocked, sector, &start, 1, dist);
+
+    int64_t best = NAV_HIER_INF;
+    int32_t bestPortal = -1;
+    bool found = false;
+    if (nav_bit_test(goalSectors, sector)) {
+        int32_t seeds[NAV_SECTOR_AREA];
+        int32_t seedCount = nav_hier_sector_seeds(field, sector, seeds);
+        for (int32_t i = 0; i < seedCount; ++i) {
+            NavCellCoord c = nav_cell_coord(seeds[i]);
+            int32_t d = dist[nav_sector_local(&b, c.col, c.row)];
+            if (d < best) {
+                best = d;
+                found = true;
+            }
+        }
+    }
+    for (int32_t p = hier->sectorStart[sector]; p < hier->sectorStart[sector + 1]; ++p) {
+        NavCellCoord c = nav_cell_coord(hier->portals[p].cell);
+        int32_t d = dist[nav_sector_local(&b, c.col, c.row)];
+        if (d == NAV_HIER_INF || hier->abstractDist[p] == NAV_HIER_INF) continue;
+        int64_t total = (int64_t)d + hier->abstractDist[p];
+        if (total < best) {
+            best = total;
+            bestPortal = p;
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    nav_bit_set(hier->corridor, sector);
+    for (int32_t p = bestPortal; p >= 0; p = hier->abstractNext[p]) {
+        nav_bit_set(hier->corridor, hier->portals[p].sector);
+    }
+    return true;
+}
+
+bool nav_hier_build_field(NavHier *hier, const NavFrame *nav, NavField *field,
+                          const int32_t *startCells, int32_t startCount) {
+    if (!hier || !nav || !field) return false;
+    hier->stats.queries++;
+    memset(hier->corridor, 0, sizeof(hier->corridor));
+
+    uint64_t goalSectors[NAV_SECTOR_WORDS];
+    bool ok = hier->ready && startCells && startCount > 0 &&
+              nav_hier_search_from_goal(hier, field, goalSectors);
+    for (int32_t i = 0; ok && i < startCount; ++i) {
+        ok = nav_hier_trace_start(hier, field, goalSectors, startCells[i]);
+    }
+    if (!ok) {
+        hier->stats.fallbacks++;
+        memset(hier->corridor, 0, sizeof(hier->corridor));
+        nav_integrate_detached_field(nav, field);
+        return false;
+    }
+
+    // Confine the fine field: cells outside the corridor become hard
+    // blockers and lose any seed they held. The original mask and seeds
+    // are kept for the fallback below.
+    uint64_t savedBlocked[NAV_CELL_WORDS];
+    uint64_t seedBits[NAV_CELL_WORDS];
+    memcpy(savedBlocked, field->hardBlocked, sizeof(savedBlocked));
+    memset(seedBits, 0, sizeof(seedBits));
+    uint64_t corridorCells = 0;
+    for (int32_t i = 0; i < NAV_CELLS; ++i) {
+        if (field->distance[i] == 0) nav_bit_set(seedBits, i);
+        if (nav_bit_test(hier->corridor, nav_hier_sector_of_cell(i))) {
+            corridorCells++;
+            continue;
+        }
+        nav_bit_set(field->hardBlocked, i);
+        field->distance[i] = NAV_DIST_UNREACHABLE;
+    }
+    nav_integrate_detached_field(nav, field);
+
+    // The portal graph may come from a coarser mask than the field's own
+    // (the static mask under a lane corridor, say), so an abstract path can
+    // cross cells this field blocks. Integrate the whole board instead when
+    // that strands a start.
+    for (int32_t i = 0; i < startCount; ++i) {
+        if (field->distance[startCells[i]] != NAV_DIST_UNREACHABLE) continue;
+        memcpy(field->hardBlocked, savedBlocked, sizeof(savedBlocked));
+        for (int32_t c = 0; c < NAV_CELLS; ++c) {
+            field->distance[c] = nav_bit_test(seedBits, c) ? 0 : NAV_DIST_UNREACHABLE;
+        }
+        hier->stats.fallbacks++;
+        memset(hier->corridor, 0, sizeof(hier->corridor));
+        nav_integrate_detached_field(nav, field);
+        return false;
+    }
+    hier->stats.corridorCells += corridorCells;
+    return true;
+}
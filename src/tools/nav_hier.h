@@ -0,0 +1,111 @@
+//
+// Hierarchical sector / portal navigation over the NavFrame grid.
+//
+// The board is cut into NAV_SECTOR_CELLS x NAV_SECTOR_CELLS sectors. Every
+// maximal run of passable cell pairs across a sector border is an entrance
+// with a portal on each side of its midpoint, plus one at each end when the
+// run is wider than NAV_HIER_WIDE_ENTRANCE cells. Portals of one sector are
+// joined by their in-sector shortest path cost, and the two portals of an
+// entrance pair by one orthogonal step. The graph depends only on the
+// blocker mask it was built from; nav_hier_update rebuilds it when that
+// mask changes.
+//
+// A query takes a seeded detached field (nav_seed_*_field), runs Dijkstra
+// over the portal graph from the goal, follows it from every start cell
+// and keeps only the sectors those abstract paths cross. The fine field is
+// then integrated inside those sectors alone, so its cost follows path
+// length instead of board area. That is what makes a finer NAV_CELL_SIZE
+// or a larger board affordable; with the stock 32 px grid the flat field
+// is already cheap and the game keeps using it. This layer is a prototype
+// linked into cardgame_sim only, where --nav-bench measures it against the
+// flat field; the game does not build or query it.
+//
+// Corridor distances are upper bounds on the full-board ones (the corridor
+// may cut off a shortcut) and cells outside the corridor stay unreachable.
+// The abstract graph ignores density; only the fine integration applies it.
+//
+
+#ifndef NFC_CARDGAME_NAV_HIER_H
+#define NFC_CARDGAME_NAV_HIER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../logic/nav_frame.h"
+
+// Sector edge length in cells.
+#ifndef NAV_SECTOR_CELLS
+#define NAV_SECTOR_CELLS 8
+#endif
+
+#define NAV_SECTOR_COLS  ((NAV_COLS + NAV_SECTOR_CELLS - 1) / NAV_SECTOR_CELLS)
+#define NAV_SECTOR_ROWS  ((NAV_ROWS + NAV_SECTOR_CELLS - 1) / NAV_SECTOR_CELLS)
+#define NAV_SECTORS      (NAV_SECTOR_COLS * NAV_SECTOR_ROWS)
+#define NAV_SECTOR_WORDS ((NAV_SECTORS + 63) / 64)
+
+// Entrances wider than this get portals at both ends besides the middle
+// one, so abstract paths are not forced through the middle of a wide gap.
+#ifndef NAV_HIER_WIDE_ENTRANCE
+#define NAV_HIER_WIDE_ENTRANCE 6
+#endif
+
+typedef struct {
+    int32_t cell;
+    int32_t sector;
+} NavPortal;
+
+typedef struct {
+    int32_t to;
+    int32_t cost;
+} NavPortalEdge;
+
+typedef struct {
+    uint64_t queries;
+    uint64_t fallbacks;       // queries integrated over the whole board
+    uint64_t corridorCells;   // cells inside the corridor, summed over queries
+} NavHierStats;
+
+typedef struct {
+    bool     ready;
+    uint64_t blocked[NAV_CELL_WORDS];   // mask the graph was built from
+
+    // Portals sorted by sector: sector s owns [sectorStart[s], sectorStart[s + 1]).
+    NavPortal *portals;
+    int32_t    portalCount;
+    int32_t    sectorStart[NAV_SECTORS + 1];
+    int32_t    portalOfCell[NAV_CELLS];  // -1 when the cell is not a portal
+
+    // Adjacency in CSR form: portal p's edges are [edgeStart[p], edgeStart[p + 1]).
+    int32_t       *edgeStart;
+    NavPortalEdge *edges;
+    int32_t        edgeCount;
+
+    // Query scratch, sized to the portal count.
+    int32_t *abstractDist;   // cost from the portal to the goal
+    int32_t *abstractNext;   // next portal toward the goal, -1 at the goal sector
+    int32_t  heapCapacity;
+    int64_t *heap;           // (dist << 32 | portal) entries, lazy deletion
+    uint64_t corridor[NAV_SECTOR_WORDS];
+
+    NavHierStats stats;
+} NavHier;
+
+void nav_hier_init(NavHier *hier);
+void nav_hier_destroy(NavHier *hier);
+
+// (Re)build the portal graph for `blocked` (a NAV_CELL_WORDS bitset) unless
+// it was already built from an identical mask. Returns false on allocation
+// failure, leaving the hierarchy not ready.
+bool nav_hier_update(NavHier *hier, const uint64_t *blocked);
+
+int32_t nav_hier_sector_of_cell(int32_t cellIndex);
+
+// Confine `field` (seeded, not yet integrated) to the sectors crossed by
+// the abstract paths from startCells[0..startCount) to its seeds, then
+// integrate it. Falls back to a full-board integration when the graph is
+// not ready or some start has no abstract path. The chosen sectors are left
+// in hier->corridor. Returns true when the corridor was used.
+bool nav_hier_build_field(NavHier *hier, const NavFrame *nav, NavField *field,
+                          const int32_t *startCells, int32_t startCount);
+
+#endif //NFC_CARDGAME_NAV_HIER_H
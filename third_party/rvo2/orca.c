@@ -0,0 +1,276 @@
+/*
+ * C port of the ORCA solver from the RVO2 Library.
+ *
+ * Copyright 2008 University of North Carolina at Chapel Hill
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License in LICENSE next to this file or at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * RVO2 Library by Jur van den Berg, Stephen J. Guy, Jamie Snape,
+ * Ming C. Lin and Dinesh Manocha: <https://gamma.cs.unc.edu/RVO2/>
+ *
+ * Modified for NFC-cardgame: Agent::computeNewVelocity, linearProgram1/2/3
+ * and the agent half of the ORCA line construction translated from C++ to C;
+ * obstacle segments replaced by hard disk neighbors (the first hardCount
+ * lines, which linearProgram3 never relaxes); per-neighbor responsibility
+ * replaces the fixed 0.5 share.
+ */
+
+//
+// Optimal reciprocal collision avoidance. See orca.h.
+//
+
+#include "orca.h"
+
+#include <math.h>
+
+#define ORCA_EPSILON 0.00001f
+
+// A directed line; permitted velocities lie on its left.
+typedef struct {
+    OrcaVec2 point;
+    OrcaVec2 direction;
+} OrcaLine;
+
+// ---------- Vector helpers ----------
+
+static OrcaVec2 orca_vec(float x, float y) {
+    return (OrcaVec2){ x, y };
+}
+
+static OrcaVec2 orca_add(OrcaVec2 a, OrcaVec2 b) {
+    return orca_vec(a.x + b.x, a.y + b.y);
+}
+
+static OrcaVec2 orca_sub(OrcaVec2 a, OrcaVec2 b) {
+    return orca_vec(a.x - b.x, a.y - b.y);
+}
+
+static OrcaVec2 orca_scale(OrcaVec2 v, float s) {
+    return orca_vec(v.x * s, v.y * s);
+}
+
+static float orca_dot(OrcaVec2 a, OrcaVec2 b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+static float orca_det(OrcaVec2 a, OrcaVec2 b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+static float orca_length_sq(OrcaVec2 v) {
+    return orca_dot(v, v);
+}
+
+static OrcaVec2 orca_normalize(OrcaVec2 v) {
+    float len = sqrtf(orca_length_sq(v));
+    return (len > ORCA_EPSILON) ? orca_scale(v, 1.0f / len) : orca_vec(0.0f, 0.0f);
+}
+
+// ---------- Half-planes ----------
+
+// Velocities for `agent` that avoid `other` for the time horizon, as a line
+// through the agent's share of the smallest change that leaves the
+// velocity obstacle.
+static OrcaLine orca_neighbor_line(const OrcaAgent *agent, const OrcaNeighbor *other) {
+    OrcaVec2 relativePosition = orca_sub(other->position, agent->position);
+    OrcaVec2 relativeVelocity = orca_sub(agent->velocity, other->velocity);
+    float distSq = orca_length_sq(relativePosition);
+    float combinedRadius = agent->radius + other->radius;
+    float combinedRadiusSq = combinedRadius * combinedRadius;
+
+    OrcaLine line;
+    OrcaVec2 u;
+
+    if (distSq > combinedRadiusSq) {
+        float invTimeHorizon = 1.0f / agent->timeHorizon;
+        // Relative velocity measured from the center of the cutoff circle.
+        OrcaVec2 w = orca_sub(relativeVelocity, orca_scale(relativePosition, invTimeHorizon));
+        float wLengthSq = orca_length_sq(w);
+        float dotProduct = orca_dot(w, relativePosition);
+
+        if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSq * wLengthSq) {
+            // Nearest boundary point is on the cutoff circle.
+            float wLength = sqrtf(wLengthSq);
+            OrcaVec2 unitW = orca_scale(w, 1.0f / wLength);
+            line.direction = orca_vec(unitW.y, -unitW.x);
+            u = orca_scale(unitW, combinedRadius * invTimeHorizon - wLength);
+        } else {
+            // Nearest boundary point is on one of the legs.
+            float leg = sqrtf(distSq - combinedRadiusSq);
+            if (orca_det(relativePosition, w) > 0.0f) {
+                line.direction = orca_scale(
+                    orca_vec(relativePosition.x * leg - relativePosition.y * combinedRadius,
+                             relativePosition.x * combinedRadius + relativePosition.y * leg),
+                    1.0f / distSq);
+            } else {
+                line.direction = orca_scale(
+                    orca_vec(relativePosition.x * leg + relativePosition.y * combinedRadius,
+                             -relativePosition.x * combinedRadius + relativePosition.y * leg),
+                    -1.0f / distSq);
+            }
+            float dotLeg = orca_dot(relativeVelocity, line.direction);
+            u = orca_sub(orca_scale(line.direction, dotLeg), relativeVelocity);
+        }
+    } else {
+        // Already overlapping: separate within one tick.
+        float invTimeStep = 1.0f / agent->timeStep;
+        OrcaVec2 w = orca_sub(relativeVelocity, orca_scale(relativePosition, invTimeStep));
+        float wLength = sqrtf(orca_length_sq(w));
+        OrcaVec2 unitW = (wLength > ORCA_EPSILON) ? orca_scale(w, 1.0f / wLength)
+                                                  : orca_vec(1.0f, 0.0f);
+        line.direction = orca_vec(unitW.y, -unitW.x);
+        u = orca_scale(unitW, combinedRadius * invTimeStep - wLength);
+    }
+
+    line.point = orca_add(agent->velocity, orca_scale(u, other->responsibility));
+    return line;
+}
+
+// ---------- Linear programs ----------
+
+// Optimize along line `lineNo` subject to lines [0, lineNo) and the speed
+// disk. `directionOpt` optimizes toward `optVelocity` as a direction instead
+// of a point. Returns false when the constraints leave the line empty.
+static bool orca_linear_program1(const OrcaLine *lines, int lineNo, float radius,
+                                 OrcaVec2 optVelocity, bool directionOpt,
+                                 OrcaVec2 *result) {
+    const OrcaLine *line = &lines[lineNo];
+    float dotProduct = orca_dot(line->point, line->direction);
+    float discriminant = dotProduct * dotProduct + radius * radius -
+                         orca_length_sq(line->point);
+    if (discriminant < 0.0f) return false;
+
+    float sqrtDiscriminant = sqrtf(discriminant);
+    float tLeft = -dotProduct - sqrtDiscriminant;
+    float tRight = -dotProduct + sqrtDiscriminant;
+
+    for (int i = 0; i < lineNo; i++) {
+        float denominator = orca_det(line->direction, lines[i].direction);
+        float numerator = orca_det(lines[i].direction, orca_sub(line->point, lines[i].point));
+
+        if (fabsf(denominator) <= ORCA_EPSILON) {
+            // Parallel: either all of this line or none of it is permitted.
+            if (numerator < 0.0f) return false;
+            continue;
+        }
+
+        float t = numerator / denominator;
+        if (denominator >= 0.0f) {
+            if (t < tRight) tRight = t;
+        } else {
+            if (t > tLeft) tLeft = t;
+        }
+        if (tLeft > tRight) return false;
+    }
+
+    float t;
+    if (directionOpt) {
+        t = (orca_dot(optVelocity, line->direction) > 0.0f) ? tRight : tLeft;
+    } else {
+        t = orca_dot(line->direction, orca_sub(optVelocity, line->point));
+        if (t < tLeft) t = tLeft;
+        if (t > tRight) t = tRight;
+    }
+    *result = orca_add(line->point, orca_scale(line->direction, t));
+    return true;
+}
+
+// Incremental 2-D program over `lineCount` lines. Returns the index of the
+// first line it could not satisfy, or lineCount on success.
+static int orca_linear_program2(const OrcaLine *lines, int lineCount, float radius,
+                                OrcaVec2 optVelocity, bool directionOpt,
+                                OrcaVec2 *result) {
+    if (directionOpt) {
+        // optVelocity is a unit direction here.
+        *result = orca_scale(optVelocity, radius);
+    } else if (orca_length_sq(optVelocity) > radius * radius) {
+        *result = orca_scale(orca_normalize(optVelocity), radius);
+    } else {
+        *result = optVelocity;
+    }
+
+    for (int i = 0; i < lineCount; i++) {
+        if (orca_det(lines[i].direction, orca_sub(lines[i].point, *result)) > 0.0f) {
+            OrcaVec2 previous = *result;
+            if (!orca_linear_program1(lines, i, radius, optVelocity, directionOpt, result)) {
+                *result = previous;
+                return i;
+            }
+        }
+    }
+    return lineCount;
+}
+
+// Infeasible fallback: minimize the largest violation of lines
+// [beginLine, lineCount) while keeping lines [0, hardCount) satisfied.
+static void orca_linear_program3(const OrcaLine *lines, int lineCount, int hardCount,
+                                 int beginLine, float radius, OrcaVec2 *result) {
+    OrcaLine projLines[ORCA_MAX_NEIGHBORS];
+    float distance = 0.0f;
+
+    for (int i = beginLine; i < lineCount; i++) {
+        if (orca_det(lines[i].direction, orca_sub(lines[i].point, *result)) <= distance) {
+            continue;
+        }
+
+        int projCount = 0;
+        for (int j = 0; j < hardCount; j++) {
+            projLines[projCount++] = lines[j];
+        }
+        for (int j = hardCount; j < i; j++) {
+            OrcaLine line;
+            float determinant = orca_det(lines[i].direction, lines[j].direction);
+            if (fabsf(determinant) <= ORCA_EPSILON) {
+                // Same direction: line j adds nothing. Opposite: bisect.
+                if (orca_dot(lines[i].direction, lines[j].direction) > 0.0f) continue;
+                line.point = orca_scale(orca_add(lines[i].point, lines[j].point), 0.5f);
+            } else {
+                float t = orca_det(lines[j].direction, orca_sub(lines[i].point, lines[j].point)) /
+                          determinant;
+                line.point = orca_add(lines[i].point, orca_scale(lines[i].direction, t));
+            }
+            line.direction = orca_normalize(orca_sub(lines[j].direction, lines[i].direction));
+            projLines[projCount++] = line;
+        }
+
+        OrcaVec2 previous = *result;
+        OrcaVec2 inward = orca_vec(-lines[i].direction.y, lines[i].direction.x);
+        if (orca_linear_program2(projLines, projCount, radius, inward, true, result) <
+            projCount) {
+            // Only float error can get here; keep the last good velocity.
+            *result = previous;
+        }
+        distance = orca_det(lines[i].direction, orca_sub(lines[i].point, *result));
+    }
+}
+
+// ---------- Solve ----------
+
+OrcaVec2 orca_solve(const OrcaAgent *agent, const OrcaNeighbor *neighbors,
+                    int count, int hardCount) {
+    if (count > ORCA_MAX_NEIGHBORS) count = ORCA_MAX_NEIGHBORS;
+    if (hardCount > count) hardCount = count;
+
+    OrcaLine lines[ORCA_MAX_NEIGHBORS];
+    for (int i = 0; i < count; i++) {
+        lines[i] = orca_neighbor_line(agent, &neighbors[i]);
+    }
+
+    OrcaVec2 result;
+    int failed = orca_linear_program2(lines, count, agent->maxSpeed,
+                                      agent->preferredVelocity, false, &result);
+    if (failed < count) {
+        orca_linear_program3(lines, count, hardCount, failed, agent->maxSpeed, &result);
+    }
+    return result;
+}
@@ -0,0 +1,77 @@
+/*
+ * C port of the ORCA solver from the RVO2 Library.
+ *
+ * Copyright 2008 University of North Carolina at Chapel Hill
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License in LICENSE next to this file or at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * RVO2 Library by Jur van den Berg, Stephen J. Guy, Jamie Snape,
+ * Ming C. Lin and Dinesh Manocha: <https://gamma.cs.unc.edu/RVO2/>
+ *
+ * Modified for NFC-cardgame: standalone C interface (OrcaAgent,
+ * OrcaNeighbor, orca_solve) in place of the RVOSimulator / Agent classes.
+ */
+
+//
+// Optimal reciprocal collision avoidance (ORCA) for one agent.
+//
+// Every neighbor closer than `timeHorizon` seconds of closing speed
+// contributes one half-plane of velocities that keep the pair apart for that
+// long, shifted by the agent's share of the avoidance (`responsibility`:
+// 0.5 when the neighbor runs the same solver and takes the other half, 1
+// when it will not react). The new velocity is the one nearest the
+// preferred velocity inside all half-planes and the max-speed disk, found
+// by an incremental 2-D linear program in expected time linear in the
+// neighbor count. When the half-planes leave no room (dense crowds), a 3-D
+// program picks the velocity that violates them least.
+//
+// Hard neighbors (obstacles) come first in the list; the fallback program
+// never relaxes their half-planes. The solver knows nothing about entities
+// or the nav grid -- pathfinding.c gathers neighbors and applies the result.
+//
+
+#ifndef NFC_CARDGAME_ORCA_H
+#define NFC_CARDGAME_ORCA_H
+
+#include <stdbool.h>
+
+// Neighbors one solve accepts; extra ones are ignored.
+#define ORCA_MAX_NEIGHBORS 24
+
+typedef struct {
+    float x, y;
+} OrcaVec2;
+
+typedef struct {
+    OrcaVec2 position;
+    OrcaVec2 velocity;
+    float radius;
+    float maxSpeed;
+    OrcaVec2 preferredVelocity;
+    float timeHorizon;       // seconds of look-ahead against neighbors
+    float timeStep;          // tick length, for the already-colliding case
+} OrcaAgent;
+
+typedef struct {
+    OrcaVec2 position;
+    OrcaVec2 velocity;
+    float radius;            // combined with the agent's radius by the solver
+    float responsibility;    // share of the avoidance the agent takes, (0, 1]
+} OrcaNeighbor;
+
+// Solve for `agent` against `neighbors[0..count)`, of which the first
+// `hardCount` are treated as obstacles. Returns the new velocity.
+OrcaVec2 orca_solve(const OrcaAgent *agent, const OrcaNeighbor *neighbors,
+                    int count, int hardCount);
+
+#endif //NFC_CARDGAME_ORCA_H